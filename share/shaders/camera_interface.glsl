@@ -2,7 +2,7 @@ layout(std140, binding=1) uniform Camera {
     mat4 projection;
     mat4 view;
     mat4 viewProjection;
-    vec4 screenSize;
+    vec4 screenSize; // xy = screen size, zw = scene render target size
     float aspectRatio;
     float nearPlane;
     float farPlane;
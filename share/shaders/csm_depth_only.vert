@@ -6,7 +6,16 @@ uniform mat4 u_mvp;
 void main()
 {
     #ifdef SKELETAL
-    gl_Position = u_mvp * boneTransform.m[int(a_boneIndex)] * vec4(a_position, 1);
+    if (!isBoneMeshVisible())
+    {
+        // outside of the clip volume, so triangles of hidden bone meshes are discarded
+        gl_Position = vec4(2, 2, 2, 1);
+        return;
+    }
+    #endif
+
+    #ifdef SKELETAL
+    gl_Position = u_mvp * getBoneTransform() * vec4(a_position, 1);
     #else
     gl_Position = u_mvp * vec4(a_position, 1);
     #endif
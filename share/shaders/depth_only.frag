@@ -1,11 +1,11 @@
 #include "geometry_pipeline_interface.glsl"
 
-layout(bindless_sampler) uniform sampler2DArray u_diffuseTextures;
+#include "texture_streaming.glsl"
 
 void main()
 {
     if (gpi.texCoord.z >= 0) {
-        vec4 baseColor = texture(u_diffuseTextures, gpi.texCoord);
+        vec4 baseColor = sampleDiffuse(gpi.texCoord);
         if (baseColor.a < 0.5) {
             discard;
         }
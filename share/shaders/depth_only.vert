@@ -1,16 +1,26 @@
 #include "vtx_input.glsl"
 #include "transform_interface.glsl"
 #include "camera_interface.glsl"
+#include "texture_animation.glsl"
 
 #include "geometry_pipeline_interface.glsl"
 
 void main()
 {
-    gpi.texCoord = a_texCoord;
+    #ifdef SKELETAL
+    if (!isBoneMeshVisible())
+    {
+        // outside of the clip volume, so triangles of hidden bone meshes are discarded
+        gl_Position = vec4(2, 2, 2, 1);
+        return;
+    }
+    #endif
+
+    gpi.texCoord = resolveTexCoord(a_texCoord);
     gpi.color = a_color;
 
     #ifdef SKELETAL
-    vec4 vtx = camera.viewProjection * modelTransform.m * boneTransform.m[int(a_boneIndex)] * vec4(a_position, 1);
+    vec4 vtx = camera.viewProjection * modelTransform.m * getBoneTransform() * vec4(a_position, 1);
     #else
     vec4 vtx = camera.viewProjection * modelTransform.m * vec4(a_position, 1);
     #endif
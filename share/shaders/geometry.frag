@@ -2,7 +2,7 @@
 #include "camera_interface.glsl"
 #include "time_uniform.glsl"
 
-layout(bindless_sampler) uniform sampler2DArray u_diffuseTextures;
+#include "texture_streaming.glsl"
 #ifdef WATER
 #include "water_caustics.glsl"
 #endif
@@ -17,7 +17,7 @@ layout(location=2) out vec3 out_position;
 // "A Quadrilateral Rendering Primitive" by Kai Hormann and Marco Tarini
 vec4 barycentric(in vec4 wwww)
 {
-    vec2 v = (gl_FragCoord.xy / camera.screenSize.xy) * 2 - 1;
+    vec2 v = (gl_FragCoord.xy / camera.screenSize.zw) * 2 - 1;
     vec2 s[4];
     vec4 r;
     for (int i=0; i<4; ++i) {
@@ -68,7 +68,7 @@ void main()
         else {
             uv = barycentricUv();
         }
-        vec4 texColor = texture(u_diffuseTextures, vec3(uv, gpi.texCoord.z));
+        vec4 texColor = sampleDiffuse(vec3(uv, gpi.texCoord.z));
         if (texColor.a < 0.5) {
             discard;
         }
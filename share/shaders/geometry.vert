@@ -2,16 +2,27 @@
 #include "transform_interface.glsl"
 #include "geometry_pipeline_interface.glsl"
 #include "camera_interface.glsl"
+#include "texture_animation.glsl"
 
 void main()
 {
     #ifdef SKELETAL
-    mat4 mm = modelTransform.m * boneTransform.m[int(a_boneIndex)];
+    if (!isBoneMeshVisible())
+    {
+        // outside of the clip volume, so triangles of hidden bone meshes are discarded
+        gl_Position = vec4(2, 2, 2, 1);
+        return;
+    }
+    #endif
+
+    #ifdef SKELETAL
+    mat4 mm = modelTransform.m * getBoneTransform();
     #else
     mat4 mm = modelTransform.m;
     #endif
     mat4 mv = camera.view * mm;
 
+    // SPRITEMODE 3 quads already face the camera in world space
     #if SPRITEMODE == 1
     mv[0].xyz = vec3(1, 0, 0);
     mv[2].xyz = vec3(0, 0, 1);
@@ -25,7 +36,7 @@ void main()
     gpi.vertexPos = tmp.xyz;
     gpi.vertexPosWorld = vec3(mm * vec4(a_position, 1.0));
     gl_Position = camera.projection * tmp;
-    gpi.texCoord = a_texCoord;
+    gpi.texCoord = resolveTexCoord(a_texCoord);
     gpi.color = a_color;
 
     gpi.vertexNormalWorld = normalize(mat3(mm) * a_normal);
@@ -35,7 +46,7 @@ void main()
     for (int i=0; i<CSMSplits; ++i)
     {
         #ifdef SKELETAL
-        mat4 lmvp = csm.lightMVP[i] * boneTransform.m[int(a_boneIndex)];
+        mat4 lmvp = csm.lightMVP[i] * getBoneTransform();
         #else
         mat4 lmvp = csm.lightMVP[i];
         #endif
@@ -57,9 +68,17 @@ void main()
         tmp = mvp * vec4(a_quadVert4, 1);
         gpi.quadVerts[3] = vec3(tmp.xy / tmp.w, tmp.w);
 
-        gpi.quadUvs[0] = a_quadUv12.xy;
-        gpi.quadUvs[1] = a_quadUv12.zw;
-        gpi.quadUvs[2] = a_quadUv34.xy;
-        gpi.quadUvs[3] = a_quadUv34.zw;
+        vec4 quadUv12 = a_quadUv12;
+        vec4 quadUv34 = a_quadUv34;
+        if (isAnimatedTexCoord(a_texCoord)) {
+            AtlasTile tile = getAnimatedTile(a_texCoord);
+            quadUv12 = tile.uv01;
+            quadUv34 = tile.uv23;
+        }
+
+        gpi.quadUvs[0] = quadUv12.xy;
+        gpi.quadUvs[1] = quadUv12.zw;
+        gpi.quadUvs[2] = quadUv34.xy;
+        gpi.quadUvs[3] = quadUv34.zw;
     }
 }
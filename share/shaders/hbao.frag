@@ -2,6 +2,8 @@ layout(bindless_sampler) uniform sampler2D u_position;
 layout(bindless_sampler) uniform sampler2D u_normals;
 
 uniform vec3 u_samples[16];
+// varied per frame when the result is accumulated over time
+uniform vec2 u_noiseOffset;
 
 layout(location=0) out float out_ao;
 
@@ -27,16 +29,16 @@ void main()
     float stepSize = Radius / (fragPos.z*0.0001) / float(Steps+1);
     float stepSizes[Dirs];
     for (int i = 0; i < Dirs; ++i) {
-        stepSizes[i] = stepSize * snoise(fpi.texCoord + vec2(i, 0)) + stepSize;
+        stepSizes[i] = stepSize * snoise(fpi.texCoord + u_noiseOffset + vec2(i, 0)) + stepSize;
     }
 
     vec3 normal = texture(u_normals, fpi.texCoord).xyz;
     vec3 baseTangent;
     if (abs(normal.z) > 1e-4 || abs(normal.x) > 1e-4) {
-        baseTangent = angleAxis(normalize(vec3(normal.z, 0, -normal.x)), normal, snoise(fpi.texCoord));
+        baseTangent = angleAxis(normalize(vec3(normal.z, 0, -normal.x)), normal, snoise(fpi.texCoord + u_noiseOffset));
     }
     else {
-        baseTangent = angleAxis(normalize(vec3(normal.y, -normal.x, 0)), normal, snoise(fpi.texCoord));
+        baseTangent = angleAxis(normalize(vec3(normal.y, -normal.x, 0)), normal, snoise(fpi.texCoord + u_noiseOffset));
     }
 
     vec3 tangents[Dirs];
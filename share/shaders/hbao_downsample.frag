@@ -0,0 +1,30 @@
+#include "flat_pipeline_interface.glsl"
+
+layout(bindless_sampler) uniform sampler2D u_position;
+layout(bindless_sampler) uniform sampler2D u_normals;
+uniform int u_divisor;
+
+layout(location=0) out vec3 out_position;
+layout(location=1) out vec3 out_normal;
+
+void main()
+{
+    // keep the sample closest to the camera, so thin foreground geometry is not lost
+    ivec2 maxCoord = textureSize(u_position, 0) - 1;
+    ivec2 base = ivec2(gl_FragCoord.xy) * u_divisor;
+    ivec2 best = min(base, maxCoord);
+    float bestZ = texelFetch(u_position, best, 0).z;
+    for (int y = 0; y < u_divisor; ++y) {
+        for (int x = 0; x < u_divisor; ++x) {
+            ivec2 coord = min(base + ivec2(x, y), maxCoord);
+            float z = texelFetch(u_position, coord, 0).z;
+            if (z > bestZ) {
+                bestZ = z;
+                best = coord;
+            }
+        }
+    }
+
+    out_position = texelFetch(u_position, best, 0).xyz;
+    out_normal = texelFetch(u_normals, best, 0).xyz;
+}
@@ -0,0 +1,35 @@
+layout(bindless_sampler) uniform sampler2D u_ao;
+layout(bindless_sampler) uniform sampler2D u_position;
+layout(bindless_sampler) uniform sampler2D u_history;
+layout(bindless_sampler) uniform sampler2D u_historyPosition;
+// transforms from the current view space into the previous frame's view space
+uniform mat4 u_reprojection;
+uniform float u_historyWeight;
+
+layout(location=0) out float out_ao;
+
+#include "flat_pipeline_interface.glsl"
+#include "camera_interface.glsl"
+
+void main()
+{
+    float ao = texture(u_ao, fpi.texCoord).r;
+
+    vec4 prevPos = u_reprojection * vec4(texture(u_position, fpi.texCoord).xyz, 1);
+    vec4 prevClip = camera.projection * prevPos;
+    vec2 prevUv = (prevClip.xy / prevClip.w) * 0.5 + 0.5;
+
+    float weight = u_historyWeight;
+    if (prevClip.w <= 0 || any(lessThan(prevUv, vec2(0))) || any(greaterThan(prevUv, vec2(1)))) {
+        weight = 0;
+    }
+    else {
+        // reject disoccluded or moving surfaces
+        vec3 historyPos = texture(u_historyPosition, prevUv).xyz;
+        if (distance(historyPos, prevPos.xyz) > 0.05 * abs(prevPos.z)) {
+            weight = 0;
+        }
+    }
+
+    out_ao = mix(ao, texture(u_history, prevUv).r, weight);
+}
@@ -0,0 +1,31 @@
+layout(bindless_sampler) uniform sampler2D u_ao;
+layout(bindless_sampler) uniform sampler2D u_lowPosition;
+layout(bindless_sampler) uniform sampler2D u_position;
+
+layout(location=0) out float out_ao;
+
+#include "flat_pipeline_interface.glsl"
+
+void main()
+{
+    const ivec2 Offsets[4] = ivec2[](ivec2(0, 0), ivec2(1, 0), ivec2(0, 1), ivec2(1, 1));
+
+    float z = texture(u_position, fpi.texCoord).z;
+    ivec2 lowSize = textureSize(u_ao, 0);
+    vec2 lowCoord = fpi.texCoord * vec2(lowSize) - 0.5;
+    ivec2 base = ivec2(floor(lowCoord));
+    vec2 f = lowCoord - floor(lowCoord);
+    vec4 bilinear = vec4((1-f.x) * (1-f.y), f.x * (1-f.y), (1-f.x) * f.y, f.x * f.y);
+
+    // bilinear weights, attenuated by the relative depth difference to avoid bleeding across edges
+    float ao = 0;
+    float weightSum = 0;
+    for (int i = 0; i < 4; ++i) {
+        ivec2 coord = clamp(base + Offsets[i], ivec2(0), lowSize - 1);
+        float lowZ = texelFetch(u_lowPosition, coord, 0).z;
+        float w = bilinear[i] / (1e-3 + abs(lowZ - z) / max(abs(z), 1e-3));
+        ao += w * texelFetch(u_ao, coord, 0).r;
+        weightSum += w;
+    }
+    out_ao = ao / max(weightSum, 1e-6);
+}
@@ -14,6 +14,20 @@ layout(std430, binding=3) readonly restrict buffer b_lights {
     Light lights[];
 };
 
+// must match LightClusters
+const uint ClusterTilesX = 16;
+const uint ClusterTilesY = 9;
+const uint ClusterSlices = 24;
+
+// x = offset into lightIndices, y = light count
+layout(std430, binding=6) readonly restrict buffer b_lightClusters {
+    uvec2 lightClusters[];
+};
+
+layout(std430, binding=7) readonly restrict buffer b_lightIndices {
+    uint lightIndices[];
+};
+
 float calc_vsm_value(in int splitIdx, in float shadow, in float lightNormDot)
 {
     vec3 projCoords = gpi.vertexPosLight[splitIdx];
@@ -81,6 +95,16 @@ float shadow_map_multiplier(in vec3 worldNormal) {
     return shadow_map_multiplier(worldNormal, 0.5);
 }
 
+uvec2 get_light_cluster()
+{
+    vec2 uv = clamp(gl_FragCoord.xy / camera.screenSize.zw, vec2(0), vec2(1));
+    uvec2 tile = min(uvec2(uv * vec2(ClusterTilesX, ClusterTilesY)), uvec2(ClusterTilesX-1, ClusterTilesY-1));
+    float z = max(-gpi.vertexPos.z, camera.nearPlane);
+    float slice = log(z / camera.nearPlane) / log(camera.farPlane / camera.nearPlane) * float(ClusterSlices);
+    uint sliceIdx = uint(clamp(slice, 0.0, float(ClusterSlices-1)));
+    return lightClusters[(sliceIdx * ClusterTilesY + tile.y) * ClusterTilesX + tile.x];
+}
+
 float calc_positional_lighting(in vec3 worldNormal, in vec3 worldPos)
 {
     if (lights.length() <= 0 || worldNormal == vec3(0))
@@ -92,12 +116,14 @@ float calc_positional_lighting(in vec3 worldNormal, in vec3 worldPos)
     worldNormal = normalize(worldNormal);
     #endif
     float sum = u_lightAmbient;
-    for (int i=0; i<lights.length(); ++i)
+    uvec2 cluster = get_light_cluster();
+    for (uint k=0; k<cluster.y; ++k)
     {
-        vec3 d = worldPos - lights[i].position.xyz;
+        Light light = lights[lightIndices[cluster.x + k]];
+        vec3 d = worldPos - light.position.xyz;
         float ld = length(d);
-        float r = ld / lights[i].fadeDistance;
-        float intensity = lights[i].brightness / (r*r + 1.0);
+        float r = ld / light.fadeDistance;
+        float intensity = light.brightness / (r*r + 1.0);
         #if SPRITEMODE == 0
         sum += intensity * clamp(-dot(d/ld, worldNormal), 0, 1);
         #else
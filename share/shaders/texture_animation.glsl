@@ -0,0 +1,44 @@
+struct AtlasTile {
+    vec4 uv01;
+    vec4 uv23;
+    int layer;
+    int _pad[3];
+};
+
+layout(std430, binding=4) readonly restrict buffer b_atlasTiles {
+    AtlasTile atlasTiles[];
+};
+
+// current atlas tile of each animated tile slot
+layout(std430, binding=5) readonly restrict buffer b_animatedTiles {
+    int animatedTiles[];
+};
+
+// texture coordinates with z <= -2 reference corner (-z-2)%4 of animated tile slot (-z-2)/4
+bool isAnimatedTexCoord(in vec3 texCoord)
+{
+    return texCoord.z <= -2;
+}
+
+AtlasTile getAnimatedTile(in vec3 texCoord)
+{
+    int id = int(round(-texCoord.z)) - 2;
+    return atlasTiles[animatedTiles[id / 4]];
+}
+
+vec3 resolveTexCoord(in vec3 texCoord)
+{
+    if (!isAnimatedTexCoord(texCoord)) {
+        return texCoord;
+    }
+
+    AtlasTile tile = getAnimatedTile(texCoord);
+    vec2 uv;
+    switch ((int(round(-texCoord.z)) - 2) % 4) {
+        case 0: uv = tile.uv01.xy; break;
+        case 1: uv = tile.uv01.zw; break;
+        case 2: uv = tile.uv23.xy; break;
+        default: uv = tile.uv23.zw; break;
+    }
+    return vec3(uv, tile.layer);
+}
@@ -0,0 +1,20 @@
+layout(bindless_sampler) uniform sampler2DArray u_diffuseTextures;
+layout(bindless_sampler) uniform sampler2DArray u_diffuseTexturesFallback;
+
+// slot of each atlas page in u_diffuseTextures, or -1 if only the low resolution copy in u_diffuseTexturesFallback is
+// resident
+layout(std430, binding=8) readonly restrict buffer b_texturePages {
+    int texturePages[];
+};
+
+vec4 sampleDiffuse(in vec3 texCoord)
+{
+    // derivatives must be taken outside of the non-uniform branch
+    vec2 dx = dFdx(texCoord.xy);
+    vec2 dy = dFdy(texCoord.xy);
+    int slot = texturePages[int(round(texCoord.z))];
+    if (slot >= 0) {
+        return textureGrad(u_diffuseTextures, vec3(texCoord.xy, slot), dx, dy);
+    }
+    return textureGrad(u_diffuseTexturesFallback, texCoord, dx, dy);
+}
@@ -6,4 +6,28 @@ layout(std140, binding=0) uniform Transform {
 layout(std140) readonly restrict buffer BoneTransform {
     mat4 m[];
 } boneTransform;
+
+// the meshes of all bones and their replacements share one vertex buffer; a_boneIndex stores the bone in the lower
+// part and the mesh variant in the upper part, and only the variant selected for a bone is drawn
+// must match SkinnedMesh::BoneStride
+const int BoneStride = 256;
+
+layout(std430) readonly restrict buffer BoneMesh {
+    int variant[];
+} boneMesh;
+
+int getBone()
+{
+    return int(a_boneIndex) % BoneStride;
+}
+
+bool isBoneMeshVisible()
+{
+    return boneMesh.variant[getBone()] == int(a_boneIndex) / BoneStride;
+}
+
+mat4 getBoneTransform()
+{
+    return boneTransform.m[getBone()];
+}
 #endif
@@ -1,12 +1,13 @@
 #include "ui_pipeline_interface.glsl"
 
-layout(bindless_sampler) uniform sampler2DArray u_input;
+#include "texture_streaming.glsl"
+
 layout(location=0) out vec4 out_color;
 
 void main()
 {
     if (upi.texCoord.z >= 0) {
-        out_color = texture(u_input, upi.texCoord);
+        out_color = sampleDiffuse(upi.texCoord);
     }
     else {
         vec4 top = mix(upi.topLeft, upi.topRight, upi.texCoord.x);
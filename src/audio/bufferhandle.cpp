@@ -8,6 +8,7 @@
 #include <boost/log/trivial.hpp>
 #include <cstring>
 #include <gsl/gsl-lite.hpp>
+#include <utility>
 #include <vector>
 
 namespace audio
@@ -25,8 +26,7 @@ void BufferHandle::fill(const int16_t* samples, const size_t frameCount, const i
                          sampleRate));
 }
 
-// NOLINTNEXTLINE(readability-make-member-function-const)
-void BufferHandle::fillFromWav(const uint8_t* data)
+PcmData decodeWav(const uint8_t* data)
 {
   Expects(data[0] == 'R' && data[1] == 'I' && data[2] == 'F' && data[3] == 'F');
   Expects(data[8] == 'W' && data[9] == 'A' && data[10] == 'V' && data[11] == 'E');
@@ -50,6 +50,12 @@ void BufferHandle::fillFromWav(const uint8_t* data)
     }
   }
 
-  fill(pcm.data(), pcm.size() / tmp->getChannels(), tmp->getChannels(), tmp->getSampleRate());
+  return PcmData{std::move(pcm), tmp->getChannels(), tmp->getSampleRate()};
+}
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void BufferHandle::fillFromWav(const uint8_t* data)
+{
+  fill(decodeWav(data));
 }
 } // namespace audio
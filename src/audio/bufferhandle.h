@@ -2,6 +2,7 @@
 
 #include "core.h"
 #include "handle.h"
+#include "pcmdata.h"
 
 #include <chrono>
 #include <cstddef>
@@ -9,6 +10,8 @@
 
 namespace audio
 {
+[[nodiscard]] extern PcmData decodeWav(const uint8_t* data);
+
 class BufferHandle : public Handle
 {
 public:
@@ -18,6 +21,10 @@ public:
   }
 
   void fill(const int16_t* samples, size_t frameCount, int channels, int sampleRate);
+  void fill(const PcmData& pcm)
+  {
+    fill(pcm.samples.data(), pcm.samples.size() / pcm.channels, pcm.channels, pcm.sampleRate);
+  }
   void fillFromWav(const uint8_t* data);
 
   [[nodiscard]] Clock::duration getDuration() const
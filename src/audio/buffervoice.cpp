@@ -30,6 +30,20 @@ void BufferVoice::associate(std::unique_ptr<SourceHandle>&& source)
   Voice::associate(std::move(source));
 }
 
+std::unique_ptr<SourceHandle> BufferVoice::dissociate()
+{
+  auto source = Voice::dissociate();
+  if(source != nullptr)
+    AL_ASSERT(alSourcei(*source, AL_BUFFER, AL_NONE));
+  return source;
+}
+
+void BufferVoice::reuse(gsl::not_null<std::shared_ptr<BufferHandle>> buffer)
+{
+  resetState();
+  m_buffer = std::move(buffer);
+}
+
 Clock::duration BufferVoice::getDuration() const
 {
   return m_buffer->getDuration();
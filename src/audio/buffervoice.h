@@ -22,6 +22,10 @@ public:
   ~BufferVoice() override;
 
   void associate(std::unique_ptr<SourceHandle>&& source) override;
+  std::unique_ptr<SourceHandle> dissociate() override;
+
+  //! resets the voice to play another buffer; the voice must not be in use anymore
+  void reuse(gsl::not_null<std::shared_ptr<BufferHandle>> buffer);
 
   [[nodiscard]] Clock::duration getDuration() const override;
 };
@@ -179,12 +179,12 @@ void Device::reset()
   m_streams.clear();
 
   m_filter.reset();
+  // the voices may outlive the device, e.g. in a voice pool, so they must not keep their sources
   for(const auto& voice : m_allVoices)
-  {
-    if(const auto& src = voice->getSourceHandle())
-      src->setDirectFilter(nullptr);
-  }
+    voice->dissociate();
   m_allVoices.clear();
+  for(auto& sources : m_freeSources)
+    sources.clear();
 }
 
 void Device::update()
@@ -199,8 +199,10 @@ void Device::update()
         m_streams.emplace(stream);
     }
   }
-  m_allVoices.erase(std::remove_if(m_allVoices.begin(), m_allVoices.end(), [](const auto& v) { return v->done(); }),
-                    m_allVoices.end());
+  const auto doneVoices
+    = std::stable_partition(m_allVoices.begin(), m_allVoices.end(), [](const auto& v) { return !v->done(); });
+  std::for_each(doneVoices, m_allVoices.end(), [this](const auto& v) { releaseSource(*v); });
+  m_allVoices.erase(doneVoices, m_allVoices.end());
 
   // order voices by non-positional, then by distance
   glm::vec3 listenerPos;
@@ -220,7 +222,7 @@ void Device::update()
   {
     if(voice->isPaused())
     {
-      voice->associate(nullptr);
+      releaseSource(*voice);
       continue;
     }
 
@@ -228,12 +230,12 @@ void Device::update()
     if(vi < SourceHandleSlots)
     {
       if(!voice->hasSourceHandle())
-        voice->associate(std::make_unique<SourceHandle>(voice->isPositional()));
+        voice->associate(acquireSource(voice->isPositional()));
       voice->getSourceHandle()->setDirectFilter(m_filter);
     }
     else
     {
-      voice->associate(nullptr);
+      releaseSource(*voice);
     }
   }
 
@@ -244,6 +246,29 @@ void Device::update()
   }
 }
 
+std::unique_ptr<SourceHandle> Device::acquireSource(const bool positional)
+{
+  auto& sources = m_freeSources[positional ? 1 : 0];
+  if(sources.empty())
+    return std::make_unique<SourceHandle>(positional);
+
+  auto source = std::move(sources.back());
+  sources.pop_back();
+  return source;
+}
+
+void Device::releaseSource(Voice& voice)
+{
+  auto source = voice.dissociate();
+  if(source == nullptr)
+    return;
+
+  // back to the initial state, so the next voice doesn't see a stopped source
+  source->rewind();
+  source->setDirectFilter(nullptr);
+  m_freeSources[source->isPositional() ? 1 : 0].emplace_back(std::move(source));
+}
+
 gsl::not_null<std::shared_ptr<StreamVoice>> Device::createStream(std::unique_ptr<AbstractStreamSource>&& src,
                                                                  const size_t bufferSize,
                                                                  const size_t bufferCount,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <AL/alc.h>
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <glm/vec3.hpp>
@@ -17,6 +18,7 @@ class Voice;
 class StreamVoice;
 class FilterHandle;
 class AbstractStreamSource;
+class SourceHandle;
 
 class Device final
 {
@@ -69,6 +71,9 @@ public:
   }
 
 private:
+  [[nodiscard]] std::unique_ptr<SourceHandle> acquireSource(bool positional);
+  void releaseSource(Voice& voice);
+
   ALCdevice* m_device = nullptr;
   ALCcontext* m_context = nullptr;
   std::shared_ptr<FilterHandle> m_underwaterFilter = nullptr;
@@ -78,6 +83,8 @@ private:
   std::recursive_mutex m_streamsLock;
   bool m_shutdown = false;
   std::shared_ptr<FilterHandle> m_filter{nullptr};
+  //! sources released by voices, by whether they are positional; creating sources is expensive with some drivers
+  std::array<std::vector<std::unique_ptr<SourceHandle>>, 2> m_freeSources;
   std::chrono::system_clock::time_point m_lastLogTime = std::chrono::system_clock::now();
 
   void updateStreams();
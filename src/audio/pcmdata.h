@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace audio
+{
+// interleaved samples, decoded without an OpenAL context, so they can be produced on any thread
+struct PcmData
+{
+  std::vector<int16_t> samples;
+  int channels = 0;
+  int sampleRate = 0;
+};
+} // namespace audio
@@ -0,0 +1,52 @@
+#include "pcmstreamsource.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace audio
+{
+PcmStreamSource::PcmStreamSource(gsl::not_null<std::shared_ptr<const PcmData>> pcm)
+    : m_pcm{std::move(pcm)}
+    , m_frameCount{m_pcm->samples.size() / m_pcm->channels}
+{
+  Expects(m_pcm->channels > 0 && m_pcm->sampleRate > 0);
+}
+
+size_t PcmStreamSource::read(int16_t* buffer, const size_t bufferSize, const bool looping)
+{
+  const auto channels = gsl::narrow_cast<size_t>(m_pcm->channels);
+  size_t written = 0;
+  while(written < bufferSize)
+  {
+    if(m_position >= m_frameCount)
+    {
+      if(!looping || m_frameCount == 0)
+        break;
+      m_position = 0;
+    }
+
+    const auto n = std::min(bufferSize - written, m_frameCount - m_position);
+    std::copy_n(&m_pcm->samples[m_position * channels], n * channels, buffer + written * channels);
+    written += n;
+    m_position += n;
+  }
+  return written;
+}
+
+std::chrono::milliseconds PcmStreamSource::getPosition() const
+{
+  return std::chrono::milliseconds{m_position * 1000 / m_pcm->sampleRate};
+}
+
+void PcmStreamSource::seek(const std::chrono::milliseconds& position)
+{
+  const auto frame = std::max(position.count(), std::chrono::milliseconds::rep{0}) * m_pcm->sampleRate / 1000;
+  m_position = std::min(gsl::narrow_cast<size_t>(frame), m_frameCount);
+}
+
+Clock::duration PcmStreamSource::getDuration() const
+{
+  return std::chrono::duration_cast<Clock::duration>(
+    std::chrono::milliseconds{m_frameCount * 1000 / m_pcm->sampleRate});
+}
+} // namespace audio
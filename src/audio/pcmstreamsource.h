@@ -0,0 +1,42 @@
+#pragma once
+
+#include "core.h"
+#include "pcmdata.h"
+#include "streamsource.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <gsl/gsl-lite.hpp>
+#include <memory>
+
+namespace audio
+{
+// plays already decoded samples, e.g. cached tracks, without any decoding or I/O on the stream updater thread
+class PcmStreamSource final : public AbstractStreamSource
+{
+public:
+  explicit PcmStreamSource(gsl::not_null<std::shared_ptr<const PcmData>> pcm);
+
+  size_t read(int16_t* buffer, size_t bufferSize, bool looping) override;
+
+  [[nodiscard]] int getChannels() const override
+  {
+    return m_pcm->channels;
+  }
+
+  [[nodiscard]] int getSampleRate() const override
+  {
+    return m_pcm->sampleRate;
+  }
+
+  [[nodiscard]] std::chrono::milliseconds getPosition() const override;
+  void seek(const std::chrono::milliseconds& position) override;
+  [[nodiscard]] Clock::duration getDuration() const override;
+
+private:
+  const gsl::not_null<std::shared_ptr<const PcmData>> m_pcm;
+  const size_t m_frameCount;
+  size_t m_position = 0;
+};
+} // namespace audio
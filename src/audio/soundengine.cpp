@@ -16,6 +16,11 @@
 
 namespace audio
 {
+namespace
+{
+constexpr size_t MaxFreeVoices = 256;
+} // namespace
+
 void SoundEngine::update()
 {
   m_device->update();
@@ -100,7 +105,7 @@ gsl::not_null<std::shared_ptr<BufferVoice>>
                           ALfloat volume,
                           Emitter* emitter)
 {
-  auto v = gslu::make_nn_shared<BufferVoice>(buffer);
+  auto v = acquireVoice(buffer);
   v->setPitch(pitch);
   v->setLocalGain(volume);
   if(emitter != nullptr)
@@ -129,6 +134,7 @@ void SoundEngine::dropEmitter(Emitter* emitter)
 
 SoundEngine::SoundEngine()
     : m_device{std::make_unique<Device>()}
+    , m_voicePool{std::make_shared<VoicePool<BufferVoice>>(MaxFreeVoices)}
 {
 }
 
@@ -158,10 +164,30 @@ gsl::not_null<std::shared_ptr<BufferVoice>>
   return voice;
 }
 
+gsl::not_null<std::shared_ptr<BufferVoice>>
+  SoundEngine::acquireVoice(const gsl::not_null<std::shared_ptr<BufferHandle>>& buffer)
+{
+  return m_voicePool->acquire([&buffer]() { return std::make_unique<BufferVoice>(buffer); },
+                              [&buffer](BufferVoice& voice) { voice.reuse(buffer); },
+                              [](BufferVoice& voice)
+                              {
+                                // voices still owning a source are dropped outside of the device's update, so they're
+                                // not worth keeping
+                                if(voice.hasSourceHandle())
+                                  return false;
+                                voice.stop();
+                                return true;
+                              });
+}
+
 void SoundEngine::reset()
 {
   BOOST_LOG_TRIVIAL(debug) << "Resetting sound engine";
+  BOOST_LOG_TRIVIAL(debug) << "Voice pool: " << m_voicePool->getCreatedVoices() << " voices created, "
+                           << m_voicePool->getReusedVoices() << " reused";
   m_device->reset();
+  // the pooled voices keep their last buffers alive
+  m_voicePool->clear();
   m_voices.clear();
   m_listener = nullptr;
   m_emitters.clear();
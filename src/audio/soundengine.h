@@ -1,5 +1,7 @@
 #pragma once
 
+#include "voicepool.h"
+
 #include <AL/al.h>
 #include <cstddef>
 #include <glm/vec3.hpp>
@@ -67,7 +69,12 @@ public:
   void reset();
 
 private:
+  [[nodiscard]] gsl::not_null<std::shared_ptr<BufferVoice>>
+    acquireVoice(const gsl::not_null<std::shared_ptr<BufferHandle>>& buffer);
+
   const gsl::not_null<std::unique_ptr<Device>> m_device;
+  //! shared with the deleters of the voices, as voices may outlive the sound engine
+  const gsl::not_null<std::shared_ptr<VoicePool<BufferVoice>>> m_voicePool;
   std::unordered_map<Emitter*, std::unordered_map<size_t, std::vector<std::weak_ptr<Voice>>>> m_voices;
   const Listener* m_listener = nullptr;
 
@@ -19,6 +19,7 @@ namespace audio
 {
 SourceHandle::SourceHandle(bool positional)
     : Handle{alGenSources, alIsSource, alDeleteSources}
+    , m_positional{positional}
 {
   if(positional)
   {
@@ -38,6 +38,14 @@ public:
   void setGain(ALfloat gain);
   void setPosition(const glm::vec3& position);
   void setPitch(ALfloat pitch_value);
+
+  [[nodiscard]] bool isPositional() const
+  {
+    return m_positional;
+  }
+
+private:
+  const bool m_positional;
 };
 
 class StreamingSourceHandle : public SourceHandle
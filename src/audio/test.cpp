@@ -0,0 +1,258 @@
+#define BOOST_TEST_MODULE audio
+
+#include "pcmstreamsource.h"
+#include "voicepool.h"
+#include "wadfile.h"
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct TestVoice
+{
+  explicit TestVoice(const size_t buffer)
+      : buffer{buffer}
+  {
+  }
+
+  size_t buffer;
+  bool playing = true;
+  //! the sample data a voice keeps for mixing
+  std::vector<float> scratch = std::vector<float>(512);
+};
+
+std::shared_ptr<audio::VoicePool<TestVoice>> createPool(const size_t maxFreeVoices)
+{
+  return std::make_shared<audio::VoicePool<TestVoice>>(maxFreeVoices);
+}
+
+std::shared_ptr<TestVoice> play(audio::VoicePool<TestVoice>& pool, const size_t buffer)
+{
+  return pool.acquire([buffer]() { return std::make_unique<TestVoice>(buffer); },
+                      [buffer](TestVoice& voice)
+                      {
+                        voice.buffer = buffer;
+                        voice.playing = true;
+                      },
+                      [](TestVoice& voice)
+                      {
+                        voice.playing = false;
+                        return true;
+                      })
+    .get();
+}
+
+// stereo frames at 1 kHz, so each frame is one millisecond; frame i holds the samples i and -i
+gsl::not_null<std::shared_ptr<const audio::PcmData>> createPcm(const int16_t frames)
+{
+  auto pcm = std::make_shared<audio::PcmData>();
+  pcm->channels = 2;
+  pcm->sampleRate = 1000;
+  for(int16_t i = 0; i < frames; ++i)
+  {
+    pcm->samples.emplace_back(i);
+    pcm->samples.emplace_back(static_cast<int16_t>(-i));
+  }
+  return gsl::not_null{std::shared_ptr<const audio::PcmData>{std::move(pcm)}};
+}
+
+std::vector<int16_t> readFrames(audio::PcmStreamSource& source, const size_t frames, const bool looping)
+{
+  std::vector<int16_t> buffer(frames * 2, -1);
+  buffer.resize(source.read(buffer.data(), frames, looping) * 2);
+  return buffer;
+}
+
+// the layout of CDAUDIO.WAD: a directory of 130 entries of 268 bytes, each with a name of up to 260 bytes followed by
+// the offset and length of the track data
+constexpr size_t WadEntrySize = 268;
+constexpr size_t WadNameSize = 260;
+constexpr size_t WadTrackCount = 130;
+
+void writeWadEntry(
+  std::vector<uint8_t>& wad, const size_t index, const std::string& name, const uint32_t offset, const uint32_t length)
+{
+  const auto entry = wad.data() + index * WadEntrySize;
+  std::copy_n(name.begin(), std::min(name.size(), WadNameSize), entry);
+  std::memcpy(entry + WadNameSize, &offset, sizeof(offset));
+  std::memcpy(entry + WadNameSize + sizeof(offset), &length, sizeof(length));
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(audio_tests)
+
+BOOST_AUTO_TEST_CASE(test_voice_pool_reuse)
+{
+  const auto pool = createPool(1);
+
+  auto voice = play(*pool, 1);
+  const auto* firstVoice = voice.get();
+  const std::weak_ptr<TestVoice> reference = voice;
+  voice.reset();
+  // references expire as if the voice was freed
+  BOOST_CHECK(reference.expired());
+  BOOST_CHECK_EQUAL(pool->getFreeVoiceCount(), 1u);
+
+  voice = play(*pool, 2);
+  BOOST_CHECK_EQUAL(voice.get(), firstVoice);
+  BOOST_CHECK_EQUAL(voice->buffer, 2u);
+  BOOST_CHECK(voice->playing);
+  BOOST_CHECK_EQUAL(pool->getCreatedVoices(), 1u);
+  BOOST_CHECK_EQUAL(pool->getReusedVoices(), 1u);
+
+  // only one free voice is kept
+  auto other = play(*pool, 3);
+  voice.reset();
+  other.reset();
+  BOOST_CHECK_EQUAL(pool->getFreeVoiceCount(), 1u);
+
+  pool->clear();
+  BOOST_CHECK_EQUAL(pool->getFreeVoiceCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_voice_pool_outlived)
+{
+  auto pool = createPool(4);
+  auto voice = play(*pool, 1);
+  const std::weak_ptr<TestVoice> reference = voice;
+  pool.reset();
+  // releasing a voice after its pool is gone just frees it
+  voice.reset();
+  BOOST_CHECK(reference.expired());
+}
+
+BOOST_AUTO_TEST_CASE(test_voice_pool_benchmark, *boost::unit_test::label("benchmark"))
+{
+  // a gunfight firing 500 effects per second for a minute, each playing for half a second
+  static constexpr size_t Frames = 60 * 30;
+  static constexpr size_t EffectsPerFrame = 500 / 30;
+  static constexpr size_t PlayFrames = 15;
+
+  const auto run = [](const auto& play)
+  {
+    std::deque<std::vector<std::shared_ptr<TestVoice>>> playing;
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t frame = 0; frame < Frames; ++frame)
+    {
+      auto& started = playing.emplace_back();
+      for(size_t i = 0; i < EffectsPerFrame; ++i)
+        started.emplace_back(play(frame * EffectsPerFrame + i));
+      if(playing.size() > PlayFrames)
+        playing.pop_front();
+    }
+    return std::chrono::steady_clock::now() - start;
+  };
+
+  const auto allocatedTime = run([](const size_t buffer) { return std::make_shared<TestVoice>(buffer); });
+  const auto pool = createPool(256);
+  const auto pooledTime = run([&pool](const size_t buffer) { return play(*pool, buffer); });
+
+  // after the first half second, every effect reuses a finished voice
+  BOOST_CHECK_LE(pool->getCreatedVoices(), (PlayFrames + 1) * EffectsPerFrame);
+  BOOST_CHECK_EQUAL(pool->getCreatedVoices() + pool->getReusedVoices(), Frames * EffectsPerFrame);
+
+  const auto toMicroseconds = [](const auto& duration)
+  { return std::chrono::duration_cast<std::chrono::microseconds>(duration).count(); };
+  BOOST_TEST_MESSAGE(Frames * EffectsPerFrame << " effects: " << toMicroseconds(allocatedTime) << "us allocating, "
+                                              << toMicroseconds(pooledTime) << "us pooled");
+}
+
+BOOST_AUTO_TEST_CASE(test_pcm_stream_read)
+{
+  audio::PcmStreamSource source{createPcm(10)};
+  BOOST_CHECK_EQUAL(source.getChannels(), 2);
+  BOOST_CHECK(source.getDuration() == std::chrono::milliseconds{10});
+
+  const auto first = readFrames(source, 4, false);
+  BOOST_CHECK((first == std::vector<int16_t>{0, 0, 1, -1, 2, -2, 3, -3}));
+  BOOST_CHECK_EQUAL(source.getPosition().count(), 4);
+
+  // without looping, reads stop at the end of the samples
+  BOOST_CHECK_EQUAL(readFrames(source, 8, false).size(), 12u);
+  BOOST_CHECK_EQUAL(source.getPosition().count(), 10);
+  BOOST_CHECK(readFrames(source, 8, false).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_pcm_stream_looping)
+{
+  audio::PcmStreamSource source{createPcm(3)};
+  // a single read wraps around several times
+  const auto samples = readFrames(source, 7, true);
+  BOOST_CHECK((samples == std::vector<int16_t>{0, 0, 1, -1, 2, -2, 0, 0, 1, -1, 2, -2, 0, 0}));
+  BOOST_CHECK_EQUAL(source.getPosition().count(), 1);
+
+  // a looping read at the end restarts from the beginning
+  source.seek(std::chrono::milliseconds{3});
+  BOOST_CHECK((readFrames(source, 1, true) == std::vector<int16_t>{0, 0}));
+
+  // empty data can't loop
+  audio::PcmStreamSource empty{createPcm(0)};
+  BOOST_CHECK(readFrames(empty, 4, true).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_pcm_stream_seek)
+{
+  audio::PcmStreamSource source{createPcm(10)};
+  source.seek(std::chrono::milliseconds{5});
+  BOOST_CHECK_EQUAL(source.getPosition().count(), 5);
+  BOOST_CHECK((readFrames(source, 1, false) == std::vector<int16_t>{5, -5}));
+
+  // positions before the start and after the end are clamped
+  source.seek(std::chrono::milliseconds{-20});
+  BOOST_CHECK_EQUAL(source.getPosition().count(), 0);
+  BOOST_CHECK((readFrames(source, 1, false) == std::vector<int16_t>{0, 0}));
+
+  source.seek(std::chrono::milliseconds{1000});
+  BOOST_CHECK_EQUAL(source.getPosition().count(), 10);
+  BOOST_CHECK(readFrames(source, 1, false).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_wad_directory)
+{
+  const std::vector<uint8_t> payload{1, 2, 3, 4, 5};
+  const auto dataOffset = static_cast<uint32_t>(WadEntrySize * WadTrackCount);
+  std::vector<uint8_t> wad(dataOffset + payload.size());
+  std::copy(payload.begin(), payload.end(), wad.begin() + dataOffset);
+
+  writeWadEntry(wad, 0, "track00", dataOffset, 2);
+  writeWadEntry(wad, 1, "track01", dataOffset + 2, 3);
+  // a name filling the whole field has no terminator
+  writeWadEntry(wad, 2, std::string(WadNameSize, 'x'), dataOffset, 0);
+  writeWadEntry(wad, WadTrackCount - 1, "last", dataOffset + 4, 1);
+  // the data of this track would end after the file
+  writeWadEntry(wad, 3, "truncated", dataOffset + 4, 2);
+
+  const audio::WadFile wadFile{std::move(wad)};
+  BOOST_CHECK_EQUAL(wadFile.getTrackCount(), WadTrackCount);
+  BOOST_CHECK_EQUAL(wadFile.getTrackName(0), "track00");
+  BOOST_CHECK_EQUAL(wadFile.getTrackName(2), std::string(WadNameSize, 'x'));
+  BOOST_CHECK(wadFile.getTrackName(4).empty());
+
+  const auto first = wadFile.getTrackData(0);
+  BOOST_CHECK((std::vector<uint8_t>{first.begin(), first.end()} == std::vector<uint8_t>{1, 2}));
+  const auto second = wadFile.getTrackData(1);
+  BOOST_CHECK((std::vector<uint8_t>{second.begin(), second.end()} == std::vector<uint8_t>{3, 4, 5}));
+  BOOST_CHECK(wadFile.getTrackData(2).empty());
+  const auto last = wadFile.getTrackData(WadTrackCount - 1);
+  BOOST_CHECK((std::vector<uint8_t>{last.begin(), last.end()} == std::vector<uint8_t>{5}));
+
+  BOOST_CHECK_THROW(static_cast<void>(wadFile.getTrackData(3)), std::runtime_error);
+  BOOST_CHECK_THROW(static_cast<void>(wadFile.getTrackData(WadTrackCount)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(test_wad_too_small)
+{
+  BOOST_CHECK_THROW(audio::WadFile{std::vector<uint8_t>(WadEntrySize * WadTrackCount - 1)}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
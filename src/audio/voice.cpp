@@ -4,6 +4,7 @@
 #include "sourcehandle.h"
 
 #include <AL/al.h>
+#include <gsl/gsl-lite.hpp>
 #include <utility>
 
 namespace audio
@@ -67,6 +68,7 @@ void Voice::setPitch(ALfloat pitch)
 {
   if(m_source != nullptr)
     m_source->setPitch(pitch);
+  m_pitch = pitch;
 }
 
 void Voice::setPosition(const glm::vec3& position)
@@ -128,6 +130,26 @@ void Voice::associate(std::unique_ptr<SourceHandle>&& source)
   m_startedPlaying = true;
 }
 
+std::unique_ptr<SourceHandle> Voice::dissociate()
+{
+  if(m_source != nullptr)
+    m_source->stop();
+  return std::move(m_source);
+}
+
+void Voice::resetState()
+{
+  Expects(m_source == nullptr);
+  m_playStartTime.reset();
+  m_groupGain = 1.0f;
+  m_localGain = 1.0f;
+  m_pitch = 1.0f;
+  m_paused.reset();
+  m_looping = false;
+  m_startedPlaying = false;
+  m_position.reset();
+}
+
 void Voice::updateGain()
 {
   if(m_source != nullptr)
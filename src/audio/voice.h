@@ -40,11 +40,17 @@ public:
   [[nodiscard]] const std::unique_ptr<SourceHandle>& getSourceHandle() const;
 
   virtual void associate(std::unique_ptr<SourceHandle>&& source);
+  //! stops and releases the source, so it can be associated with another voice
+  virtual std::unique_ptr<SourceHandle> dissociate();
 
   [[nodiscard]] bool done() const;
 
   [[nodiscard]] virtual Clock::duration getDuration() const = 0;
 
+protected:
+  //! restores the initial state for reusing the voice; the voice must not have a source
+  void resetState();
+
 private:
   std::optional<std::chrono::high_resolution_clock::time_point> m_playStartTime{};
   ALfloat m_groupGain = 1.0f;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <gsl/gsl-lite.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace audio
+{
+// Finished voices are kept for reuse instead of being freed. A voice is returned by the deleter of its shared pointer,
+// so weak references to a finished voice expire as before, and a reused voice starts with a fresh control block.
+template<typename TVoice>
+class VoicePool final : public std::enable_shared_from_this<VoicePool<TVoice>>
+{
+public:
+  explicit VoicePool(const size_t maxFreeVoices)
+      : m_maxFreeVoices{maxFreeVoices}
+  {
+    // returning a voice must not allocate, as it happens in a deleter
+    m_freeVoices.reserve(maxFreeVoices);
+  }
+
+  //! @param create creates a new voice if none is free
+  //! @param reuse prepares a free voice for another use
+  //! @param recycle is called when a voice is released; voices for which it returns false are freed
+  template<typename Create, typename Reuse, typename Recycle>
+  [[nodiscard]] gsl::not_null<std::shared_ptr<TVoice>>
+    acquire(const Create& create, const Reuse& reuse, const Recycle& recycle)
+  {
+    std::unique_ptr<TVoice> voice;
+    if(!m_freeVoices.empty())
+    {
+      voice = std::move(m_freeVoices.back());
+      m_freeVoices.pop_back();
+      reuse(*voice);
+      ++m_reusedVoices;
+    }
+    else
+    {
+      voice = create();
+      ++m_createdVoices;
+    }
+
+    return gsl::not_null{std::shared_ptr<TVoice>{
+      voice.release(),
+      [pool = this->weak_from_this(), recycle](TVoice* released)
+      {
+        std::unique_ptr<TVoice> owned{released};
+        const auto lockedPool = pool.lock();
+        if(lockedPool == nullptr || lockedPool->m_freeVoices.size() >= lockedPool->m_maxFreeVoices
+           || !recycle(*owned))
+          return;
+
+        lockedPool->m_freeVoices.emplace_back(std::move(owned));
+      }}};
+  }
+
+  void clear()
+  {
+    m_freeVoices.clear();
+  }
+
+  [[nodiscard]] auto getFreeVoiceCount() const noexcept
+  {
+    return m_freeVoices.size();
+  }
+
+  [[nodiscard]] auto getCreatedVoices() const noexcept
+  {
+    return m_createdVoices;
+  }
+
+  [[nodiscard]] auto getReusedVoices() const noexcept
+  {
+    return m_reusedVoices;
+  }
+
+private:
+  const size_t m_maxFreeVoices;
+  std::vector<std::unique_ptr<TVoice>> m_freeVoices;
+  size_t m_createdVoices = 0;
+  size_t m_reusedVoices = 0;
+};
+} // namespace audio
@@ -0,0 +1,74 @@
+#include "wadfile.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace audio
+{
+// CDAUDIO.WAD step size defines CDAUDIO's header stride, on which each track
+// info is placed. Also CDAUDIO count specifies static amount of tracks existing
+// in CDAUDIO.WAD file. Name length specifies maximum string size for trackname.
+constexpr size_t WADStride = 268;
+constexpr size_t WADNameLength = 260;
+constexpr size_t WADCount = 130;
+
+WadFile::WadFile(const std::filesystem::path& filename)
+{
+  BOOST_LOG_TRIVIAL(debug) << "Mapping WAD file " << filename;
+
+  try
+  {
+    m_file.open(filename.string());
+  }
+  catch(const std::exception& ex)
+  {
+    BOOST_LOG_TRIVIAL(error) << ex.what();
+    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to open WAD file"));
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  m_data = gsl::span{reinterpret_cast<const uint8_t*>(m_file.data()), m_file.size()};
+  parseDirectory();
+}
+
+WadFile::WadFile(std::vector<uint8_t> data)
+    : m_memory{std::move(data)}
+    , m_data{m_memory}
+{
+  parseDirectory();
+}
+
+void WadFile::parseDirectory()
+{
+  if(m_data.size() < WADStride * WADCount)
+    BOOST_THROW_EXCEPTION(std::runtime_error("WAD file is too small to contain the track directory"));
+
+  m_tracks.reserve(WADCount);
+  for(size_t i = 0; i < WADCount; ++i)
+  {
+    const auto entry = m_data.data() + i * WADStride;
+    Track track;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto name = reinterpret_cast<const char*>(entry);
+    track.name.assign(name, std::find(name, name + WADNameLength, '\0'));
+    std::memcpy(&track.offset, entry + WADNameLength, sizeof(uint32_t));
+    std::memcpy(&track.length, entry + WADNameLength + sizeof(uint32_t), sizeof(uint32_t));
+    m_tracks.emplace_back(std::move(track));
+  }
+}
+
+gsl::span<const uint8_t> WadFile::getTrackData(const size_t trackIndex) const
+{
+  const auto& track = m_tracks.at(trackIndex);
+  if(size_t{track.offset} + track.length > m_data.size())
+    BOOST_THROW_EXCEPTION(std::runtime_error("WAD track " + std::to_string(trackIndex) + " exceeds the file"));
+
+  return m_data.subspan(track.offset, track.length);
+}
+} // namespace audio
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <gsl/gsl-lite.hpp>
+#include <string>
+#include <vector>
+
+namespace audio
+{
+// CDAUDIO.WAD, mapped into memory with its track directory parsed once; the mapping is shared by all streams playing
+// from it
+class WadFile final
+{
+public:
+  explicit WadFile(const std::filesystem::path& filename);
+  //! uses a WAD file already in memory instead of mapping one
+  explicit WadFile(std::vector<uint8_t> data);
+
+  [[nodiscard]] gsl::span<const uint8_t> getTrackData(size_t trackIndex) const;
+
+  [[nodiscard]] const std::string& getTrackName(size_t trackIndex) const
+  {
+    return m_tracks.at(trackIndex).name;
+  }
+
+  [[nodiscard]] size_t getTrackCount() const noexcept
+  {
+    return m_tracks.size();
+  }
+
+private:
+  struct Track
+  {
+    std::string name;
+    uint32_t offset = 0;
+    uint32_t length = 0;
+  };
+
+  void parseDirectory();
+
+  boost::iostreams::mapped_file_source m_file;
+  std::vector<uint8_t> m_memory;
+  //! either the mapped file or the data in memory
+  gsl::span<const uint8_t> m_data;
+  std::vector<Track> m_tracks;
+};
+} // namespace audio
@@ -3,52 +3,94 @@
 #include "core.h"
 
 #include <algorithm>
-#include <array>
 #include <boost/log/trivial.hpp>
-#include <boost/throw_exception.hpp>
-#include <cstdio>
-#include <cstring>
+#include <chrono>
 #include <gsl/gsl-lite.hpp>
-#include <limits>
-#include <sstream>
-#include <stdexcept>
-#include <string>
-#include <vector>
+#include <utility>
 
 namespace audio
 {
-// CDAUDIO.WAD step size defines CDAUDIO's header stride, on which each track
-// info is placed. Also CDAUDIO count specifies static amount of tracks existing
-// in CDAUDIO.WAD file. Name length specifies maximum string size for trackname.
-constexpr size_t WADStride = 268;
-constexpr size_t WADNameLength = 260;
-constexpr size_t WADCount = 130;
-
-std::unique_ptr<video::FfmpegSubStreamStreamSource> createWadStream(const std::filesystem::path& filename,
-                                                                    const size_t trackIndex)
+WadStreamSource::WadStreamSource(std::shared_ptr<const WadFile> wadFile, const size_t trackIndex)
+    : m_wadFile{std::move(wadFile)}
+    , m_data{m_wadFile->getTrackData(trackIndex)}
+    , m_decoder{std::make_unique<video::FfmpegMemoryStreamSource>(m_data)}
 {
-  auto wadFile = std::make_unique<std::ifstream>(filename, std::ios::in | std::ios::binary);
-  BOOST_LOG_TRIVIAL(trace) << "Creating WAD stream source from " << filename << ", track " << trackIndex;
+  BOOST_LOG_TRIVIAL(info) << "Loading WAD track " << trackIndex << ": " << m_wadFile->getTrackName(trackIndex);
+  m_readAheadThread = std::thread{&WadStreamSource::readAhead, this};
+}
+
+WadStreamSource::~WadStreamSource()
+{
+  {
+    std::lock_guard lock{m_readAheadMutex};
+    m_stopReadAhead = true;
+  }
+  m_readAheadCondition.notify_one();
+  m_readAheadThread.join();
+}
+
+size_t WadStreamSource::read(int16_t* buffer, const size_t bufferSize, const bool looping)
+{
+  const auto read = m_decoder->read(buffer, bufferSize, looping);
+  updateReadAheadPosition();
+  return read;
+}
 
-  if(!wadFile->is_open())
-    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to open WAD file"));
+void WadStreamSource::seek(const std::chrono::milliseconds& position)
+{
+  m_decoder->seek(position);
+  updateReadAheadPosition();
+}
 
-  wadFile->seekg(gsl::narrow<std::ifstream::off_type>(trackIndex * WADStride), std::ios::beg);
+void WadStreamSource::updateReadAheadPosition()
+{
+  // the decoder doesn't expose its byte position, so it's estimated from the playback position
+  const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(m_decoder->getDuration()).count();
+  if(duration <= 0)
+    return;
 
-  std::array<char, WADNameLength> trackName{};
-  wadFile->read(trackName.data(), WADNameLength);
+  const auto progress = std::clamp(
+    static_cast<double>(m_decoder->getPosition().count()) / static_cast<double>(duration), 0.0, 1.0);
+  const auto position = static_cast<size_t>(progress * static_cast<double>(m_data.size()));
+  {
+    std::lock_guard lock{m_readAheadMutex};
+    if(m_readAheadPosition == position)
+      return;
+    m_readAheadPosition = position;
+  }
+  m_readAheadCondition.notify_one();
+}
 
-  BOOST_LOG_TRIVIAL(info) << "Loading WAD track " << trackIndex << ": " << trackName.data();
+void WadStreamSource::readAhead()
+{
+  static constexpr size_t PageSize = 4096;
 
-  uint32_t offset = 0;
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  wadFile->read(reinterpret_cast<char*>(&offset), 4);
+  size_t lastPosition = 0;
+  size_t readEnd = 0;
+  std::unique_lock lock{m_readAheadMutex};
+  while(!m_stopReadAhead)
+  {
+    const auto requestedPosition = m_readAheadPosition;
+    const auto position = std::min(requestedPosition, m_data.size());
+    // seeking backwards, e.g. when a looping track restarts, may need pages which have been evicted in the meantime
+    if(position < lastPosition || position > readEnd)
+      readEnd = position;
+    lastPosition = position;
 
-  uint32_t length = 0;
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-  wadFile->read(reinterpret_cast<char*>(&length), 4);
+    const auto end = std::min(position + ReadAheadSize, m_data.size());
+    if(readEnd >= end)
+    {
+      m_readAheadCondition.wait(
+        lock, [this, requestedPosition]() { return m_stopReadAhead || m_readAheadPosition != requestedPosition; });
+      continue;
+    }
 
-  wadFile->seekg(offset, std::ios::beg);
-  return std::make_unique<video::FfmpegSubStreamStreamSource>(std::move(wadFile), offset, offset + length);
+    // the decoder must not wait for the page faults
+    lock.unlock();
+    // touching a byte of each page is enough to have it read into memory
+    for(; readEnd < end && !m_stopReadAhead; readEnd += PageSize)
+      static_cast<void>(*static_cast<const volatile uint8_t*>(&m_data[readEnd]));
+    lock.lock();
+  }
 }
 } // namespace audio
@@ -3,16 +3,67 @@
 #include "core.h"
 #include "streamsource.h"
 #include "video/ffmpegstreamsource.h"
+#include "wadfile.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
-#include <filesystem>
-#include <fstream>
+#include <gsl/gsl-lite.hpp>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 namespace audio
 {
-extern std::unique_ptr<video::FfmpegSubStreamStreamSource> createWadStream(const std::filesystem::path& filename,
-                                                                           size_t trackIndex);
+// Decodes a track directly from the mapped file. The pages ahead of the decoder are touched on a background thread, so
+// the stream updater doesn't block on disk I/O when the decoder reaches them.
+class WadStreamSource final : public AbstractStreamSource
+{
+public:
+  explicit WadStreamSource(std::shared_ptr<const WadFile> wadFile, size_t trackIndex);
+  ~WadStreamSource() override;
+
+  size_t read(int16_t* buffer, size_t bufferSize, bool looping) override;
+
+  [[nodiscard]] int getChannels() const override
+  {
+    return m_decoder->getChannels();
+  }
+
+  [[nodiscard]] int getSampleRate() const override
+  {
+    return m_decoder->getSampleRate();
+  }
+
+  [[nodiscard]] std::chrono::milliseconds getPosition() const override
+  {
+    return m_decoder->getPosition();
+  }
+
+  void seek(const std::chrono::milliseconds& position) override;
+
+  [[nodiscard]] Clock::duration getDuration() const override
+  {
+    return m_decoder->getDuration();
+  }
+
+private:
+  //! bytes kept in memory ahead of the decoder
+  static constexpr size_t ReadAheadSize = 256 * 1024;
+
+  void updateReadAheadPosition();
+  void readAhead();
+
+  const std::shared_ptr<const WadFile> m_wadFile;
+  const gsl::span<const uint8_t> m_data;
+  //! guards m_readAheadPosition and the changes of m_stopReadAhead, so no wakeup of the read-ahead thread is lost
+  std::mutex m_readAheadMutex;
+  std::condition_variable m_readAheadCondition;
+  size_t m_readAheadPosition = 0;
+  std::atomic<bool> m_stopReadAhead{false};
+  std::thread m_readAheadThread;
+  const gsl::not_null<std::unique_ptr<video::FfmpegMemoryStreamSource>> m_decoder;
+};
 } // namespace audio
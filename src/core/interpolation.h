@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace core
+{
+// interpolates between two affine transforms consisting of translation, rotation and scale; the rotation is
+// interpolated spherically so intermediate frames of rotating objects keep their shape
+inline glm::mat4 interpolateTransform(const glm::mat4& a, const glm::mat4& b, const float bias)
+{
+  if(bias <= 0)
+    return a;
+  if(bias >= 1)
+    return b;
+
+  const glm::vec3 scaleA{glm::length(glm::vec3{a[0]}), glm::length(glm::vec3{a[1]}), glm::length(glm::vec3{a[2]})};
+  const glm::vec3 scaleB{glm::length(glm::vec3{b[0]}), glm::length(glm::vec3{b[1]}), glm::length(glm::vec3{b[2]})};
+
+  static constexpr float MinScale = 1e-6f;
+  if(glm::any(glm::lessThan(glm::min(scaleA, scaleB), glm::vec3{MinScale})))
+    return a + (b - a) * bias;
+
+  const auto rotationA
+    = glm::quat_cast(glm::mat3{glm::vec3{a[0]} / scaleA.x, glm::vec3{a[1]} / scaleA.y, glm::vec3{a[2]} / scaleA.z});
+  const auto rotationB
+    = glm::quat_cast(glm::mat3{glm::vec3{b[0]} / scaleB.x, glm::vec3{b[1]} / scaleB.y, glm::vec3{b[2]} / scaleB.z});
+  const auto scale = glm::mix(scaleA, scaleB, bias);
+
+  glm::mat4 result = glm::mat4_cast(glm::slerp(rotationA, rotationB, bias));
+  result[0] *= scale.x;
+  result[1] *= scale.y;
+  result[2] *= scale.z;
+  result[3] = glm::vec4{glm::mix(glm::vec3{a[3]}, glm::vec3{b[3]}, bias), 1.0f};
+  return result;
+}
+} // namespace core
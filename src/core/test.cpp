@@ -2,8 +2,10 @@
 
 #include "angle.h"
 #include "boundingbox.h"
+#include "interpolation.h"
 
 #include <boost/test/unit_test.hpp>
+#include <glm/gtc/matrix_transform.hpp>
 
 namespace core
 {
@@ -182,4 +184,28 @@ BOOST_AUTO_TEST_CASE(test_bounding_box_intersects)
   BOOST_CHECK(!f.intersectsExclusive(f));
 }
 
+BOOST_AUTO_TEST_CASE(test_interpolate_transform)
+{
+  const auto tick0 = glm::translate(glm::mat4{1.0f}, glm::vec3{0, 0, 0});
+  const auto tick1 = glm::rotate(glm::translate(glm::mat4{1.0f}, glm::vec3{100, 0, -50}),
+                                 glm::radians(90.0f),
+                                 glm::vec3{0, 1, 0});
+
+  BOOST_CHECK(core::interpolateTransform(tick0, tick1, 0) == tick0);
+  BOOST_CHECK(core::interpolateTransform(tick0, tick1, 1) == tick1);
+
+  const auto expected
+    = glm::rotate(glm::translate(glm::mat4{1.0f}, glm::vec3{50, 0, -25}), glm::radians(45.0f), glm::vec3{0, 1, 0});
+  const auto half = core::interpolateTransform(tick0, tick1, 0.5f);
+  for(int i = 0; i < 4; ++i)
+  {
+    for(int j = 0; j < 4; ++j)
+      BOOST_CHECK_SMALL(half[i][j] - expected[i][j], 1e-4f);
+  }
+
+  // the rotation part must stay orthonormal
+  BOOST_CHECK_SMALL(glm::length(glm::vec3{half[0]}) - 1.0f, 1e-5f);
+  BOOST_CHECK_SMALL(glm::dot(glm::vec3{half[0]}, glm::vec3{half[2]}), 1e-5f);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -118,6 +118,8 @@ int main()
         runResult = engine.runLevelSequenceItem(*item, player);
       break;
     case Mode::Game:
+      // only levels played in sequence know what comes next
+      engine.setNextLevelSequenceItem(engine.getScriptEngine().getLevelSequenceItem(levelSequenceIndex + 1));
       if(doLoad)
       {
         player = std::make_shared<engine::Player>();
@@ -135,6 +137,7 @@ int main()
       break;
     }
 
+    engine.setNextLevelSequenceItem(nullptr);
     loadSlot.reset();
     doLoad = false;
 
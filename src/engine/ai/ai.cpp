@@ -239,7 +239,7 @@ void updateMood(const objects::AIAgent& aiAgent, const EnemyLocation& enemyLocat
     creatureInfo.pathFinder.setRandomSearchTarget(aiAgent.m_state.getCurrentBox());
   }
   if(newTargetBox != nullptr)
-    creatureInfo.pathFinder.setTargetBox(gsl::not_null{newTargetBox});
+    creatureInfo.pathFinder.setTargetBox(aiAgent.getWorld(), gsl::not_null{newTargetBox});
   creatureInfo.pathFinder.calculateTarget(
     aiAgent.getWorld(), creatureInfo.target, aiAgent.m_state.location.position, aiAgent.m_state.getCurrentBox());
 }
@@ -19,6 +19,8 @@
 #include <boost/assert.hpp>
 #include <cstdint>
 #include <exception>
+#include <iterator>
+#include <unordered_map>
 
 namespace engine::ai
 {
@@ -241,22 +243,18 @@ bool PathFinder::calculateTarget(const world::World& world,
 
 void PathFinder::searchPath(const world::World& world)
 {
+  initSearchState(world);
   const auto zoneRef = world::Box::getZoneRef(world.roomsAreSwapped(), isFlying(), step);
 
   static constexpr uint8_t MaxExpansions = 15;
 
-  auto setReachable = [this](const gsl::not_null<const world::Box*>& box, bool reachable)
-  {
-    m_reachable[box] = reachable;
-    if(std::find(m_expansions.begin(), m_expansions.end(), box) == m_expansions.end())
-      m_expansions.emplace_back(box);
-  };
-
   for(uint8_t i = 0; i < MaxExpansions && !m_expansions.empty(); ++i)
   {
     const auto currentBox = m_expansions.front();
     m_expansions.pop_front();
+    m_isExpansion[getBoxId(currentBox)] = false;
     const auto searchZone = currentBox.get()->*zoneRef;
+    const bool currentReachable = m_reachability[getBoxId(currentBox)] == Reachability::Reachable;
 
     for(const auto& successorBox : currentBox->overlaps)
     {
@@ -270,43 +268,106 @@ void PathFinder::searchPath(const world::World& world)
          boxHeightDiff > step || boxHeightDiff < drop)
         continue;
 
-      const auto it = m_reachable.find(successorBox);
-      const bool initialized = it != m_reachable.end();
+      const auto successorId = getBoxId(successorBox);
+      const auto successorReachability = m_reachability[successorId];
 
-      if(!m_reachable.at(currentBox))
+      if(!currentReachable)
       {
         // propagate "unreachable" to all connected boxes if their reachability hasn't been determined yet
-        if(!initialized)
+        if(successorReachability == Reachability::Unknown)
         {
-          setReachable(successorBox, false);
+          setReachability(successorBox, Reachability::Unreachable);
+          enqueueExpansion(successorBox);
         }
       }
       else
       {
         // propagate "reachable" to all connected boxes if their reachability hasn't been determined yet
         // OR they were previously determined to be unreachable
-        if(initialized && it->second)
+        if(successorReachability == Reachability::Reachable)
           continue; // already visited and marked reachable
 
         const auto reachable = canVisit(*successorBox);
         if(reachable)
         {
-          BOOST_ASSERT_MSG(m_edges.count(successorBox) == 0, "cycle in pathfinder graph detected");
-          m_edges.emplace(successorBox, currentBox); // success! connect both boxes
+          BOOST_ASSERT_MSG(m_edges[successorId] == nullptr, "cycle in pathfinder graph detected");
+          m_edges[successorId] = currentBox; // success! connect both boxes
         }
 
-        setReachable(successorBox, reachable);
+        setReachability(successorBox, reachable ? Reachability::Reachable : Reachability::Unreachable);
+        enqueueExpansion(successorBox);
       }
     }
   }
 }
 
+void PathFinder::initSearchState(const world::World& world)
+{
+  const auto& boxes = world.getBoxes();
+  if(m_levelBoxes == boxes.data() && m_reachability.size() == boxes.size())
+    return;
+
+  m_levelBoxes = boxes.data();
+  m_reachability.assign(boxes.size(), Reachability::Unknown);
+  m_edges.assign(boxes.size(), nullptr);
+  m_isExpansion.assign(boxes.size(), false);
+  m_visited.clear();
+  for(const auto& box : m_expansions)
+    m_isExpansion[getBoxId(box)] = true;
+}
+
+void PathFinder::resetSearchState()
+{
+  for(const auto id : m_visited)
+  {
+    m_reachability[id] = Reachability::Unknown;
+    m_edges[id] = nullptr;
+  }
+  m_visited.clear();
+
+  for(const auto& box : m_expansions)
+    m_isExpansion[getBoxId(box)] = false;
+  m_expansions.clear();
+}
+
+void PathFinder::setReachability(const gsl::not_null<const world::Box*>& box, const Reachability reachability)
+{
+  const auto id = getBoxId(box);
+  if(m_reachability[id] == Reachability::Unknown)
+    m_visited.emplace_back(id);
+  m_reachability[id] = reachability;
+}
+
+void PathFinder::enqueueExpansion(const gsl::not_null<const world::Box*>& box)
+{
+  auto& isExpansion = m_isExpansion[getBoxId(box)];
+  if(isExpansion)
+    return;
+
+  isExpansion = true;
+  m_expansions.emplace_back(box);
+}
+
 void PathFinder::serialize(const serialization::Serializer<world::World>& ser)
 {
-  ser(S_NV("edges", m_edges),
+  // the search state is stored per box id, but saved as maps to keep the savegame format
+  std::unordered_map<gsl::not_null<const world::Box*>, bool> reachable;
+  std::unordered_map<gsl::not_null<const world::Box*>, gsl::not_null<const world::Box*>> edges;
+  if(!ser.loading)
+  {
+    for(const auto id : m_visited)
+    {
+      const gsl::not_null box{&m_levelBoxes[id]};
+      reachable.emplace(box, m_reachability[id] == Reachability::Reachable);
+      if(m_edges[id] != nullptr)
+        edges.emplace(box, gsl::not_null{m_edges[id]});
+    }
+  }
+
+  ser(S_NV("edges", edges),
       S_NV("boxes", m_boxes),
       S_NV("expansions", m_expansions),
-      S_NV("reachable", m_reachable),
+      S_NV("reachable", reachable),
       S_NV("cannotVisitBlockable", cannotVisitBlockable),
       S_NV("cannotVisitBlocked", cannotVisitBlocked),
       S_NV("step", step),
@@ -314,22 +375,33 @@ void PathFinder::serialize(const serialization::Serializer<world::World>& ser)
       S_NV("fly", fly),
       S_NV_VECTOR_ELEMENT("targetBox", ser.context.getBoxes(), m_targetBox),
       S_NV("target", target));
+
+  if(ser.loading)
+  {
+    m_levelBoxes = nullptr;
+    initSearchState(ser.context);
+    for(const auto& [box, isReachable] : reachable)
+      setReachability(box, isReachable ? Reachability::Reachable : Reachability::Unreachable);
+    for(const auto& [from, to] : edges)
+      m_edges[getBoxId(from)] = to.get();
+  }
 }
 
 void PathFinder::collectBoxes(const world::World& world, const gsl::not_null<const world::Box*>& box)
 {
   const auto zoneRef1 = world::Box::getZoneRef(false, isFlying(), step);
   const auto zoneRef2 = world::Box::getZoneRef(true, isFlying(), step);
-  const auto zoneData1 = box.get()->*zoneRef1;
-  const auto zoneData2 = box.get()->*zoneRef2;
+  const auto& zoneBoxes1 = world.getBoxesInZone(zoneRef1, box.get()->*zoneRef1);
+  const auto& zoneBoxes2 = world.getBoxesInZone(zoneRef2, box.get()->*zoneRef2);
+  // both lists are ordered by box id, so merging them keeps the order of the level's boxes
   m_boxes.clear();
-  for(const auto& levelBox : world.getBoxes())
-  {
-    if(levelBox.*zoneRef1 == zoneData1 || levelBox.*zoneRef2 == zoneData2)
-    {
-      m_boxes.emplace_back(&levelBox);
-    }
-  }
+  std::set_union(zoneBoxes1.begin(),
+                 zoneBoxes1.end(),
+                 zoneBoxes2.begin(),
+                 zoneBoxes2.end(),
+                 std::back_inserter(m_boxes),
+                 [](const gsl::not_null<const world::Box*>& a, const gsl::not_null<const world::Box*>& b)
+                 { return a.get() < b.get(); });
 }
 
 bool PathFinder::canVisit(const world::Box& box) const noexcept
@@ -357,18 +429,17 @@ void PathFinder::setRandomSearchTarget(const gsl::not_null<const world::Box*>& b
   }
 }
 
-void PathFinder::setTargetBox(const gsl::not_null<const world::Box*>& box)
+void PathFinder::setTargetBox(const world::World& world, const gsl::not_null<const world::Box*>& box)
 {
   if(box == m_targetBox)
     return;
 
+  initSearchState(world);
   m_targetBox = box;
 
-  m_expansions.clear();
-  m_expansions.emplace_back(m_targetBox);
-  m_reachable.clear();
-  m_reachable[box] = true;
-  m_edges.clear();
+  resetSearchState();
+  enqueueExpansion(box);
+  setReachability(box, Reachability::Reachable);
 }
 
 const gsl::not_null<const world::Box*>& PathFinder::getRandomBox() const
@@ -6,10 +6,10 @@
 #include "qs/qs.h"
 #include "serialization/serialization_fwd.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <gsl/gsl-lite.hpp>
-#include <map>
-#include <unordered_map>
 #include <vector>
 
 // IWYU pragma: no_forward_declare serialization::Serializer
@@ -47,7 +47,7 @@ struct PathFinder
                        const core::TRVec& startPos,
                        const gsl::not_null<const world::Box*>& startBox);
 
-  void setTargetBox(const gsl::not_null<const world::Box*>& box);
+  void setTargetBox(const world::World& world, const gsl::not_null<const world::Box*>& box);
 
   void serialize(const serialization::Serializer<world::World>& ser);
 
@@ -56,16 +56,14 @@ struct PathFinder
   // returns true if and only if the box is visited and marked unreachable
   [[nodiscard]] bool isUnreachable(const gsl::not_null<const world::Box*>& box) const
   {
-    const auto it = m_reachable.find(box);
-    return it != m_reachable.end() && !it->second;
+    return !m_reachability.empty() && m_reachability[getBoxId(box)] == Reachability::Unreachable;
   }
 
   [[nodiscard]] const gsl::not_null<const world::Box*>& getRandomBox() const;
 
   [[nodiscard]] const world::Box* getNextPathBox(const gsl::not_null<const world::Box*>& box) const
   {
-    const auto it = m_edges.find(box);
-    return it == m_edges.end() ? nullptr : it->second.get();
+    return m_edges.empty() ? nullptr : m_edges[getBoxId(box)];
   }
 
   [[nodiscard]] const auto& getTargetBox() const
@@ -79,12 +77,36 @@ struct PathFinder
   }
 
 private:
+  enum class Reachability : uint8_t
+  {
+    Unknown,
+    Reachable,
+    Unreachable
+  };
+
   void searchPath(const world::World& world);
+  //! @brief Sizes the per-box search state for the level's boxes
+  void initSearchState(const world::World& world);
+  void resetSearchState();
+  void setReachability(const gsl::not_null<const world::Box*>& box, Reachability reachability);
+  void enqueueExpansion(const gsl::not_null<const world::Box*>& box);
+
+  [[nodiscard]] size_t getBoxId(const gsl::not_null<const world::Box*>& box) const
+  {
+    return gsl::narrow_cast<size_t>(box.get() - m_levelBoxes);
+  }
 
   std::vector<gsl::not_null<const world::Box*>> m_boxes;
   std::deque<gsl::not_null<const world::Box*>> m_expansions;
-  std::unordered_map<gsl::not_null<const world::Box*>, bool> m_reachable;
-  std::unordered_map<gsl::not_null<const world::Box*>, gsl::not_null<const world::Box*>> m_edges;
+  //! @brief Search state, indexed by box id
+  //! @{
+  const world::Box* m_levelBoxes = nullptr;
+  std::vector<Reachability> m_reachability;
+  std::vector<const world::Box*> m_edges;
+  std::vector<uint8_t> m_isExpansion;
+  //! @}
+  //! @brief Ids of the boxes with a known reachability, so resetting the search doesn't touch all boxes
+  std::vector<size_t> m_visited;
   //! @brief The target box we need to reach
   const world::Box* m_targetBox = nullptr;
 };
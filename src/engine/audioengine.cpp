@@ -3,9 +3,11 @@
 #include "audio/bufferhandle.h"
 #include "audio/buffervoice.h"
 #include "audio/device.h"
+#include "audio/pcmstreamsource.h"
 #include "audio/soundengine.h"
 #include "audio/streamsource.h"
 #include "audio/streamvoice.h"
+#include "audio/wadfile.h"
 #include "audio/wadstreamsource.h"
 #include "objects/laraobject.h"
 #include "script/reflection.h"
@@ -16,13 +18,33 @@
 #include "serialization/serialization.h"
 #include "tracks_tr1.h"
 #include "util/helpers.h"
+#include "util/parallel.h"
 #include "video/ffmpegstreamsource.h"
 #include "world/world.h"
 
+#include <algorithm>
 #include <boost/format.hpp>
+#include <chrono>
+#include <cstring>
+#include <exception>
 
 namespace engine
 {
+namespace
+{
+// the sample decoder relies on the size stored in the RIFF header
+bool isCompleteWav(const gsl::span<const uint8_t>& data)
+{
+  if(data.size() < 12 || !std::equal(data.begin(), std::next(data.begin(), 4), "RIFF")
+     || !std::equal(std::next(data.begin(), 8), std::next(data.begin(), 12), "WAVE"))
+    return false;
+
+  uint32_t riffSize = 0;
+  std::memcpy(&riffSize, data.data() + 4, sizeof(uint32_t));
+  return size_t{riffSize} + 8 <= data.size();
+}
+} // namespace
+
 void AudioEngine::triggerCdTrack(const script::ScriptEngine& scriptEngine,
                                  TR1TrackId trackId,
                                  const floordata::ActivationState& activationRequest,
@@ -160,7 +182,7 @@ void AudioEngine::playStopCdTrack(const script::ScriptEngine& scriptEngine, cons
     if(!stop)
     {
       BOOST_LOG_TRIVIAL(debug) << "playStopCdTrack - play ambient " << toString(trackId);
-      const auto stream = playStream(trackInfo.id.get());
+      const auto stream = playStream(trackInfo.id.get(), std::chrono::milliseconds{0}, true);
       stream->setLooping(true);
       m_ambientStream = stream.get();
       m_ambientStreamId = trackInfo.id.get();
@@ -187,15 +209,74 @@ void AudioEngine::playStopCdTrack(const script::ScriptEngine& scriptEngine, cons
   }
 }
 
-gsl::not_null<std::shared_ptr<audio::StreamVoice>>
-  AudioEngine::playStream(size_t trackId, const std::chrono::milliseconds& initialPosition)
+std::unique_ptr<audio::AbstractStreamSource> AudioEngine::createWadTrackSource(const size_t trackId,
+                                                                              const bool cacheDecoded)
+{
+  // larger tracks are streamed, as they would take too much memory to keep; compressed tracks decode to several times
+  // their size, so the limit applies to the decoded data
+  static constexpr size_t MaxCachedTrackSize = 16 * 1024 * 1024;
+
+  Expects(m_wadFile != nullptr);
+
+  if(const auto it = m_decodedTracks.find(trackId);
+     it != m_decodedTracks.end() && it->second.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+  {
+    try
+    {
+      if(auto pcm = it->second.get(); pcm != nullptr)
+        return std::make_unique<audio::PcmStreamSource>(gsl::not_null{std::move(pcm)});
+
+      // the entry is kept, so a track too large to be cached isn't decoded again
+      return std::make_unique<audio::WadStreamSource>(m_wadFile, trackId);
+    }
+    catch(const std::exception& ex)
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Failed to decode WAD track " << trackId << ": " << ex.what();
+      m_decodedTracks.erase(it);
+      return std::make_unique<audio::WadStreamSource>(m_wadFile, trackId);
+    }
+  }
+
+  auto source = std::make_unique<audio::WadStreamSource>(m_wadFile, trackId);
+  if(!cacheDecoded || m_decodedTracks.count(trackId) != 0)
+    return source;
+
+  const auto data = m_wadFile->getTrackData(trackId);
+  // estimated from the stream, as the size of the decoded data isn't known before decoding
+  const auto duration = std::max<int64_t>(
+    0, std::chrono::duration_cast<std::chrono::milliseconds>(source->getDuration()).count());
+  const auto estimatedSize = gsl::narrow_cast<size_t>(duration) * gsl::narrow<size_t>(source->getSampleRate())
+                             * gsl::narrow<size_t>(source->getChannels()) * sizeof(int16_t) / 1000;
+  if(estimatedSize <= MaxCachedTrackSize && isCompleteWav(data))
+  {
+    BOOST_LOG_TRIVIAL(debug) << "Decoding WAD track " << trackId << " in the background";
+    // the task keeps the mapping alive
+    auto decoded = std::async(std::launch::async,
+                              [wadFile = m_wadFile, data]() -> std::shared_ptr<const audio::PcmData>
+                              {
+                                auto pcm = audio::decodeWav(data.data());
+                                if(pcm.samples.size() * sizeof(int16_t) > MaxCachedTrackSize)
+                                  return nullptr;
+                                return std::make_shared<const audio::PcmData>(std::move(pcm));
+                              });
+    m_decodedTracks.emplace(trackId, decoded.share());
+  }
+
+  return source;
+}
+
+gsl::not_null<std::shared_ptr<audio::StreamVoice>> AudioEngine::playStream(
+  size_t trackId, const std::chrono::milliseconds& initialPosition, const bool cacheDecoded)
 {
   static constexpr size_t DefaultBufferSize = 8192;
   static constexpr size_t DefaultBufferCount = 4;
 
-  if(std::filesystem::is_regular_file(m_rootPath / "CDAUDIO.WAD"))
+  if(m_wadFile == nullptr && std::filesystem::is_regular_file(m_rootPath / "CDAUDIO.WAD"))
+    m_wadFile = std::make_shared<const audio::WadFile>(m_rootPath / "CDAUDIO.WAD");
+
+  if(m_wadFile != nullptr)
   {
-    auto stream = m_soundEngine->getDevice().createStream(audio::createWadStream(m_rootPath / "CDAUDIO.WAD", trackId),
+    auto stream = m_soundEngine->getDevice().createStream(createWadTrackSource(trackId, cacheDecoded),
                                                           DefaultBufferSize,
                                                           DefaultBufferCount,
                                                           initialPosition);
@@ -244,7 +325,7 @@ std::shared_ptr<audio::Voice> AudioEngine::playSoundEffect(const core::SoundEffe
   if(volume <= 0)
     return nullptr;
 
-  const auto& buffer = m_samples.at(sample);
+  const auto buffer = getSampleBuffer(sample);
   switch(soundEffect->getPlaybackType(loader::file::level::Engine::TR1))
   {
   case loader::file::PlaybackType::Looping:
@@ -350,9 +431,112 @@ void AudioEngine::setUnderwater(bool underwater)
 
 void AudioEngine::addWav(const gsl::not_null<const uint8_t*>& buffer)
 {
-  auto handle = std::make_shared<audio::BufferHandle>();
-  handle->fillFromWav(buffer.get());
-  m_samples.emplace_back(std::move(handle));
+  Expects(!m_sampleDecoding.valid());
+  m_samples.emplace_back(Sample{buffer});
+}
+
+void AudioEngine::preloadSamples()
+{
+  Expects(!m_sampleDecoding.valid());
+
+  std::vector<size_t> hints;
+  for(const auto& [id, soundEffect] : m_soundEffects)
+  {
+    const size_t first = soundEffect->sample.get();
+    const size_t last = std::min(first + soundEffect->getSampleCount(), m_samples.size());
+    for(size_t i = first; i < last; ++i)
+      hints.emplace_back(i);
+  }
+  std::sort(hints.begin(), hints.end());
+  hints.erase(std::unique(hints.begin(), hints.end()), hints.end());
+
+  BOOST_LOG_TRIVIAL(debug) << "Decoding " << hints.size() << " of " << m_samples.size()
+                           << " samples in the background";
+
+  m_decodedSamples.clear();
+  m_decodedSamples.resize(m_samples.size());
+  m_uploadedSamples.assign(m_samples.size(), false);
+  m_cancelSampleDecoding = false;
+  m_sampleDecodingFinished = false;
+  m_sampleDecoding = std::async(std::launch::async,
+                                [this, hints = std::move(hints)]()
+                                {
+                                  util::parallelFor(hints.size(),
+                                                    [this, &hints](const size_t i)
+                                                    {
+                                                      if(m_cancelSampleDecoding)
+                                                        return;
+
+                                                      const auto sample = hints[i];
+                                                      {
+                                                        std::lock_guard lock{m_decodedSamplesMutex};
+                                                        if(m_uploadedSamples[sample])
+                                                          return;
+                                                      }
+
+                                                      auto pcm = audio::decodeWav(m_samples[sample].wav.get());
+                                                      // the sample may have been decoded on first use meanwhile
+                                                      std::lock_guard lock{m_decodedSamplesMutex};
+                                                      if(!m_uploadedSamples[sample])
+                                                        m_decodedSamples[sample] = std::move(pcm);
+                                                    });
+                                });
+}
+
+void AudioEngine::stopSampleDecoding()
+{
+  if(!m_sampleDecoding.valid())
+    return;
+
+  m_cancelSampleDecoding = true;
+  m_sampleDecoding.wait();
+  m_sampleDecoding = {};
+  m_decodedSamples.clear();
+  m_uploadedSamples.clear();
+  m_sampleDecodingFinished = true;
+}
+
+std::optional<audio::PcmData> AudioEngine::takeDecodedSample(const size_t sample)
+{
+  // don't wait for the background decoding, decoding a single sample is faster
+  if(!m_sampleDecodingFinished && m_sampleDecoding.valid()
+     && m_sampleDecoding.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+  {
+    m_sampleDecodingFinished = true;
+    try
+    {
+      m_sampleDecoding.get();
+    }
+    catch(const std::exception& ex)
+    {
+      // samples which failed to decode are decoded again on first use, so they fail where they're used
+      BOOST_LOG_TRIVIAL(warning) << "Background decoding of samples failed: " << ex.what();
+    }
+  }
+
+  std::lock_guard lock{m_decodedSamplesMutex};
+  if(sample >= m_decodedSamples.size())
+    return std::nullopt;
+
+  // the buffer is created by the caller in any case, so a later background result must not be kept
+  m_uploadedSamples[sample] = true;
+  return std::exchange(m_decodedSamples[sample], std::nullopt);
+}
+
+gsl::not_null<std::shared_ptr<audio::BufferHandle>> AudioEngine::getSampleBuffer(const size_t sample)
+{
+  auto& entry = m_samples.at(sample);
+  if(entry.buffer != nullptr)
+    return gsl::not_null{entry.buffer};
+
+  auto buffer = std::make_shared<audio::BufferHandle>();
+  if(const auto pcm = takeDecodedSample(sample); pcm.has_value())
+    buffer->fill(*pcm);
+  else
+    buffer->fillFromWav(entry.wav.get());
+
+  entry.buffer = buffer;
+  return gsl::not_null{std::move(buffer)};
 }
 
 std::shared_ptr<audio::Voice> AudioEngine::playSoundEffect(const core::SoundEffectId& id, const glm::vec3& pos)
@@ -395,7 +579,7 @@ void AudioEngine::serialize(const serialization::Serializer<world::World>& ser)
 
     if(m_ambientStreamId.has_value())
     {
-      const auto stream = playStream(*m_ambientStreamId, ambientPosition);
+      const auto stream = playStream(*m_ambientStreamId, ambientPosition, true);
       stream->setLooping(true);
       m_ambientStream = stream.get();
     }
@@ -418,6 +602,11 @@ AudioEngine::AudioEngine(world::World& world,
 {
 }
 
+AudioEngine::~AudioEngine()
+{
+  stopSampleDecoding();
+}
+
 void AudioEngine::init(const std::vector<loader::file::SoundEffectProperties>& soundEffectProperties,
                        const std::vector<int16_t>& soundEffects)
 {
@@ -1,14 +1,18 @@
 #pragma once
 
+#include "audio/bufferhandle.h"
 #include "audio/voicegroup.h"
 #include "core/id.h"
 #include "floordata/floordata.h"
 #include "loader/file/audio.h"
 #include "soundeffects_tr1.h"
 
+#include <atomic>
 #include <boost/container/flat_map.hpp>
 #include <filesystem>
+#include <future>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -24,12 +28,14 @@ class ScriptEngine;
 
 namespace audio
 {
+class AbstractStreamSource;
 class SoundEngine;
 class SourceHandle;
 class BufferHandle;
 class Voice;
 class StreamVoice;
 class Emitter;
+class WadFile;
 } // namespace audio
 
 namespace engine
@@ -52,7 +58,27 @@ class AudioEngine
   std::weak_ptr<audio::StreamVoice> m_interceptStream;
   std::optional<size_t> m_interceptStreamId{};
   std::optional<TR1TrackId> m_currentTrack;
-  std::vector<gsl::not_null<std::shared_ptr<audio::BufferHandle>>> m_samples;
+
+  struct Sample
+  {
+    gsl::not_null<const uint8_t*> wav;
+    //! created on the first use of the sample
+    std::shared_ptr<audio::BufferHandle> buffer{};
+  };
+
+  std::vector<Sample> m_samples;
+  //! samples decoded in the background by preloadSamples(), released when they're uploaded
+  std::vector<std::optional<audio::PcmData>> m_decodedSamples;
+  //! samples which already have a buffer, so the background decoding doesn't keep their data
+  std::vector<bool> m_uploadedSamples;
+  //! guards the slots of m_decodedSamples and m_uploadedSamples while the background decoding runs
+  std::mutex m_decodedSamplesMutex;
+  std::future<void> m_sampleDecoding;
+  std::atomic<bool> m_cancelSampleDecoding{false};
+  bool m_sampleDecodingFinished = false;
+  std::shared_ptr<const audio::WadFile> m_wadFile;
+  //! short looping tracks decoded in the background when they're played the first time
+  std::map<size_t, std::shared_future<std::shared_ptr<const audio::PcmData>>> m_decodedTracks;
   audio::VoiceGroup m_music{0.8f};
   audio::VoiceGroup m_sfx{0.8f};
 
@@ -60,6 +86,7 @@ public:
   explicit AudioEngine(world::World& world,
                        std::filesystem::path rootPath,
                        std::shared_ptr<audio::SoundEngine> soundEngine);
+  ~AudioEngine();
 
   void init(const std::vector<loader::file::SoundEffectProperties>& soundEffectProperties,
             const std::vector<int16_t>& soundEffects);
@@ -67,8 +94,11 @@ public:
   std::shared_ptr<audio::Voice> playSoundEffect(const core::SoundEffectId& id, audio::Emitter* emitter);
   std::shared_ptr<audio::Voice> playSoundEffect(const core::SoundEffectId& id, const glm::vec3& pos);
 
+  //! if cacheDecoded is set, short tracks are decoded once and played from memory afterwards
   gsl::not_null<std::shared_ptr<audio::StreamVoice>>
-    playStream(size_t trackId, const std::chrono::milliseconds& initialPosition = std::chrono::milliseconds{0});
+    playStream(size_t trackId,
+               const std::chrono::milliseconds& initialPosition = std::chrono::milliseconds{0},
+               bool cacheDecoded = false);
 
   void playStopCdTrack(const script::ScriptEngine& scriptEngine, TR1TrackId trackId, bool stop);
 
@@ -86,7 +116,11 @@ public:
 
   void setUnderwater(bool underwater);
 
+  //! registers a sample without decoding it; the data must stay valid until stopSampleDecoding() was called
   void addWav(const gsl::not_null<const uint8_t*>& buffer);
+  //! starts decoding the samples referenced by the sound effects in the background
+  void preloadSamples();
+  void stopSampleDecoding();
 
   void setMusicGain(float gain)
   {
@@ -135,5 +169,10 @@ public:
   }
 
   void serialize(const serialization::Serializer<world::World>& ser);
+
+private:
+  [[nodiscard]] gsl::not_null<std::shared_ptr<audio::BufferHandle>> getSampleBuffer(size_t sample);
+  [[nodiscard]] std::optional<audio::PcmData> takeDecodedSample(size_t sample);
+  [[nodiscard]] std::unique_ptr<audio::AbstractStreamSource> createWadTrackSource(size_t trackId, bool cacheDecoded);
 };
 } // namespace engine
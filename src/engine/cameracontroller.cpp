@@ -421,7 +421,7 @@ std::unordered_set<const world::Portal*> CameraController::update()
       m_cinematicFrame = m_world->getCinematicFrames().size() - 1;
     }
 
-    updateCinematic(m_world->getCinematicFrames()[m_cinematicFrame], true);
+    updateCinematic(true);
     return tracePortals();
   }
 
@@ -757,25 +757,35 @@ void CameraController::handleEnemy(objects::Object& object)
   updatePosition(eye, m_smoothness);
 }
 
-std::unordered_set<const world::Portal*> CameraController::updateCinematic(const world::CinematicFrame& frame,
-                                                                           const bool ingame)
+void CameraController::precomputeCinematic(const core::TRVec& base, const core::Angle& rotation)
+{
+  if(!m_cinematicCameraFrames.empty() && m_cinematicCameraBase == base && m_cinematicCameraRotation == rotation)
+    return;
+
+  m_cinematicCameraBase = base;
+  m_cinematicCameraRotation = rotation;
+  m_cinematicCameraFrames = world::computeCinematicCameraFrames(m_world->getCinematicFrames(), base, rotation);
+}
+
+const std::unordered_set<const world::Portal*>& CameraController::updateCinematic(const bool ingame)
 {
   const core::TRVec basePos = ingame ? m_cinematicPos : m_location.position;
   const auto yRotOffset = ingame ? m_cinematicRot.Y : 0_deg;
-  const core::TRVec newLookAt = basePos + util::pitch(frame.lookAt, m_eyeRotation.Y + yRotOffset);
-  const core::TRVec newPos = basePos + util::pitch(frame.position, m_eyeRotation.Y + yRotOffset);
+  precomputeCinematic(basePos, m_eyeRotation.Y + yRotOffset);
 
+  const auto& cameraFrame = m_cinematicCameraFrames.at(m_cinematicFrame);
   if(ingame)
   {
-    m_lookAt.position = newLookAt;
-    m_location.position = newPos;
+    m_lookAt.position = cameraFrame.lookAt;
+    m_location.position = cameraFrame.position;
     m_location.updateRoom();
   }
 
-  auto m = lookAt(newPos.toRenderSystem(), newLookAt.toRenderSystem(), {0, 1, 0});
-  m = rotate(m, frame.rotZ, -glm::vec3{m[2]});
-  m_camera->setViewMatrix(m);
-  m_camera->setFieldOfView(frame.fov);
+  m_camera->setViewMatrix(cameraFrame.viewMatrix);
+  m_camera->setFieldOfView(m_world->getCinematicFrames()[m_cinematicFrame].fov);
+
+  if(m_cinematicWaterEntryPortals.has_value() && m_cinematicWaterEntryPortals->first == m_world->roomsAreSwapped())
+    return m_cinematicWaterEntryPortals->second;
 
   // portal tracing doesn't work here because we always render each room.
   // assuming "sane" room layout here without overlapping rooms.
@@ -791,7 +801,8 @@ std::unordered_set<const world::Portal*> CameraController::updateCinematic(const
         result.emplace(&portal);
     }
   }
-  return result;
+  m_cinematicWaterEntryPortals = std::pair{m_world->roomsAreSwapped(), std::move(result)};
+  return m_cinematicWaterEntryPortals->second;
 }
 
 CameraController::CameraController(const gsl::not_null<world::World*>& world,
@@ -9,13 +9,16 @@
 #include "location.h"
 #include "qs/quantity.h"
 #include "serialization/serialization_fwd.h"
+#include "world/cinematicframe.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <glm/fwd.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
+#include <optional>
 #include <unordered_set>
+#include <vector>
 
 // IWYU pragma: no_forward_declare serialization::Serializer
 
@@ -28,7 +31,6 @@ namespace engine::world
 {
 class World;
 struct Portal;
-struct CinematicFrame;
 } // namespace engine::world
 
 namespace engine
@@ -97,6 +99,16 @@ private:
   std::shared_ptr<objects::Object> m_lookAtObject = nullptr;
   std::shared_ptr<objects::Object> m_previousLookAtObject = nullptr;
   std::shared_ptr<objects::Object> m_enemy = nullptr;
+
+  //! @brief Camera transforms of all cinematic frames, computed on first play for the given base position and rotation.
+  //! @{
+  std::vector<world::CinematicCameraFrame> m_cinematicCameraFrames;
+  core::TRVec m_cinematicCameraBase{};
+  core::Angle m_cinematicCameraRotation{};
+  //! @}
+
+  //! @brief Water entry portals of cinematics, which render all rooms; only changes when the rooms are swapped.
+  std::optional<std::pair<bool, std::unordered_set<const world::Portal*>>> m_cinematicWaterEntryPortals;
   //! @brief Movement smoothness for adjusting the pivot position.
   int m_smoothness = 8;
   int m_fixedCameraId = -1;
@@ -210,7 +222,8 @@ public:
     return m_camera;
   }
 
-  std::unordered_set<const world::Portal*> updateCinematic(const world::CinematicFrame& frame, bool ingame);
+  //! @brief Moves the camera to the current cinematic frame.
+  const std::unordered_set<const world::Portal*>& updateCinematic(bool ingame);
 
   void serialize(const serialization::Serializer<world::World>& ser);
 
@@ -221,6 +234,8 @@ public:
 private:
   std::unordered_set<const world::Portal*> tracePortals();
 
+  void precomputeCinematic(const core::TRVec& base, const core::Angle& rotation);
+
   void handleFixedCamera();
 
   core::Length moveIntoBox(Location& goal, const core::Length& margin) const;
@@ -14,6 +14,7 @@
 #include "engine/world/room.h"
 #include "hid/actions.h"
 #include "hid/inputhandler.h"
+#include "interpolatedframes.h"
 #include "loader/trx/trx.h"
 #include "menu/menudisplay.h"
 #include "objects/laraobject.h"
@@ -25,6 +26,7 @@
 #include "render/scene/mesh.h"
 #include "render/scene/rendercontext.h"
 #include "render/scene/rendermode.h"
+#include "replay.h"
 #include "script/reflection.h"
 #include "script/scriptengine.h"
 #include "serialization/serialization.h"
@@ -33,6 +35,7 @@
 #include "ui/levelstats.h"
 #include "ui/ui.h"
 #include "util/helpers.h"
+#include "util/md5.h"
 #include "world/world.h"
 
 #include <algorithm>
@@ -44,6 +47,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <ctime>
 #include <exception>
 #include <filesystem>
@@ -141,6 +145,8 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
   applySettings();
   std::shared_ptr<menu::MenuDisplay> menu;
   Throttler throttler;
+  // only the gameplay loop's pacing is of interest, the menus are mostly idle
+  const auto throttlerStatsLogger = gsl::finally([&throttler]() { throttler.logStats(); });
   core::Frame laraDeadTime = 0_frame;
 
   std::optional<std::chrono::high_resolution_clock::time_point> gameSessionStart;
@@ -154,6 +160,43 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
     }
   };
 
+  // replays are controlled through the environment, so soak tests and performance regressions can run unattended
+  std::unique_ptr<Replay> replayPlayback;
+  std::unique_ptr<Replay> replayRecording;
+  std::optional<std::filesystem::path> replayRecordingPath;
+  if(!isCutscene)
+  {
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    if(const char* const playbackPath = std::getenv("EDISONENGINE_PLAY_REPLAY"); playbackPath != nullptr)
+    {
+      replayPlayback = std::make_unique<Replay>(std::filesystem::path{playbackPath});
+      replayPlayback->rewind(world);
+      // NOLINTNEXTLINE(concurrency-mt-unsafe)
+      if(const char* const seekFrame = std::getenv("EDISONENGINE_REPLAY_SEEK"); seekFrame != nullptr)
+        replayPlayback->seek(world, std::stoul(seekFrame), godMode);
+    }
+    // NOLINTNEXTLINE(concurrency-mt-unsafe)
+    else if(const char* const recordingPath = std::getenv("EDISONENGINE_RECORD_REPLAY"); recordingPath != nullptr)
+    {
+      // e.g. "session.replay" becomes "session-003-LEVEL2.replay"
+      std::filesystem::path path{recordingPath};
+      path.replace_filename((boost::format("%s-%03d-%s%s") % path.stem().string() % ++m_recordedReplays
+                             % world.getLevelFilename().stem().string() % path.extension().string())
+                              .str());
+      replayRecordingPath = path;
+    }
+  }
+  const auto replayWriter = gsl::finally(
+    [&replayRecording, &replayRecordingPath]()
+    {
+      if(replayRecording != nullptr)
+        replayRecording->write(replayRecordingPath.value());
+    });
+
+  // cutscenes are short and mostly idle, so the next level is loaded right away
+  if(isCutscene && m_nextLevelSequenceItem != nullptr)
+    m_nextLevelSequenceItem->preload(*this);
+
   core::Frame runtime = 0_frame;
   static constexpr core::Frame BlendInDuration = 60_frame;
   while(true)
@@ -166,6 +209,8 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
     if(world.levelFinished())
     {
       updateTimeSpent();
+      if(m_nextLevelSequenceItem != nullptr)
+        m_nextLevelSequenceItem->preload(*this);
 
       if(!isCutscene && allowSave)
       {
@@ -193,7 +238,8 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
                                    world.getRooms(),
                                    world.getCameraController(),
                                    world.getCameraController().update(),
-                                   throttler.getAverageWaitRatio());
+                                   throttler.getAverageWaitRatio(),
+                                   [&world]() { world.renderParticlePool(); });
           m_presenter->renderScreenOverlay();
 
           if(currentBlendDuration < BlendDuration)
@@ -212,6 +258,7 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
     }
 
     throttler.wait();
+    m_presenter->setFramePacingStats(throttler.getStats());
     if(!m_presenter->preFrame())
     {
       updateTimeSpent();
@@ -227,7 +274,8 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
                                world.getRooms(),
                                world.getCameraController(),
                                world.getCameraController().update(),
-                               throttler.getAverageWaitRatio());
+                               throttler.getAverageWaitRatio(),
+                               [&world]() { world.renderParticlePool(); });
       m_presenter->updateSoundEngine();
       m_presenter->renderScreenOverlay();
       ui::Ui ui{m_presenter->getMaterialManager()->getUi(), world.getPalette()};
@@ -243,6 +291,8 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
       case menu::MenuResult::Closed:
         menu.reset();
         throttler.reset();
+        if(replayRecording != nullptr)
+          replayRecording->addRestorePoint(world);
         break;
       case menu::MenuResult::ExitToTitle: return {RunResult::TitleLevel, std::nullopt};
       case menu::MenuResult::ExitGame: return {RunResult::ExitApp, std::nullopt};
@@ -321,14 +371,62 @@ std::pair<RunResult, std::optional<size_t>> Engine::run(world::World& world, boo
         runtime += 1_frame;
         blackAlpha = 1 - runtime.cast<float>() / BlendInDuration.cast<float>();
       }
-      world.gameLoop(godMode, throttler.getAverageWaitRatio(), blackAlpha);
+      if(replayPlayback != nullptr)
+      {
+        if(replayPlayback->isFinished())
+        {
+          BOOST_LOG_TRIVIAL(info) << "Replay finished after " << replayPlayback->size() << " frames";
+          updateTimeSpent();
+          return {RunResult::ExitApp, std::nullopt};
+        }
+
+        // the replayed input only drives the simulation, menus and hotkeys still use the live input
+        auto& inputHandler = m_presenter->getInputHandler();
+        const auto liveState = inputHandler.getInputState();
+        inputHandler.setInputState(replayPlayback->playFrame(world));
+        world.gameLoop(godMode, throttler.getAverageWaitRatio(), blackAlpha);
+        inputHandler.setInputState(liveState);
+      }
+      else
+      {
+        if(replayRecordingPath.has_value())
+        {
+          if(replayRecording == nullptr)
+            replayRecording = std::make_unique<Replay>(world);
+          replayRecording->record(m_presenter->getInputHandler().getInputState());
+        }
+        world.gameLoop(godMode, throttler.getAverageWaitRatio(), blackAlpha);
+      }
     }
     else
     {
-      if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Menu) || !world.cinematicLoop())
+      if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Menu)
+         || !world.cinematicLoop(throttler.getAverageWaitRatio()))
         return {RunResult::NextLevel, std::nullopt};
     }
 
+    if(m_engineConfig->renderSettings.renderInterpolation)
+    {
+      // present interpolated frames until the next tick, at most at the refresh rate of the display
+      throttler.endWork();
+      static constexpr int FallbackRefreshRate = 60;
+      const auto refreshRate = m_presenter->getRefreshRate();
+      const auto minFrameInterval = static_cast<float>(core::FrameRate.get())
+                                    / static_cast<float>(refreshRate > 0 ? refreshRate : FallbackRefreshRate);
+      renderInterpolatedFrames(
+        minFrameInterval,
+        [&throttler]() { return throttler.getFrameProgress(); },
+        [&throttler](const float progress) { throttler.waitForProgress(progress); },
+        [this, &world, &throttler](const float progress)
+        {
+          if(m_presenter->shouldClose() || !m_presenter->preInterpolatedFrame())
+            return false;
+
+          world.renderInterpolatedFrame(progress, throttler.getAverageWaitRatio());
+          return true;
+        });
+    }
+
     if(m_presenter->getInputHandler().hasDebouncedAction(hid::Action::Screenshot))
     {
       updateTimeSpent();
@@ -470,8 +568,12 @@ std::unique_ptr<loader::trx::Glidos> Engine::loadGlidosPack() const
       return nullptr;
 
     m_presenter->drawLoadingScreen(_("Loading Glidos texture pack"));
-    return std::make_unique<loader::trx::Glidos>(m_userDataPath / m_engineConfig->renderSettings.glidosPack.value(),
-                                                 [this](const std::string& s) { m_presenter->drawLoadingScreen(s); });
+    const auto baseDir = m_userDataPath / m_engineConfig->renderSettings.glidosPack.value();
+    const auto baseDirStr = baseDir.string();
+    return std::make_unique<loader::trx::Glidos>(
+      baseDir,
+      m_userDataPath / "cooked" / (util::md5(baseDirStr.data(), baseDirStr.size()) + ".glidos"),
+      [this](const std::string& s) { m_presenter->drawLoadingScreen(s); });
   }
 
   return nullptr;
@@ -501,8 +603,6 @@ void Engine::applySettings()
   {
     world->getAudioEngine().setMusicGain(m_engineConfig->audioSettings.musicVolume);
     world->getAudioEngine().setSfxGain(m_engineConfig->audioSettings.sfxVolume);
-    for(auto& room : world->getRooms())
-      room.collectShaderLights(m_engineConfig->renderSettings.getLightCollectionDepth());
   }
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "levelpreloader.h"
 #include "script/scriptengine.h"
 #include "serialization/serialization_fwd.h"
 
@@ -78,6 +79,10 @@ private:
   std::string m_locale;
 
   std::unique_ptr<loader::trx::Glidos> m_glidos;
+  LevelPreloader m_levelPreloader;
+  script::LevelSequenceItem* m_nextLevelSequenceItem = nullptr;
+  //! numbers the recorded replays, so recording multiple levels doesn't overwrite the previous ones
+  size_t m_recordedReplays = 0;
   [[nodiscard]] std::unique_ptr<loader::trx::Glidos> loadGlidosPack() const;
 
   void makeScreenshot();
@@ -135,6 +140,17 @@ public:
                                                                            const std::optional<size_t>& slot,
                                                                            const std::shared_ptr<Player>& player);
 
+  //! the item expected to run after the current one; it is preloaded while the current level ends
+  void setNextLevelSequenceItem(script::LevelSequenceItem* item)
+  {
+    m_nextLevelSequenceItem = item;
+  }
+
+  [[nodiscard]] auto& getLevelPreloader()
+  {
+    return m_levelPreloader;
+  }
+
   [[nodiscard]] const auto& getGlidos() const noexcept
   {
     return m_glidos;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+namespace engine
+{
+// schedules the frames rendered between two simulation ticks. progress is the share of the tick that has passed, a
+// frame is only started if it is expected to finish before the next tick, and frames are at least minFrameInterval
+// apart, so they don't run uncapped if swapping buffers doesn't wait for the display.
+//! @param getProgress returns the current progress
+//! @param waitUntil blocks until the given progress is reached
+//! @param renderFrame renders a frame at the given progress; returning false stops rendering until the next tick
+//! @returns the number of frames rendered
+template<typename GetProgress, typename WaitUntil, typename RenderFrame>
+size_t renderInterpolatedFrames(const float minFrameInterval,
+                                const GetProgress& getProgress,
+                                const WaitUntil& waitUntil,
+                                const RenderFrame& renderFrame)
+{
+  // the frame of the tick itself has just been presented
+  float nextFrame = getProgress() + minFrameInterval;
+  float lastFrameCost = 0;
+  size_t frames = 0;
+  while(true)
+  {
+    auto progress = getProgress();
+    if(progress < nextFrame)
+    {
+      if(nextFrame + lastFrameCost >= 1)
+        break;
+
+      waitUntil(nextFrame);
+      progress = getProgress();
+    }
+
+    if(progress + lastFrameCost >= 1 || !renderFrame(progress))
+      break;
+
+    ++frames;
+    lastFrameCost = getProgress() - progress;
+    nextFrame = progress + minFrameInterval;
+  }
+  return frames;
+}
+} // namespace engine
@@ -2,11 +2,10 @@
 
 #include "abstractstatehandler.h"
 #include "engine/collisioninfo.h"
-#include "engine/particle.h"
+#include "engine/objectmanager.h"
+#include "engine/particlepool.h"
 #include "engine/world/skeletalmodeltype.h"
 
-#include <gslu.h>
-
 namespace engine::lara
 {
 class StateHandler_50 final : public AbstractStateHandler
@@ -50,9 +49,8 @@ public:
       p.X += util::rand15s(r);
       p.Y += util::rand15s(r);
       p.Z += util::rand15s(r);
-      auto fx = gslu::make_nn_shared<SparkleParticle>(
-        Location{world.getObjectManager().getLara().m_state.location.room, p}, world);
-      world.getObjectManager().registerParticle(fx);
+      world.getObjectManager().getParticlePool().emitSparkle(
+        world, Location{world.getObjectManager().getLara().m_state.location.room, p});
     }
   }
 };
@@ -0,0 +1,65 @@
+#include "levelpreloader.h"
+
+#include "loader/file/level/level.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace engine
+{
+LevelPreloader::~LevelPreloader()
+{
+  discard();
+  for(const auto& level : m_discarded)
+    level.wait();
+}
+
+void LevelPreloader::preload(const std::filesystem::path& filename)
+{
+  if(m_filename == filename)
+    return;
+
+  discard();
+  BOOST_LOG_TRIVIAL(info) << "Preloading " << filename;
+  m_filename = filename;
+  m_level = std::async(std::launch::async, [filename]() { return loader::file::level::Level::load(filename); });
+}
+
+std::unique_ptr<loader::file::level::Level> LevelPreloader::take(const std::filesystem::path& filename)
+{
+  if(m_filename != filename)
+  {
+    discard();
+    return nullptr;
+  }
+
+  m_filename.reset();
+  try
+  {
+    return m_level.get();
+  }
+  catch(const std::exception& ex)
+  {
+    // loading again on the calling thread reports the error where it is expected
+    BOOST_LOG_TRIVIAL(warning) << "Preloading " << filename << " failed: " << ex.what();
+    return nullptr;
+  }
+}
+
+void LevelPreloader::discard()
+{
+  // the parsers can't be interrupted, so an abandoned level is parsed to the end in the background, and the result is
+  // dropped once it's ready; destroying the future would block until then
+  if(m_level.valid())
+    m_discarded.emplace_back(std::move(m_level));
+  m_level = {};
+  m_filename.reset();
+
+  const auto isReady = [](const auto& level)
+  { return level.wait_for(std::chrono::seconds::zero()) == std::future_status::ready; };
+  m_discarded.erase(std::remove_if(m_discarded.begin(), m_discarded.end(), isReady), m_discarded.end());
+}
+} // namespace engine
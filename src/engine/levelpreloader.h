@@ -0,0 +1,43 @@
+#pragma once
+
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace loader::file::level
+{
+class Level;
+}
+
+namespace engine
+{
+// parses a level file on a worker thread while the current level is still shown, e.g. during the level statistics,
+// so only the conversion into a world and the GL uploads are left when the level is started
+class LevelPreloader final
+{
+public:
+  LevelPreloader() = default;
+  LevelPreloader(const LevelPreloader&) = delete;
+  LevelPreloader(LevelPreloader&&) = delete;
+  LevelPreloader& operator=(const LevelPreloader&) = delete;
+  LevelPreloader& operator=(LevelPreloader&&) = delete;
+  ~LevelPreloader();
+
+  //! starts parsing the level unless it is already being preloaded; a different pending level is discarded
+  void preload(const std::filesystem::path& filename);
+
+  //! waits for the preloaded level if it matches the filename, otherwise returns nullptr and discards the preloaded
+  //! level without waiting for it
+  [[nodiscard]] std::unique_ptr<loader::file::level::Level> take(const std::filesystem::path& filename);
+
+private:
+  void discard();
+
+  std::optional<std::filesystem::path> m_filename;
+  std::future<std::unique_ptr<loader::file::level::Level>> m_level;
+  //! levels which are no longer needed, but still being parsed; only the destructor waits for them
+  std::vector<std::future<std::unique_ptr<loader::file::level::Level>>> m_discarded;
+};
+} // namespace engine
@@ -0,0 +1,153 @@
+#include "lightclusters.h"
+
+#include "engine/world/room.h"
+#include "render/scene/camera.h"
+#include "render/scene/node.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gl/api/gl.hpp>
+#include <glm/common.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <limits>
+#include <set>
+#include <utility>
+
+namespace engine
+{
+namespace
+{
+// lights contributing less than this are not assigned to a cluster; the falloff brightness / (1 + (d/fade)^2) never
+// reaches zero, so this defines the light radius
+constexpr float MinIntensity = 1.0f / 64.0f;
+
+uint32_t getSlice(const float z, const float nearPlane, const float farPlane)
+{
+  const auto slice = std::log(std::max(z, nearPlane) / nearPlane) / std::log(farPlane / nearPlane)
+                     * static_cast<float>(LightClusters::Slices);
+  return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(LightClusters::Slices - 1)));
+}
+
+uint32_t getTile(const float ndc, const uint32_t tiles)
+{
+  const auto tile = (ndc * 0.5f + 0.5f) * static_cast<float>(tiles);
+  return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(tiles - 1)));
+}
+} // namespace
+
+LightClusters::LightClusters()
+    : m_clusterLights(ClusterCount)
+    , m_clusters(ClusterCount, glm::uvec2{0, 0})
+{
+  m_clustersBuffer->setData(m_clusters, gl::api::BufferUsage::StreamDraw);
+  m_indicesBuffer->setData(std::vector<uint32_t>{0}, gl::api::BufferUsage::StreamDraw);
+}
+
+void LightClusters::update(const std::vector<world::Room>& rooms,
+                           const size_t depth,
+                           const render::scene::Camera& camera)
+{
+  std::set<const world::Room*> lightRooms;
+  for(const auto& room : rooms)
+  {
+    if(room.node != nullptr && room.node->isVisible())
+      lightRooms.emplace(&room);
+  }
+  for(size_t i = 1; i < depth; ++i)
+  {
+    auto newLightRooms = lightRooms;
+    for(const auto& room : lightRooms)
+    {
+      for(const auto& portal : room->portals)
+        newLightRooms.emplace(portal.adjoiningRoom);
+    }
+    lightRooms = std::move(newLightRooms);
+  }
+
+  m_lights.clear();
+  for(const auto& room : lightRooms)
+  {
+    for(const auto& light : room->lights)
+    {
+      if(light.intensity.get() <= 0)
+        continue;
+      m_lights.emplace_back(ShaderLight{glm::vec4{light.position.toRenderSystem(), 0.0f},
+                                        toBrightness(light.intensity).get(),
+                                        light.fadeDistance.get<float>()});
+    }
+  }
+
+  for(auto& clusterLights : m_clusterLights)
+    clusterLights.clear();
+  for(size_t i = 0; i < m_lights.size(); ++i)
+    assign(gsl::narrow<uint32_t>(i), m_lights[i], camera);
+
+  m_indices.clear();
+  for(size_t i = 0; i < ClusterCount; ++i)
+  {
+    m_clusters[i]
+      = glm::uvec2{gsl::narrow<uint32_t>(m_indices.size()), gsl::narrow<uint32_t>(m_clusterLights[i].size())};
+    m_indices.insert(m_indices.end(), m_clusterLights[i].begin(), m_clusterLights[i].end());
+  }
+  if(m_indices.empty())
+    m_indices.emplace_back(0);
+
+  m_lightsBuffer->setData(m_lights, gl::api::BufferUsage::StreamDraw);
+  m_clustersBuffer->setData(m_clusters, gl::api::BufferUsage::StreamDraw);
+  m_indicesBuffer->setData(m_indices, gl::api::BufferUsage::StreamDraw);
+}
+
+void LightClusters::assign(const uint32_t lightIndex, const ShaderLight& light, const render::scene::Camera& camera)
+{
+  if(light.brightness <= MinIntensity)
+    return;
+
+  const auto radius = light.fadeDistance * std::sqrt(light.brightness / MinIntensity - 1);
+  const glm::vec3 center{camera.getViewMatrix() * glm::vec4{glm::vec3{light.position}, 1.0f}};
+
+  // the camera looks along -z
+  const auto zMin = -center.z - radius;
+  const auto zMax = -center.z + radius;
+  if(zMax < camera.getNearPlane() || zMin > camera.getFarPlane())
+    return;
+
+  glm::vec2 ndcMin{-1.0f};
+  glm::vec2 ndcMax{1.0f};
+  if(zMin > camera.getNearPlane())
+  {
+    // bounds of the projected view space box around the light, which lies completely in front of the camera
+    ndcMin = glm::vec2{std::numeric_limits<float>::max()};
+    ndcMax = glm::vec2{std::numeric_limits<float>::lowest()};
+    for(int i = 0; i < 8; ++i)
+    {
+      const glm::vec3 corner{center.x + ((i & 1) != 0 ? radius : -radius),
+                             center.y + ((i & 2) != 0 ? radius : -radius),
+                             center.z + ((i & 4) != 0 ? radius : -radius)};
+      const auto clip = camera.getProjectionMatrix() * glm::vec4{corner, 1.0f};
+      const glm::vec2 ndc{glm::vec2{clip} / clip.w};
+      ndcMin = glm::min(ndcMin, ndc);
+      ndcMax = glm::max(ndcMax, ndc);
+    }
+
+    if(ndcMax.x < -1 || ndcMax.y < -1 || ndcMin.x > 1 || ndcMin.y > 1)
+      return;
+  }
+
+  const auto x0 = getTile(ndcMin.x, TilesX);
+  const auto x1 = getTile(ndcMax.x, TilesX);
+  const auto y0 = getTile(ndcMin.y, TilesY);
+  const auto y1 = getTile(ndcMax.y, TilesY);
+  const auto z0 = getSlice(zMin, camera.getNearPlane(), camera.getFarPlane());
+  const auto z1 = getSlice(zMax, camera.getNearPlane(), camera.getFarPlane());
+  for(auto z = z0; z <= z1; ++z)
+  {
+    for(auto y = y0; y <= y1; ++y)
+    {
+      for(auto x = x0; x <= x1; ++x)
+        m_clusterLights[(z * TilesY + y) * TilesX + x].emplace_back(lightIndex);
+    }
+  }
+}
+} // namespace engine
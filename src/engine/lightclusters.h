@@ -0,0 +1,72 @@
+#pragma once
+
+#include "lighting.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <gl/buffer.h>
+#include <glm/vec2.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <memory>
+#include <vector>
+
+namespace render::scene
+{
+class Camera;
+}
+
+namespace engine::world
+{
+struct Room;
+}
+
+namespace engine
+{
+// assigns the lights around the visible rooms to view space clusters (screen tiles times exponential depth slices),
+// so lighting.glsl only evaluates the lights reaching the cluster of a fragment
+class LightClusters
+{
+public:
+  // must match the constants in lighting.glsl
+  static constexpr uint32_t TilesX = 16;
+  static constexpr uint32_t TilesY = 9;
+  static constexpr uint32_t Slices = 24;
+  static constexpr uint32_t ClusterCount = TilesX * TilesY * Slices;
+
+  LightClusters();
+
+  // collects the lights of the visible rooms and the rooms up to depth - 1 portals away from them
+  void update(const std::vector<world::Room>& rooms, size_t depth, const render::scene::Camera& camera);
+
+  [[nodiscard]] const auto& getLightsBuffer() const
+  {
+    return m_lightsBuffer;
+  }
+
+  [[nodiscard]] const auto& getClustersBuffer() const
+  {
+    return m_clustersBuffer;
+  }
+
+  [[nodiscard]] const auto& getIndicesBuffer() const
+  {
+    return m_indicesBuffer;
+  }
+
+private:
+  void assign(uint32_t lightIndex, const ShaderLight& light, const render::scene::Camera& camera);
+
+  std::vector<ShaderLight> m_lights;
+  std::vector<std::vector<uint32_t>> m_clusterLights;
+  std::vector<glm::uvec2> m_clusters;
+  std::vector<uint32_t> m_indices;
+
+  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<ShaderLight>>> m_lightsBuffer{
+    gslu::make_nn_shared<gl::ShaderStorageBuffer<ShaderLight>>("clustered-lights")};
+  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<glm::uvec2>>> m_clustersBuffer{
+    gslu::make_nn_shared<gl::ShaderStorageBuffer<glm::uvec2>>("light-clusters")};
+  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<uint32_t>>> m_indicesBuffer{
+    gslu::make_nn_shared<gl::ShaderStorageBuffer<uint32_t>>("light-indices")};
+};
+} // namespace engine
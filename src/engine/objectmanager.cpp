@@ -7,6 +7,7 @@
 #include "loader/file/item.h"
 #include "location.h"
 #include "objects/laraobject.h"
+#include "objects/modelobject.h"
 #include "objects/object.h"
 #include "objects/objectfactory.h"
 #include "objects/objectstate.h"
@@ -47,6 +48,7 @@ void ObjectManager::createObjects(world::World& world, std::vector<loader::file:
     if(object != nullptr)
     {
       m_objects.emplace(gsl::narrow<ObjectId>(idItem.index()), object);
+      addToRegistries(gsl::not_null{object});
     }
   }
 }
@@ -58,6 +60,8 @@ void ObjectManager::applyScheduledDeletions()
 
   for(const auto& del : m_scheduledDeletions)
   {
+    removeFromRegistries(del);
+
     auto it = std::find_if(m_dynamicObjects.begin(),
                            m_dynamicObjects.end(),
                            [del](const std::shared_ptr<objects::Object>& i) { return i.get() == del; });
@@ -87,6 +91,40 @@ void ObjectManager::registerObject(const gsl::not_null<std::shared_ptr<objects::
     BOOST_THROW_EXCEPTION(std::runtime_error("Artificial object counter exceeded"));
 
   m_objects.emplace(m_objectCounter++, object);
+  addToRegistries(object);
+}
+
+void ObjectManager::addToRegistries(const gsl::not_null<std::shared_ptr<objects::Object>>& object)
+{
+  if(object.get() != m_lara)
+  {
+    if(auto modelObject = std::dynamic_pointer_cast<objects::ModelObject>(object.get()))
+      m_targetCandidates.emplace_back(std::move(modelObject));
+  }
+
+  m_roomObjects.insert(object.get().get(), object->m_state.location.room.get());
+}
+
+void ObjectManager::removeFromRegistries(const objects::Object* object)
+{
+  const auto candidateIt = std::find_if(m_targetCandidates.begin(),
+                                        m_targetCandidates.end(),
+                                        [object](const auto& candidate) { return candidate.get().get() == object; });
+  if(candidateIt != m_targetCandidates.end())
+    m_targetCandidates.erase(candidateIt);
+
+  m_roomObjects.erase(object);
+}
+
+void ObjectManager::rebuildRegistries()
+{
+  m_targetCandidates.clear();
+  m_roomObjects.clear();
+  for(const auto& object : m_objects | boost::adaptors::map_values)
+    addToRegistries(object);
+  for(const auto& object : m_dynamicObjects)
+    addToRegistries(object);
+  m_registriesDirty = false;
 }
 
 std::shared_ptr<objects::Object> ObjectManager::find(const objects::Object* object) const
@@ -116,6 +154,9 @@ std::shared_ptr<objects::Object> ObjectManager::getObject(ObjectId id) const
 
 void ObjectManager::update(world::World& world, bool godMode)
 {
+  if(m_registriesDirty)
+    rebuildRegistries();
+
   for(const auto& object : m_objects | boost::adaptors::map_values)
   {
     if(object.get() == m_lara) // Lara is special and needs to be updated last
@@ -124,6 +165,7 @@ void ObjectManager::update(world::World& world, bool godMode)
     if(object->m_isActive)
       object->update();
 
+    m_roomObjects.update(object.get().get(), object->m_state.location.room.get());
     object->updateLighting();
     object->getNode()->setVisible(object->m_state.triggerState != objects::TriggerState::Invisible);
   }
@@ -133,6 +175,7 @@ void ObjectManager::update(world::World& world, bool godMode)
     if(object->m_isActive)
       object->update();
 
+    m_roomObjects.update(object.get().get(), object->m_state.location.room.get());
     object->updateLighting();
     object->getNode()->setVisible(object->m_state.triggerState != objects::TriggerState::Invisible);
   }
@@ -150,12 +193,14 @@ void ObjectManager::update(world::World& world, bool godMode)
       setParent(particle, nullptr);
     }
   }
+  m_particlePool.update(world);
 
   if(m_lara != nullptr)
   {
     if(godMode && !m_lara->isDead())
       m_lara->m_state.health = core::LaraHealth;
     m_lara->update();
+    m_roomObjects.update(m_lara.get(), m_lara->m_state.location.room.get());
     m_lara->updateLighting();
   }
 
@@ -167,6 +212,12 @@ void ObjectManager::serialize(const serialization::Serializer<world::World>& ser
   ser(S_NV("objectCounter", m_objectCounter),
       S_NV("objects", m_objects),
       S_NV("lara", serialization::ObjectReference{m_lara}));
+
+  if(ser.loading)
+  {
+    m_registriesDirty = true;
+    m_particlePool.clear();
+  }
 }
 
 void ObjectManager::eraseParticle(const std::shared_ptr<Particle>& particle)
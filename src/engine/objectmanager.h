@@ -1,5 +1,7 @@
 #pragma once
 
+#include "particlepool.h"
+#include "roomindex.h"
 #include "serialization/serialization_fwd.h"
 
 #include <cstdint>
@@ -20,7 +22,8 @@ struct Item;
 namespace engine::world
 {
 class World;
-}
+struct Room;
+} // namespace engine::world
 
 namespace engine
 {
@@ -28,6 +31,7 @@ namespace objects
 {
 class Object;
 class LaraObject;
+class ModelObject;
 } // namespace objects
 
 class Particle;
@@ -41,8 +45,20 @@ class ObjectManager
   std::map<ObjectId, gsl::not_null<std::shared_ptr<objects::Object>>> m_objects;
   std::set<gsl::not_null<std::shared_ptr<objects::Object>>> m_dynamicObjects;
   std::vector<gsl::not_null<std::shared_ptr<Particle>>> m_particles;
+  ParticlePool m_particlePool;
   std::shared_ptr<objects::LaraObject> m_lara = nullptr;
 
+  //! model objects other than lara, so aiming needs no type checks per query
+  std::vector<gsl::not_null<std::shared_ptr<objects::ModelObject>>> m_targetCandidates;
+  //! objects grouped by the room they were in after their last update
+  RoomIndex<world::Room, objects::Object> m_roomObjects;
+  //! set after loading a savegame, as the object locations are only complete after all lazy loaders ran
+  bool m_registriesDirty = false;
+
+  void addToRegistries(const gsl::not_null<std::shared_ptr<objects::Object>>& object);
+  void removeFromRegistries(const objects::Object* object);
+  void rebuildRegistries();
+
 public:
   auto& getObjects()
   {
@@ -84,6 +100,7 @@ public:
   void registerDynamicObject(const gsl::not_null<std::shared_ptr<objects::Object>>& object)
   {
     m_dynamicObjects.emplace(object);
+    addToRegistries(object);
   }
 
   [[nodiscard]] auto getDynamicObjectCount() const
@@ -108,6 +125,22 @@ public:
 
   void eraseParticle(const std::shared_ptr<Particle>& particle);
 
+  auto& getParticlePool()
+  {
+    return m_particlePool;
+  }
+
+  [[nodiscard]] const auto& getTargetCandidates() const
+  {
+    return m_targetCandidates;
+  }
+
+  //! static and dynamic objects within the room, as of their last update
+  [[nodiscard]] const auto& getObjectsInRoom(const world::Room* room) const
+  {
+    return m_roomObjects.getObjects(room);
+  }
+
   void applyScheduledDeletions();
   void registerObject(const gsl::not_null<std::shared_ptr<objects::Object>>& object);
   std::shared_ptr<objects::Object> find(const objects::Object* object) const;
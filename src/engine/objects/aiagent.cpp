@@ -11,6 +11,7 @@
 #include "engine/objectmanager.h"
 #include "engine/objects/objectstate.h"
 #include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/raycast.h"
 #include "engine/script/reflection.h"
 #include "engine/script/scriptengine.h"
@@ -485,7 +486,7 @@ bool AIAgent::tryShootAtLara(ModelObject& object,
     {
       isHit = true;
 
-      lara.emitParticle(core::TRVec{}, util::rand15(lara.getSkeleton()->getBoneCount()), &createBloodSplat);
+      lara.emitBloodSplat(core::TRVec{}, util::rand15(lara.getSkeleton()->getBoneCount()));
 
       if(!lara.isInWater())
         lara.playSoundEffect(TR1SoundEffect::BulletHitsLara);
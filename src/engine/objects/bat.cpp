@@ -6,7 +6,7 @@
 #include "core/vec.h"
 #include "engine/ai/ai.h"
 #include "engine/location.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "objectstate.h"
 #include "qs/qs.h"
 
@@ -41,7 +41,7 @@ void Bat::update()
     case Biting:
       if(touched())
       {
-        emitParticle(core::TRVec{0_len, 16_len, 45_len}, 4, &createBloodSplat);
+        emitBloodSplat(core::TRVec{0_len, 16_len, 45_len}, 4);
         hitLara(2_hp);
       }
       else
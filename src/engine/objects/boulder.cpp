@@ -9,7 +9,7 @@
 #include "engine/collisioninfo.h"
 #include "engine/heightinfo.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/world/skeletalmodeltype.h"
 #include "engine/world/world.h"
@@ -128,11 +128,10 @@ void engine::objects::RollingBall::collide(CollisionInfo& collisionInfo)
     {
       const auto tmp = lara.m_state.location.position
                        + core::TRVec{util::rand15s(128_len), -util::rand15s(512_len), util::rand15s(128_len)};
-      auto fx = createBloodSplat(getWorld(),
-                                 Location{m_state.location.room, tmp},
-                                 2 * m_state.speed,
-                                 util::rand15s(22.5_deg) + m_state.rotation.Y);
-      getWorld().getObjectManager().registerParticle(fx);
+      getWorld().getObjectManager().getParticlePool().emitBloodSplat(getWorld(),
+                                                                     Location{m_state.location.room, tmp},
+                                                                     2 * m_state.speed,
+                                                                     util::rand15s(22.5_deg) + m_state.rotation.Y);
     }
     return;
   }
@@ -148,7 +147,7 @@ void engine::objects::RollingBall::collide(CollisionInfo& collisionInfo)
   const auto z = lara.m_state.location.position.Z - m_state.location.position.Z;
   const auto xyz = std::max(2 * core::QuarterSectorSize, sqrt(util::square(x) + util::square(y) + util::square(z)));
 
-  auto fx = createBloodSplat(
+  getWorld().getObjectManager().getParticlePool().emitBloodSplat(
     getWorld(),
     Location{m_state.location.room,
              core::TRVec{x * core::SectorSize / 2 / xyz + m_state.location.position.X,
@@ -156,7 +155,6 @@ void engine::objects::RollingBall::collide(CollisionInfo& collisionInfo)
                          z * core::SectorSize / 2 / xyz + m_state.location.position.Z}},
     m_state.speed,
     m_state.rotation.Y);
-  getWorld().getObjectManager().registerParticle(fx);
 }
 
 engine::objects::RollingBall::RollingBall(const std::string& name,
@@ -11,7 +11,7 @@
 #include "engine/items_tr1.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/world/animation.h"
 #include "engine/world/room.h"
@@ -56,7 +56,7 @@ void Crocodile::updateInWater()
       {
         if(m_state.required_anim_state == 0_as)
         {
-          emitParticle({5_len, -21_len, 467_len}, 9, &createBloodSplat);
+          emitBloodSplat({5_len, -21_len, 467_len}, 9);
           hitLara(100_hp);
           require(1_as);
         }
@@ -207,7 +207,7 @@ void Crocodile::updateOnLand()
     case 5:
       if(m_state.required_anim_state == 0_as)
       {
-        emitParticle({5_len, -21_len, 467_len}, 9, &createBloodSplat);
+        emitBloodSplat({5_len, -21_len, 467_len}, 9);
         hitLara(100_hp);
         require(1_as);
       }
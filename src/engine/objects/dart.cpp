@@ -7,6 +7,7 @@
 #include "engine/location.h"
 #include "engine/objectmanager.h"
 #include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/raycast.h"
 #include "engine/world/room.h"
 #include "engine/world/world.h"
@@ -36,8 +37,8 @@ void Dart::update()
     getWorld().getObjectManager().getLara().m_state.health -= 50_hp;
     getWorld().getObjectManager().getLara().m_state.is_hit = true;
 
-    auto fx = createBloodSplat(getWorld(), m_state.location, m_state.speed, m_state.rotation.Y);
-    getWorld().getObjectManager().registerParticle(fx);
+    getWorld().getObjectManager().getParticlePool().emitBloodSplat(
+      getWorld(), m_state.location, m_state.speed, m_state.rotation.Y);
   }
 
   const auto oldLocation = m_state.location;
@@ -10,6 +10,7 @@
 #include "engine/lara/abstractstatehandler.h"
 #include "engine/objectmanager.h"
 #include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/player.h"
 #include "engine/presenter.h"
 #include "engine/raycast.h"
@@ -34,9 +35,9 @@
 #include "serialization/vector_element.h"
 #include "util/helpers.h"
 
+#include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/log/trivial.hpp>
-#include <boost/range/adaptor/map.hpp>
 #include <boost/throw_exception.hpp>
 #include <cstdlib>
 #include <exception>
@@ -50,7 +51,6 @@
 #include <iosfwd>
 #include <limits>
 #include <map>
-#include <set>
 #include <stack>
 #include <stdexcept>
 #include <type_traits>
@@ -436,9 +436,7 @@ void LaraObject::update()
         surfaceLocation.position.Y = *waterSurfaceHeight;
         surfaceLocation.position.Z = m_state.location.position.Z;
 
-        auto particle = gslu::make_nn_shared<SplashParticle>(surfaceLocation, getWorld(), false);
-        setParent(particle, surfaceLocation.room->node);
-        getWorld().getObjectManager().registerParticle(particle);
+        getWorld().getObjectManager().getParticlePool().emitSplash(getWorld(), surfaceLocation, false);
       }
     }
   }
@@ -646,32 +644,33 @@ void LaraObject::testInteractions(CollisionInfo& collisionInfo)
   if(isDead())
     return;
 
-  std::set<gsl::not_null<const world::Room*>> rooms;
-  rooms.insert(m_state.location.room);
+  std::vector<const world::Room*> rooms{m_state.location.room.get()};
   for(const world::Portal& p : m_state.location.room->portals)
-    rooms.insert(p.adjoiningRoom);
+  {
+    if(std::find(rooms.begin(), rooms.end(), p.adjoiningRoom.get()) == rooms.end())
+      rooms.emplace_back(p.adjoiningRoom.get());
+  }
 
-  const auto execCollisions = [this, &rooms, &collisionInfo](const auto& range)
+  auto& objectManager = getWorld().getObjectManager();
+  // collect first, as colliding may spawn new objects
+  std::vector<gsl::not_null<Object*>> candidates;
+  for(const auto& room : rooms)
   {
-    for(const auto& object : range)
+    for(const auto& object : objectManager.getObjectsInRoom(room))
     {
       if(!object->m_state.collidable || object->m_state.triggerState == TriggerState::Invisible)
         continue;
 
-      if(rooms.find(object->m_state.location.room) == rooms.end())
-        continue;
-
       const auto d = m_state.location.position - object->m_state.location.position;
       if(abs(d.X) >= 4 * core::SectorSize || abs(d.Y) >= 4 * core::SectorSize || abs(d.Z) >= 4 * core::SectorSize)
         continue;
 
-      object->collide(collisionInfo);
+      candidates.emplace_back(object);
     }
-  };
+  }
 
-  auto& objectManager = getWorld().getObjectManager();
-  execCollisions(objectManager.getObjects() | boost::adaptors::map_values);
-  execCollisions(objectManager.getDynamicObjects());
+  for(const auto& object : candidates)
+    object->collide(collisionInfo);
 
   auto& lara = objectManager.getLara();
   if(lara.explosionStumblingDuration != 0_frame)
@@ -1107,19 +1106,9 @@ void LaraObject::findTarget(const Weapon& weapon)
   weaponLocation.position.Y -= weapons.at(WeaponType::Shotgun).weaponHeight;
   aimAt.reset();
   core::Angle bestYAngle{std::numeric_limits<core::Angle::type>::max()};
-  for(const auto& currentEnemy : getWorld().getObjectManager().getObjects() | boost::adaptors::map_values)
+  for(const auto& currentEnemy : getWorld().getObjectManager().getTargetCandidates())
   {
-    if(currentEnemy->m_state.isDead() || currentEnemy.get() == getWorld().getObjectManager().getLaraPtr())
-      continue;
-
-    const auto modelEnemy = std::dynamic_pointer_cast<ModelObject>(currentEnemy.get());
-    if(modelEnemy == nullptr)
-    {
-      BOOST_LOG_TRIVIAL(warning) << "Ignoring non-model object " << currentEnemy->getNode()->getName();
-      continue;
-    }
-
-    if(!modelEnemy->getNode()->isVisible() || !modelEnemy->m_isActive)
+    if(currentEnemy->m_state.isDead() || !currentEnemy->m_isActive || !currentEnemy->getNode()->isVisible())
       continue;
 
     const auto d = currentEnemy->m_state.location.position - weaponLocation.position;
@@ -1135,7 +1124,7 @@ void LaraObject::findTarget(const Weapon& weapon)
     if(util::square(d.X) + util::square(d.Y) + util::square(d.Z) >= util::square(weapon.targetDist))
       continue;
 
-    auto enemyPos = getUpperThirdBBoxCtr(*std::dynamic_pointer_cast<const ModelObject>(currentEnemy.get()));
+    auto enemyPos = getUpperThirdBBoxCtr(*currentEnemy);
     const auto canShoot = raycastLineOfSight(weaponLocation, enemyPos.position, getWorld().getObjectManager()).first;
     if(!canShoot)
       continue;
@@ -1152,7 +1141,7 @@ void LaraObject::findTarget(const Weapon& weapon)
       continue;
 
     bestYAngle = absY;
-    aimAt = modelEnemy;
+    aimAt = currentEnemy.get();
   }
   updateAimingState(weapon);
 }
@@ -1633,9 +1622,8 @@ void LaraObject::hitTarget(ModelObject& object, const core::TRVec& hitPos, const
   }
   object.m_state.is_hit = true;
   object.m_state.health -= damage;
-  auto fx = createBloodSplat(
+  getWorld().getObjectManager().getParticlePool().emitBloodSplat(
     getWorld(), Location{object.m_state.location.room, hitPos}, object.m_state.speed, object.m_state.rotation.Y);
-  getWorld().getObjectManager().registerParticle(fx);
   if(object.m_state.isDead())
     return;
 
@@ -7,6 +7,7 @@
 #include "engine/location.h"
 #include "engine/objectmanager.h"
 #include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/soundeffects_tr1.h"
 #include "engine/world/animation.h"
@@ -178,16 +179,21 @@ bool ModelObject::isNear(const ModelObject& other, const core::Length& radius) c
 }
 
 bool ModelObject::isNear(const Particle& other, const core::Length& radius) const
+{
+  return isNear(other.location.position, radius);
+}
+
+bool ModelObject::isNear(const core::TRVec& position, const core::Length& radius) const
 {
   const auto frame = getSkeleton()->getInterpolationInfo().getNearestFrame();
   const auto bbox = frame->bbox.toBBox();
   const auto selfY = m_state.location.position.Y + bbox.y;
-  if(!selfY.containsExclusive(other.location.position.Y))
+  if(!selfY.containsExclusive(position.Y))
   {
     return false;
   }
 
-  const auto xz = util::pitch(other.location.position - m_state.location.position, -m_state.rotation.Y);
+  const auto xz = util::pitch(position - m_state.location.position, -m_state.rotation.Y);
   return bbox.x.broadened(radius).contains(xz.X) && bbox.z.broadened(radius).contains(xz.Z);
 }
 
@@ -318,6 +324,19 @@ gsl::not_null<std::shared_ptr<Particle>>
   return particle;
 }
 
+void ModelObject::emitBloodSplat(const core::TRVec& localPosition, const size_t boneIndex)
+{
+  BOOST_ASSERT(boneIndex < m_skeleton->getBoneCount());
+
+  const auto boneSpheres = m_skeleton->getBoneCollisionSpheres();
+  BOOST_ASSERT(boneIndex < boneSpheres.size());
+
+  auto location = m_state.location;
+  location.position = core::TRVec{boneSpheres.at(boneIndex).relative(localPosition.toRenderSystem())};
+  getWorld().getObjectManager().getParticlePool().emitBloodSplat(
+    getWorld(), location, m_state.speed, m_state.rotation.Y);
+}
+
 void ModelObject::updateLighting()
 {
   m_lighting.update(core::Shade{core::Shade::type{-1}}, *m_state.location.room);
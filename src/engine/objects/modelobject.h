@@ -113,6 +113,8 @@ public:
 
   bool isNear(const Particle& other, const core::Length& radius) const;
 
+  bool isNear(const core::TRVec& position, const core::Length& radius) const;
+
   bool testBoneCollision(const ModelObject& other);
 
   void enemyPush(CollisionInfo& collisionInfo, bool enableSpaz, bool withXZCollRadius);
@@ -123,6 +125,8 @@ public:
                  gsl::not_null<std::shared_ptr<Particle>> (*generate)(
                    world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle));
 
+  void emitBloodSplat(const core::TRVec& localPosition, size_t boneIndex);
+
   void updateLighting() override;
 
   void collideWithLara(CollisionInfo& collisionInfo, bool push = true);
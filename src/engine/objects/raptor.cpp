@@ -6,7 +6,7 @@
 #include "core/vec.h"
 #include "engine/ai/ai.h"
 #include "engine/items_tr1.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/world/animation.h"
 #include "engine/world/skeletalmodeltype.h"
@@ -88,7 +88,7 @@ void Raptor::update()
         {
           if(touched(0xff7c00UL))
           {
-            emitParticle(core::TRVec{0_len, 66_len, 318_len}, 22, &createBloodSplat);
+            emitBloodSplat(core::TRVec{0_len, 66_len, 318_len}, 22);
             hitLara(100_hp);
             require(1_as);
           }
@@ -101,7 +101,7 @@ void Raptor::update()
       {
         if(touched(0xff7c00UL))
         {
-          emitParticle(core::TRVec{0_len, 66_len, 318_len}, 22, &createBloodSplat);
+          emitBloodSplat(core::TRVec{0_len, 66_len, 318_len}, 22);
           hitLara(100_hp);
           require(3_as);
         }
@@ -111,7 +111,7 @@ void Raptor::update()
       animTilt = animAngle;
       if(m_state.required_anim_state == 0_as && touched(0xff7c00UL))
       {
-        emitParticle(core::TRVec{0_len, 66_len, 318_len}, 22, &createBloodSplat);
+        emitBloodSplat(core::TRVec{0_len, 66_len, 318_len}, 22);
         hitLara(100_hp);
         require(1_as);
       }
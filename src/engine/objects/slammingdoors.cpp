@@ -6,7 +6,7 @@
 #include "core/vec.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/skeletalmodelnode.h"
 #include "engine/world/world.h"
 #include "laraobject.h"
@@ -42,9 +42,8 @@ void SlammingDoors::update()
       const auto emitBlood = [&objectSpheres, this](const core::TRVec& bitePos, size_t boneId)
       {
         const auto position = core::TRVec{objectSpheres.at(boneId).relative(bitePos.toRenderSystem())};
-        auto blood
-          = createBloodSplat(getWorld(), Location{m_state.location.room, position}, m_state.speed, m_state.rotation.Y);
-        getWorld().getObjectManager().registerParticle(std::move(blood));
+        getWorld().getObjectManager().getParticlePool().emitBloodSplat(
+          getWorld(), Location{m_state.location.room, position}, m_state.speed, m_state.rotation.Y);
       };
 
       for(const auto& x : {-23_len, 71_len})
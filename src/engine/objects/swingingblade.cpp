@@ -7,7 +7,7 @@
 #include "engine/heightinfo.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/world/world.h"
 #include "laraobject.h"
 #include "modelobject.h"
@@ -45,11 +45,11 @@ void SwingingBlade::update()
       getWorld().getObjectManager().getLara().m_state.location.position.X + util::rand15s(128_len),
       getWorld().getObjectManager().getLara().m_state.location.position.Y - util::rand15(745_len),
       getWorld().getObjectManager().getLara().m_state.location.position.Z + util::rand15s(128_len)};
-    auto fx = createBloodSplat(getWorld(),
-                               Location{m_state.location.room, splatPos},
-                               getWorld().getObjectManager().getLara().m_state.speed,
-                               getWorld().getObjectManager().getLara().m_state.rotation.Y + util::rand15s(+22_deg));
-    getWorld().getObjectManager().registerParticle(fx);
+    getWorld().getObjectManager().getParticlePool().emitBloodSplat(
+      getWorld(),
+      Location{m_state.location.room, splatPos},
+      getWorld().getObjectManager().getLara().m_state.speed,
+      getWorld().getObjectManager().getLara().m_state.rotation.Y + util::rand15s(+22_deg));
   }
 
   const auto sector = m_state.location.updateRoom();
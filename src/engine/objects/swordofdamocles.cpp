@@ -5,7 +5,7 @@
 #include "engine/collisioninfo.h"
 #include "engine/location.h"
 #include "engine/objectmanager.h"
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/soundeffects_tr1.h"
 #include "engine/world/world.h"
 #include "laraobject.h"
@@ -72,11 +72,10 @@ void SwordOfDamocles::collide(CollisionInfo& collisionInfo)
   getWorld().getObjectManager().getLara().m_state.health -= 100_hp;
   const auto tmp = getWorld().getObjectManager().getLara().m_state.location.position
                    + core::TRVec{util::rand15s(128_len), -util::rand15(745_len), util::rand15s(128_len)};
-  auto fx = createBloodSplat(getWorld(),
-                             Location{m_state.location.room, tmp},
-                             getWorld().getObjectManager().getLara().m_state.speed,
-                             util::rand15s(22.5_deg) + m_state.rotation.Y);
-  getWorld().getObjectManager().registerParticle(fx);
+  getWorld().getObjectManager().getParticlePool().emitBloodSplat(getWorld(),
+                                                                 Location{m_state.location.room, tmp},
+                                                                 getWorld().getObjectManager().getLara().m_state.speed,
+                                                                 util::rand15s(22.5_deg) + m_state.rotation.Y);
 }
 
 void SwordOfDamocles::serialize(const serialization::Serializer<world::World>& ser)
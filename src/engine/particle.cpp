@@ -11,6 +11,7 @@
 #include "objectmanager.h"
 #include "objects/laraobject.h"
 #include "objects/objectstate.h"
+#include "particlepool.h"
 #include "presenter.h"
 #include "render/scene/mesh.h" // IWYU pragma: keep
 #include "skeletalmodelnode.h"
@@ -130,77 +131,6 @@ void Particle::applyTransform()
   setLocalMatrix(translate(glm::mat4{1.0f}, tr) * angle.toMatrix());
 }
 
-bool BloodSplatterParticle::update(world::World& world)
-{
-  location.position += util::pitch(speed * 1_frame, angle.Y);
-  ++timePerSpriteFrame;
-  if(timePerSpriteFrame != 4)
-  {
-    applyTransform();
-    return true;
-  }
-
-  timePerSpriteFrame = 0;
-  nextFrame();
-  if(gsl::narrow<size_t>(-negSpriteFrameId) >= world.findSpriteSequenceForType(object_number)->sprites.size())
-    return false;
-
-  applyTransform();
-  return true;
-}
-
-bool SplashParticle::update(world::World& world)
-{
-  nextFrame();
-
-  if(gsl::narrow<size_t>(-negSpriteFrameId) >= world.findSpriteSequenceForType(object_number)->sprites.size())
-  {
-    return false;
-  }
-
-  location.position += util::pitch(speed * 1_frame, angle.Y);
-
-  applyTransform();
-  return true;
-}
-
-SplashParticle::SplashParticle(const Location& location, world::World& world, const bool waterfall)
-    : Particle{"splash", TR1ItemId::Splash, location, world, false}
-{
-  if(!waterfall)
-  {
-    speed = util::rand15(128_spd);
-    angle.Y = core::auToAngle(2 * util::rand15s());
-  }
-  else
-  {
-    this->location.position.X += util::rand15s(core::SectorSize);
-    this->location.position.Z += util::rand15s(core::SectorSize);
-  }
-  getRenderState().setScissorTest(false);
-}
-
-bool BubbleParticle::update(world::World& world)
-{
-  angle.X += 13_deg;
-  angle.Y += 9_deg;
-  location.position += util::pitch(11_len, angle.Y, -speed * 1_frame);
-  auto sector = location.updateRoom();
-  if(!location.room->isWaterRoom)
-  {
-    return false;
-  }
-
-  if(const auto ceiling = HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y;
-     ceiling == core::InvalidHeight || location.position.Y <= ceiling)
-  {
-    return false;
-  }
-
-  applyTransform();
-  return true;
-}
-
 FlameParticle::FlameParticle(const Location& location, world::World& world, bool randomize)
     : Particle{"flame", TR1ItemId::Flame, location, world, false}
 {
@@ -394,10 +324,8 @@ bool MutantBulletParticle::update(world::World& world)
   {
     auto& laraState = world.getObjectManager().getLara().m_state;
     laraState.health -= 30_hp;
-    auto particle = gslu::make_nn_shared<BloodSplatterParticle>(location, speed, angle.Y, world);
-    setParent(particle, location.room->node);
-    world.getObjectManager().registerParticle(particle);
-    world.getAudioEngine().playSoundEffect(TR1SoundEffect::BulletHitsLara, particle.get().get());
+    world.getObjectManager().getParticlePool().emitBloodSplat(world, location, speed, angle.Y);
+    world.getAudioEngine().playSoundEffect(TR1SoundEffect::BulletHitsLara, location.position.toRenderSystem());
     laraState.is_hit = true;
     angle.Y = laraState.rotation.Y;
     speed = laraState.speed;
@@ -462,44 +390,6 @@ bool MutantGrenadeParticle::update(world::World& world)
   return true;
 }
 
-bool LavaParticle::update(world::World& world)
-{
-  fall_speed += core::Gravity * 1_frame;
-  location.position += util::pitch(speed * 1_frame, angle.Y, fall_speed * 1_frame);
-
-  const auto sector = location.updateRoom();
-  setParent(this, location.room->node);
-  if(HeightInfo::fromFloor(sector, location.position, world.getObjectManager().getObjects()).y <= location.position.Y
-     || HeightInfo::fromCeiling(sector, location.position, world.getObjectManager().getObjects()).y
-          > location.position.Y)
-  {
-    return false;
-  }
-
-  if(world.getObjectManager().getLara().isNear(*this, 200_len))
-  {
-    world.getObjectManager().getLara().m_state.health -= 10_hp;
-    world.getObjectManager().getLara().m_state.is_hit = true;
-    return false;
-  }
-
-  applyTransform();
-  return true;
-}
-
-bool SparkleParticle::update(world::World&)
-{
-  applyTransform();
-
-  ++timePerSpriteFrame;
-  if(timePerSpriteFrame != 1)
-    return true;
-
-  --negSpriteFrameId;
-  timePerSpriteFrame = 0;
-  return gsl::narrow<size_t>(-negSpriteFrameId) < getLength();
-}
-
 bool MuzzleFlashParticle::update(world::World&)
 {
   --timePerSpriteFrame;
@@ -578,12 +468,4 @@ gsl::not_null<std::shared_ptr<Particle>> createMutantGrenade(world::World& world
   setParent(particle, location.room->node);
   return particle;
 }
-
-gsl::not_null<std::shared_ptr<Particle>>
-  createBloodSplat(world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle)
-{
-  auto particle = gslu::make_nn_shared<BloodSplatterParticle>(location, speed, angle, world);
-  setParent(particle, location.room->node);
-  return particle;
-}
 } // namespace engine
@@ -104,30 +104,6 @@ public:
   glm::vec3 getPosition() const final;
 };
 
-class BloodSplatterParticle final : public Particle
-{
-public:
-  explicit BloodSplatterParticle(const Location& location,
-                                 const core::Speed& speed_,
-                                 const core::Angle& angle_,
-                                 world::World& world)
-      : Particle{"bloodsplat", TR1ItemId::Blood, location, world, true}
-  {
-    speed = speed_;
-    angle.Y = angle_;
-  }
-
-  bool update(world::World& world) override;
-};
-
-class SplashParticle final : public Particle
-{
-public:
-  explicit SplashParticle(const Location& location, world::World& world, const bool waterfall);
-
-  bool update(world::World& world) override;
-};
-
 class RicochetParticle final : public Particle
 {
 public:
@@ -144,33 +120,6 @@ public:
   bool update(world::World& /*world*/) override;
 };
 
-class BubbleParticle final : public Particle
-{
-public:
-  explicit BubbleParticle(const Location& location, world::World& world)
-      : Particle{"bubble", TR1ItemId::Bubbles, location, world, true, nullptr}
-  {
-    speed = 10_spd + util::rand15(6_spd);
-
-    const int n = util::rand15(3);
-    for(int i = 0; i < n; ++i)
-      nextFrame();
-  }
-
-  bool update(world::World& world) override;
-};
-
-class SparkleParticle final : public Particle
-{
-public:
-  explicit SparkleParticle(const Location& location, world::World& world)
-      : Particle{"sparkles", TR1ItemId::Sparkles, location, world, true}
-  {
-  }
-
-  bool update(world::World& /*world*/) override;
-};
-
 class MuzzleFlashParticle final : public Particle
 {
 public:
@@ -264,21 +213,6 @@ public:
   bool update(world::World& world) override;
 };
 
-class LavaParticle final : public Particle
-{
-public:
-  explicit LavaParticle(const Location& location, world::World& world)
-      : Particle{"lava", TR1ItemId::LavaParticles, location, world, true}
-  {
-    angle.Y = util::rand15(180_deg) * 2;
-    speed = util::rand15(32_spd);
-    fall_speed = -util::rand15(165_spd);
-    negSpriteFrameId = util::rand15(int16_t{-4});
-  }
-
-  bool update(world::World& world) override;
-};
-
 class SmokeParticle final : public Particle
 {
 public:
@@ -291,9 +225,6 @@ public:
   bool update(world::World& /*world*/) override;
 };
 
-extern gsl::not_null<std::shared_ptr<Particle>>
-  createBloodSplat(world::World& world, const Location& location, const core::Speed& speed, const core::Angle& angle);
-
 extern gsl::not_null<std::shared_ptr<Particle>> createMuzzleFlash(world::World& world,
                                                                   const Location& location,
                                                                   const core::Speed& /*speed*/,
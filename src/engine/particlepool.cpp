@@ -0,0 +1,418 @@
+#include "particlepool.h"
+
+#include "core/magic.h"
+#include "heightinfo.h"
+#include "items_tr1.h"
+#include "lighting.h"
+#include "objectmanager.h"
+#include "objects/laraobject.h"
+#include "presenter.h"
+#include "render/scene/camera.h"
+#include "render/scene/materialgroup.h"
+#include "render/scene/materialmanager.h"
+#include "render/scene/mesh.h"
+#include "render/scene/node.h"
+#include "render/scene/renderer.h"
+#include "render/scene/rendermode.h"
+#include "render/scene/shaderprogram.h"
+#include "util/helpers.h"
+#include "world/room.h"
+#include "world/sprite.h"
+#include "world/world.h"
+
+#include <algorithm>
+#include <array>
+#include <boost/assert.hpp>
+#include <boost/log/trivial.hpp>
+#include <gl/buffer.h>
+#include <gl/program.h>
+#include <gl/vertexarray.h>
+#include <gl/vertexbuffer.h>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <gslu.h>
+#include <iterator>
+
+namespace engine
+{
+namespace
+{
+struct KindInfo
+{
+  TR1ItemId type;
+  //! 0 if the sprite doesn't animate
+  uint16_t ticksPerFrame;
+  bool billboard;
+};
+
+// indexed by ParticlePool::Kind
+constexpr std::array<KindInfo, 5> KindInfos{{
+  {TR1ItemId::Blood, 4, true},
+  {TR1ItemId::Bubbles, 0, true},
+  {TR1ItemId::LavaParticles, 0, true},
+  {TR1ItemId::Sparkles, 1, true},
+  {TR1ItemId::Splash, 1, false},
+}};
+
+const KindInfo& getInfo(const ParticlePool::Kind kind)
+{
+  return KindInfos.at(static_cast<size_t>(kind));
+}
+
+// bubbles turn by 9 degrees per frame while drifting 11 units
+constexpr size_t BubbleDriftPeriod = 40;
+
+const std::array<core::TRVec, BubbleDriftPeriod>& getBubbleDrift()
+{
+  static const auto drift = []()
+  {
+    std::array<core::TRVec, BubbleDriftPeriod> result;
+    for(size_t i = 0; i < result.size(); ++i)
+      result[i] = util::pitch(11_len, 9_deg * gsl::narrow_cast<int32_t>(i));
+    return result;
+  }();
+  return drift;
+}
+} // namespace
+
+ParticlePool::ParticlePool() = default;
+
+ParticlePool::~ParticlePool() = default;
+
+void ParticlePool::emitBloodSplat(world::World& world,
+                                  const Location& location,
+                                  const core::Speed& speed,
+                                  const core::Angle& angle)
+{
+  emit(world, Kind::Blood, location, util::pitch(speed * 1_frame, angle), 0_len, 0);
+}
+
+void ParticlePool::emitBubble(world::World& world, const Location& location)
+{
+  const auto speed = 10_spd + util::rand15(6_spd);
+  emit(world, Kind::Bubble, location, core::TRVec{0_len, -speed * 1_frame, 0_len}, 0_len, util::rand15(uint16_t{3}));
+}
+
+void ParticlePool::emitLava(world::World& world, const Location& location)
+{
+  const auto angle = util::rand15(180_deg) * 2;
+  const auto speed = util::rand15(32_spd);
+  const auto fallSpeed = -util::rand15(165_spd);
+  emit(world,
+       Kind::Lava,
+       location,
+       util::pitch(speed * 1_frame, angle, fallSpeed * 1_frame),
+       core::Gravity * 1_frame * 1_frame,
+       0);
+}
+
+void ParticlePool::emitSparkle(world::World& world, const Location& location)
+{
+  emit(world, Kind::Sparkle, location, core::TRVec{}, 0_len, 0);
+}
+
+void ParticlePool::emitSplash(world::World& world, const Location& location, const bool waterfall)
+{
+  if(!waterfall)
+  {
+    const auto speed = util::rand15(128_spd);
+    const auto angle = core::auToAngle(2 * util::rand15s());
+    emit(world, Kind::Splash, location, util::pitch(speed * 1_frame, angle), 0_len, 0);
+    return;
+  }
+
+  emit(world,
+       Kind::Splash,
+       location.moved(util::rand15s(core::SectorSize), 0_len, util::rand15s(core::SectorSize)),
+       core::TRVec{},
+       0_len,
+       0);
+}
+
+void ParticlePool::emit(world::World& world,
+                        const Kind kind,
+                        const Location& location,
+                        const core::TRVec& velocity,
+                        const core::Length& gravity,
+                        const uint16_t firstFrame)
+{
+  const auto& info = getInfo(kind);
+  const auto& sequence = world.findSpriteSequenceForType(info.type);
+  if(sequence == nullptr || sequence->sprites.empty())
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Missing sprite referenced by particle: " << toString(info.type);
+    return;
+  }
+
+  if(m_kinds.size() >= MaxParticles)
+  {
+    const auto oldest = std::max_element(m_ages.begin(), m_ages.end());
+    erase(gsl::narrow_cast<size_t>(std::distance(m_ages.begin(), oldest)));
+  }
+
+  m_kinds.emplace_back(kind);
+  m_x.emplace_back(location.position.X.get());
+  m_y.emplace_back(location.position.Y.get());
+  m_z.emplace_back(location.position.Z.get());
+  m_velocityX.emplace_back(velocity.X.get());
+  m_velocityY.emplace_back(velocity.Y.get());
+  m_velocityZ.emplace_back(velocity.Z.get());
+  m_gravity.emplace_back(gravity.get());
+  m_ages.emplace_back(0);
+  m_lifetimes.emplace_back(gsl::narrow<uint16_t>(info.ticksPerFrame * sequence->sprites.size()));
+  m_firstFrames.emplace_back(firstFrame);
+  m_dead.emplace_back(0);
+  m_rooms.emplace_back(location.room.get());
+}
+
+void ParticlePool::erase(const size_t i)
+{
+  BOOST_ASSERT(i < m_kinds.size());
+  const auto last = m_kinds.size() - 1;
+  m_kinds[i] = m_kinds[last];
+  m_x[i] = m_x[last];
+  m_y[i] = m_y[last];
+  m_z[i] = m_z[last];
+  m_velocityX[i] = m_velocityX[last];
+  m_velocityY[i] = m_velocityY[last];
+  m_velocityZ[i] = m_velocityZ[last];
+  m_gravity[i] = m_gravity[last];
+  m_ages[i] = m_ages[last];
+  m_lifetimes[i] = m_lifetimes[last];
+  m_firstFrames[i] = m_firstFrames[last];
+  m_dead[i] = m_dead[last];
+  m_rooms[i] = m_rooms[last];
+
+  m_kinds.pop_back();
+  m_x.pop_back();
+  m_y.pop_back();
+  m_z.pop_back();
+  m_velocityX.pop_back();
+  m_velocityY.pop_back();
+  m_velocityZ.pop_back();
+  m_gravity.pop_back();
+  m_ages.pop_back();
+  m_lifetimes.pop_back();
+  m_firstFrames.pop_back();
+  m_dead.pop_back();
+  m_rooms.pop_back();
+}
+
+void ParticlePool::clear()
+{
+  m_kinds.clear();
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_velocityX.clear();
+  m_velocityY.clear();
+  m_velocityZ.clear();
+  m_gravity.clear();
+  m_ages.clear();
+  m_lifetimes.clear();
+  m_firstFrames.clear();
+  m_dead.clear();
+  m_rooms.clear();
+
+  if(m_node != nullptr)
+    m_node->setVisible(false);
+}
+
+void ParticlePool::update(world::World& world)
+{
+  move();
+  collide(world);
+  compact();
+}
+
+void ParticlePool::move()
+{
+  const auto n = m_kinds.size();
+
+  for(size_t i = 0; i < n; ++i)
+    ++m_ages[i];
+
+  const auto& bubbleDrift = getBubbleDrift();
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(m_kinds[i] != Kind::Bubble)
+      continue;
+
+    const auto& drift = bubbleDrift[m_ages[i] % BubbleDriftPeriod];
+    m_velocityX[i] = drift.X.get();
+    m_velocityZ[i] = drift.Z.get();
+  }
+
+  // plain loops over the separate arrays, so they can be vectorized
+  for(size_t i = 0; i < n; ++i)
+    m_velocityY[i] += m_gravity[i];
+  for(size_t i = 0; i < n; ++i)
+  {
+    m_x[i] += m_velocityX[i];
+    m_y[i] += m_velocityY[i];
+    m_z[i] += m_velocityZ[i];
+  }
+  for(size_t i = 0; i < n; ++i)
+    m_dead[i] = static_cast<uint8_t>(m_lifetimes[i] != 0 && m_ages[i] >= m_lifetimes[i]);
+}
+
+void ParticlePool::collide(world::World& world)
+{
+  const auto& objects = world.getObjectManager().getObjects();
+  for(size_t i = 0; i < m_kinds.size(); ++i)
+  {
+    if(m_dead[i] != 0)
+      continue;
+
+    Location location{gsl::not_null{m_rooms[i]},
+                      core::TRVec{core::Length{m_x[i]}, core::Length{m_y[i]}, core::Length{m_z[i]}}};
+    const auto sector = location.updateRoom();
+    m_rooms[i] = location.room.get();
+
+    switch(m_kinds[i])
+    {
+    case Kind::Bubble:
+      if(!location.room->isWaterRoom)
+      {
+        m_dead[i] = 1;
+      }
+      else if(const auto ceiling = HeightInfo::fromCeiling(sector, location.position, objects).y;
+              ceiling == core::InvalidHeight || location.position.Y <= ceiling)
+      {
+        m_dead[i] = 1;
+      }
+      break;
+    case Kind::Lava:
+      if(HeightInfo::fromFloor(sector, location.position, objects).y <= location.position.Y
+         || HeightInfo::fromCeiling(sector, location.position, objects).y > location.position.Y)
+      {
+        m_dead[i] = 1;
+      }
+      else if(auto& lara = world.getObjectManager().getLara(); lara.isNear(location.position, 200_len))
+      {
+        lara.m_state.health -= 10_hp;
+        lara.m_state.is_hit = true;
+        m_dead[i] = 1;
+      }
+      break;
+    default: break;
+    }
+  }
+}
+
+void ParticlePool::compact()
+{
+  for(size_t i = 0; i < m_kinds.size();)
+  {
+    if(m_dead[i] != 0)
+      erase(i);
+    else
+      ++i;
+  }
+}
+
+void ParticlePool::initMesh(world::World& world)
+{
+  const auto material = world.getPresenter().getMaterialManager()->getSpriteBatch();
+
+  auto vertexBuffer = gslu::make_nn_shared<gl::VertexBuffer<render::scene::SpriteVertex>>(
+    render::scene::SpriteVertex::getLayout(), "particle-pool");
+  auto indexBuffer = gslu::make_nn_shared<gl::ElementArrayBuffer<uint32_t>>("particle-pool");
+  auto vao = gslu::make_nn_shared<gl::VertexArray<uint32_t, render::scene::SpriteVertex>>(
+    indexBuffer, vertexBuffer, std::vector{&material->getShaderProgram()->getHandle()}, "particle-pool");
+  auto mesh = gslu::make_nn_shared<render::scene::MeshImpl<uint32_t, render::scene::SpriteVertex>>(vao);
+  mesh->getMaterialGroup().set(render::scene::RenderMode::Full, material);
+  // the particles of all rooms share this mesh, so no single room's scissors apply
+  mesh->getRenderState().setScissorTest(false);
+
+  m_vertexBuffer = vertexBuffer.get();
+  m_indexBuffer = indexBuffer.get();
+  m_node = std::make_shared<render::scene::Node>("particle-pool");
+  m_node->setRenderable(mesh.get());
+  m_node->setVisible(false);
+
+  // the ambient brightness of the particles' rooms is baked into the vertex colors
+  m_node->bind("u_lightAmbient",
+               [](const render::scene::Node& /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
+               { uniform.set(1.0f); });
+  m_node->bind("b_lights",
+               [emptyLights = ShaderLight::getEmptyBuffer()](const render::scene::Node& /*node*/,
+                                                             const render::scene::Mesh& /*mesh*/,
+                                                             gl::ShaderStorageBlock& shaderStorageBlock)
+               { shaderStorageBlock.bind(*emptyLights); });
+}
+
+void ParticlePool::render(world::World& world, const render::scene::Camera& camera)
+{
+  if(m_node == nullptr)
+    initMesh(world);
+
+  const auto& rootNode = world.getPresenter().getRenderer().getRootNode();
+  if(m_node->getParent().lock() != rootNode)
+    setParent(gsl::not_null{m_node}, rootNode);
+
+  std::array<const world::SpriteSequence*, KindInfos.size()> sequences{};
+  for(size_t i = 0; i < KindInfos.size(); ++i)
+    sequences[i] = world.findSpriteSequenceForType(KindInfos[i].type).get();
+
+  const auto right = camera.getRightVector();
+  const auto up = camera.getUpVector();
+  const auto normal = -camera.getFrontVector();
+
+  m_vertices.clear();
+  for(size_t i = 0; i < m_kinds.size(); ++i)
+  {
+    // particles in rooms hidden by the portal tracing would shine through walls
+    const auto room = m_rooms[i];
+    if(room->node == nullptr || !room->node->isVisible())
+      continue;
+
+    const auto kind = static_cast<size_t>(m_kinds[i]);
+    const auto& info = KindInfos[kind];
+    const auto sequence = sequences[kind];
+    BOOST_ASSERT(sequence != nullptr && !sequence->sprites.empty());
+
+    size_t frame = m_firstFrames[i];
+    if(info.ticksPerFrame != 0)
+      frame += m_ages[i] / info.ticksPerFrame;
+    const auto& sprite = sequence->sprites[frame % sequence->sprites.size()];
+
+    const auto position
+      = core::TRVec{core::Length{m_x[i]}, core::Length{m_y[i]}, core::Length{m_z[i]}}.toRenderSystem();
+    const auto spriteUp = info.billboard ? up : glm::vec3{0, 1, 0};
+    const glm::vec4 color{glm::vec3{toBrightness(room->ambientShade).get()}, 1.0f};
+    for(auto vertex : render::scene::createSpriteVertices(static_cast<float>(sprite.render0.x),
+                                                          static_cast<float>(-sprite.render0.y),
+                                                          static_cast<float>(sprite.render1.x),
+                                                          static_cast<float>(-sprite.render1.y),
+                                                          sprite.uv0,
+                                                          sprite.uv1,
+                                                          sprite.textureId.get_as<int32_t>()))
+    {
+      vertex.pos = position + vertex.pos.x * right + vertex.pos.y * spriteUp;
+      vertex.color = color;
+      vertex.normal = normal;
+      m_vertices.emplace_back(vertex);
+    }
+  }
+
+  m_node->setVisible(!m_vertices.empty());
+  if(m_vertices.empty())
+    return;
+
+  const auto quads = m_vertices.size() / 4;
+  if(const auto oldQuads = m_indices.size() / 6; oldQuads != quads)
+  {
+    m_indices.resize(quads * 6);
+    for(size_t quad = oldQuads; quad < quads; ++quad)
+    {
+      static constexpr std::array<uint32_t, 6> QuadIndices{0, 1, 2, 0, 2, 3};
+      const auto base = gsl::narrow<uint32_t>(quad * 4);
+      for(size_t j = 0; j < QuadIndices.size(); ++j)
+        m_indices[quad * 6 + j] = base + QuadIndices[j];
+    }
+    m_indexBuffer->setData(m_indices, gl::api::BufferUsage::StreamDraw);
+  }
+  m_vertexBuffer->setData(m_vertices, gl::api::BufferUsage::StreamDraw);
+}
+} // namespace engine
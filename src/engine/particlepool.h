@@ -0,0 +1,105 @@
+#pragma once
+
+#include "core/angle.h"
+#include "core/units.h"
+#include "core/vec.h"
+#include "location.h"
+#include "render/scene/sprite.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <gl/soglb_fwd.h>
+#include <memory>
+#include <vector>
+
+namespace render::scene
+{
+class Camera;
+class Node;
+} // namespace render::scene
+
+namespace engine::world
+{
+class World;
+struct Room;
+} // namespace engine::world
+
+namespace engine
+{
+// simulates the short-lived sprite particles, which neither emit sounds nor need a scene node of their own, as
+// structure-of-arrays, and draws all of them with a single streamed mesh; flames, explosions and projectiles are still
+// Particle nodes
+class ParticlePool final
+{
+public:
+  enum class Kind : uint8_t
+  {
+    Blood,
+    Bubble,
+    Lava,
+    Sparkle,
+    Splash
+  };
+
+  //! older particles are replaced when the pool is full
+  static constexpr size_t MaxParticles = 8192;
+
+  ParticlePool();
+  ~ParticlePool();
+
+  void emitBloodSplat(world::World& world,
+                      const Location& location,
+                      const core::Speed& speed,
+                      const core::Angle& angle);
+  void emitBubble(world::World& world, const Location& location);
+  void emitLava(world::World& world, const Location& location);
+  void emitSparkle(world::World& world, const Location& location);
+  void emitSplash(world::World& world, const Location& location, bool waterfall);
+
+  void update(world::World& world);
+  //! streams camera facing quads of all particles within visible rooms
+  void render(world::World& world, const render::scene::Camera& camera);
+  //! removes all particles, e.g. when a savegame is loaded
+  void clear();
+
+  [[nodiscard]] size_t size() const
+  {
+    return m_kinds.size();
+  }
+
+private:
+  void emit(world::World& world,
+            Kind kind,
+            const Location& location,
+            const core::TRVec& velocity,
+            const core::Length& gravity,
+            uint16_t firstFrame);
+  void erase(size_t i);
+
+  void move();
+  void collide(world::World& world);
+  void compact();
+  void initMesh(world::World& world);
+
+  std::vector<Kind> m_kinds;
+  std::vector<int32_t> m_x;
+  std::vector<int32_t> m_y;
+  std::vector<int32_t> m_z;
+  std::vector<int32_t> m_velocityX;
+  std::vector<int32_t> m_velocityY;
+  std::vector<int32_t> m_velocityZ;
+  std::vector<int32_t> m_gravity;
+  std::vector<uint16_t> m_ages;
+  //! 0 for particles living until they collide
+  std::vector<uint16_t> m_lifetimes;
+  std::vector<uint16_t> m_firstFrames;
+  std::vector<uint8_t> m_dead;
+  std::vector<const world::Room*> m_rooms;
+
+  std::vector<render::scene::SpriteVertex> m_vertices;
+  std::vector<uint32_t> m_indices;
+  std::shared_ptr<render::scene::Node> m_node;
+  std::shared_ptr<gl::VertexBuffer<render::scene::SpriteVertex>> m_vertexBuffer;
+  std::shared_ptr<gl::ElementArrayBuffer<uint32_t>> m_indexBuffer;
+};
+} // namespace engine
@@ -6,6 +6,7 @@
 #include "core/i18n.h"
 #include "hid/actions.h"
 #include "hid/inputhandler.h"
+#include "lightclusters.h"
 #include "objectmanager.h"
 #include "objects/laraobject.h"
 #include "objects/object.h"
@@ -16,6 +17,7 @@
 #include "render/rendersettings.h"
 #include "render/scene/camera.h"
 #include "render/scene/csm.h"
+#include "render/scene/culling.h"
 #include "render/scene/material.h"
 #include "render/scene/materialmanager.h"
 #include "render/scene/mesh.h"
@@ -27,6 +29,7 @@
 #include "render/scene/screenoverlay.h"
 #include "render/scene/shadercache.h"
 #include "render/scene/visitor.h"
+#include "render/texturestreamer.h"
 #include "ui/text.h"
 #include "ui/ui.h"
 #include "util/helpers.h"
@@ -111,9 +114,18 @@ void Presenter::renderWorld(const ObjectManager& objectManager,
                             const std::vector<world::Room>& rooms,
                             const CameraController& cameraController,
                             const std::unordered_set<const world::Portal*>& waterEntryPortals,
-                            float waitRatio)
+                            float waitRatio,
+                            const std::function<void()>& prepareScene)
 {
+  const auto bindStats = std::exchange(render::scene::Material::getBindStats(), {});
+  gl::RenderState::getStats() = {};
+  render::scene::getCullingStats() = {};
+
+  m_renderPipeline->updateDynamicResolution(*m_materialManager, 1 - waitRatio);
+  m_renderer->getCamera()->setRenderSize(m_renderPipeline->getRenderSize());
   m_renderPipeline->updateCamera(m_renderer->getCamera());
+  m_lightClusters->update(rooms, m_lightCollectionDepth, *m_renderer->getCamera());
+  prepareScene();
 
   {
     SOGLB_DEBUGGROUP("csm-pass");
@@ -122,25 +134,38 @@ void Presenter::renderWorld(const ObjectManager& objectManager,
     m_csm->updateCamera(*m_renderer->getCamera());
     m_csm->applyViewport();
 
-    for(const auto& texture : m_csm->getDepthTextures())
-      texture->getTexture()->clear(gl::ScalarDepth{1.0f});
+    // occluders may be slightly outside of the room they're assigned to
+    static const glm::vec3 cullingMargin{core::SectorSize.get<float>()};
 
+    const auto depthTextures = m_csm->getDepthTextures();
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
+      if(!m_csm->isSplitDue(i))
+        continue;
+
       SOGLB_DEBUGGROUP("csm-pass/" + std::to_string(i));
 
+      depthTextures[i]->getTexture()->clear(gl::ScalarDepth{1.0f});
       m_csm->setActiveSplit(i);
       m_csm->getActiveFramebuffer()->bindWithAttachments();
 
-      render::scene::RenderContext context{render::scene::RenderMode::CSMDepthOnly,
-                                           m_csm->getActiveMatrix(glm::mat4{1.0f})};
+      const auto lightViewProjection = m_csm->getActiveMatrix(glm::mat4{1.0f});
+      render::scene::RenderContext context{render::scene::RenderMode::CSMDepthOnly, lightViewProjection};
       render::scene::Visitor visitor{context, false};
+      const render::scene::Frustum frustum{lightViewProjection};
 
       for(const auto& room : rooms)
       {
         if(!room.node->isVisible())
           continue;
 
+        if(frustum.isOutside(
+             render::scene::Bounds{room.renderBoundsMin, room.renderBoundsMax}.broadened(cullingMargin)))
+        {
+          SOGLB_DEBUGGROUP(room.node->getName() + " <culled>");
+          continue;
+        }
+
         for(const auto& child : room.node->getChildren())
         {
           visitor.visit(*child);
@@ -150,22 +175,30 @@ void Presenter::renderWorld(const ObjectManager& objectManager,
 
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
+      if(!m_csm->isSplitDue(i))
+        continue;
+
       SOGLB_DEBUGGROUP("csm-pass-square/" + std::to_string(i));
       m_csm->setActiveSplit(i);
       m_csm->renderSquare();
     }
     for(size_t i = 0; i < render::scene::CSMBuffer::NSplits; ++i)
     {
+      if(!m_csm->isSplitDue(i))
+        continue;
+
       SOGLB_DEBUGGROUP("csm-pass-blur/" + std::to_string(i));
       m_csm->setActiveSplit(i);
       m_csm->renderBlur();
     }
   }
+  const auto csmStateStats = std::exchange(gl::RenderState::getStats(), {});
+  gl::RenderState::Stats depthStateStats;
 
   {
     SOGLB_DEBUGGROUP("geometry-pass");
     gl::RenderState::resetWantedState();
-    m_renderPipeline->bindGeometryFrameBuffer(m_window->getViewport(), cameraController.getCamera()->getFarPlane());
+    m_renderPipeline->bindGeometryFrameBuffer(cameraController.getCamera()->getFarPlane());
 
     {
       SOGLB_DEBUGGROUP("depth-prefill-pass");
@@ -178,16 +211,14 @@ void Presenter::renderWorld(const ObjectManager& objectManager,
 
         SOGLB_DEBUGGROUP(room.node->getName());
         context.setCurrentNode(room.node.get());
-        auto state = context.getCurrentState();
-        state.setScissorTest(true);
         const auto [xy, size] = room.node->getCombinedScissors();
-        state.setScissorRegion(xy, size);
-        context.pushState(state);
+        context.pushScissors(true, xy, size);
         room.node->getRenderable()->render(context);
         context.popState();
       }
       if constexpr(render::pass::FlushPasses)
         GL_ASSERT(gl::api::finish());
+      depthStateStats = std::exchange(gl::RenderState::getStats(), {});
     }
 
     gl::RenderState::resetWantedState();
@@ -196,6 +227,7 @@ void Presenter::renderWorld(const ObjectManager& objectManager,
     if constexpr(render::pass::FlushPasses)
       GL_ASSERT(gl::api::finish());
   }
+  const auto geometryStateStats = std::exchange(gl::RenderState::getStats(), {});
 
   {
     SOGLB_DEBUGGROUP("portal-depth-pass");
@@ -225,6 +257,73 @@ void Presenter::renderWorld(const ObjectManager& objectManager,
       glm::ivec2{m_screenOverlay->getImage()->getSize().x - 80, m_screenOverlay->getImage()->getSize().y - 40},
       gl::SRGBA8{255},
       DebugTextFontSize);
+    m_debugFont->drawText(*m_screenOverlay->getImage(),
+                          ("bind " + std::to_string(bindStats.applied) + " skip " + std::to_string(bindStats.skipped))
+                            .c_str(),
+                          glm::ivec2{m_screenOverlay->getImage()->getSize().x - 200,
+                                     m_screenOverlay->getImage()->getSize().y - 20},
+                          gl::SRGBA8{255},
+                          DebugTextFontSize);
+    const auto& cullingStats = render::scene::getCullingStats();
+    m_debugFont->drawText(*m_screenOverlay->getImage(),
+                          ("culled " + std::to_string(cullingStats.culled) + "/" + std::to_string(cullingStats.tested))
+                            .c_str(),
+                          glm::ivec2{m_screenOverlay->getImage()->getSize().x - 400,
+                                     m_screenOverlay->getImage()->getSize().y - 140},
+                          gl::SRGBA8{255},
+                          DebugTextFontSize);
+    const auto formatStateStats = [](const char* pass, const gl::RenderState::Stats& stats)
+    { return std::string{pass} + " " + std::to_string(stats.applied) + "/" + std::to_string(stats.skipped); };
+    m_debugFont->drawText(*m_screenOverlay->getImage(),
+                          ("states " + formatStateStats("csm", csmStateStats) + " "
+                           + formatStateStats("depth", depthStateStats) + " "
+                           + formatStateStats("geometry", geometryStateStats))
+                            .c_str(),
+                          glm::ivec2{m_screenOverlay->getImage()->getSize().x - 400,
+                                     m_screenOverlay->getImage()->getSize().y - 120},
+                          gl::SRGBA8{255},
+                          DebugTextFontSize);
+    m_debugFont->drawText(*m_screenOverlay->getImage(),
+                          ("scale " + std::to_string(m_renderPipeline->getRenderScale())).c_str(),
+                          glm::ivec2{m_screenOverlay->getImage()->getSize().x - 200,
+                                     m_screenOverlay->getImage()->getSize().y - 60},
+                          gl::SRGBA8{255},
+                          DebugTextFontSize);
+    if(m_framePacingStats.frames > 0)
+    {
+      m_debugFont->drawText(*m_screenOverlay->getImage(),
+                            ("frames " + std::to_string(m_framePacingStats.frames) + " missed "
+                             + std::to_string(m_framePacingStats.missedDeadlines) + " resyncs "
+                             + std::to_string(m_framePacingStats.resyncs) + " median "
+                             + std::to_string(m_framePacingStats.getPercentile(0.5f)) + " ms 99% "
+                             + std::to_string(m_framePacingStats.getPercentile(0.99f)) + " ms")
+                              .c_str(),
+                            glm::ivec2{m_screenOverlay->getImage()->getSize().x - 400,
+                                       m_screenOverlay->getImage()->getSize().y - 160},
+                            gl::SRGBA8{255},
+                            DebugTextFontSize);
+    }
+    if(const auto textureStreamer = m_textureStreamer.lock())
+    {
+      const auto& stats = textureStreamer->getStats();
+      m_debugFont->drawText(*m_screenOverlay->getImage(),
+                            ("tex " + std::to_string(stats.resident) + "/" + std::to_string(stats.pages) + " slots "
+                             + std::to_string(stats.slots) + " missing " + std::to_string(stats.missing) + " "
+                             + std::to_string((stats.residentBytes + stats.fallbackBytes) / 1024 / 1024) + " MB")
+                              .c_str(),
+                            glm::ivec2{m_screenOverlay->getImage()->getSize().x - 400,
+                                       m_screenOverlay->getImage()->getSize().y - 80},
+                            gl::SRGBA8{255},
+                            DebugTextFontSize);
+      m_debugFont->drawText(*m_screenOverlay->getImage(),
+                            ("uploads " + std::to_string(stats.uploads) + " evictions "
+                             + std::to_string(stats.evictions))
+                              .c_str(),
+                            glm::ivec2{m_screenOverlay->getImage()->getSize().x - 400,
+                                       m_screenOverlay->getImage()->getSize().y - 100},
+                            gl::SRGBA8{255},
+                            DebugTextFontSize);
+    }
 
     const auto drawObjectName = [this](const std::shared_ptr<objects::Object>& object, const gl::SRGBA8& color)
     {
@@ -382,9 +481,11 @@ Presenter::Presenter(const std::filesystem::path& engineDataPath, const glm::ive
     , m_shaderCache{std::make_shared<render::scene::ShaderCache>(engineDataPath / "shaders")}
     , m_materialManager{std::make_unique<render::scene::MaterialManager>(m_shaderCache, m_renderer)}
     , m_csm{std::make_shared<render::scene::CSM>(1024, *m_materialManager)}
+    , m_lightClusters{std::make_unique<LightClusters>()}
     , m_renderPipeline{std::make_unique<render::RenderPipeline>(*m_materialManager, m_window->getViewport())}
 {
   m_materialManager->setCSM(gsl::not_null{m_csm});
+  m_materialManager->setLightClusters(m_lightClusters->getClustersBuffer(), m_lightClusters->getIndicesBuffer());
   scaleSplashImage();
   drawLoadingScreen(_("Booting"));
 }
@@ -442,14 +543,16 @@ void Presenter::drawLoadingScreen(const std::string& state)
   swapBuffers();
 }
 
-bool Presenter::preFrame()
+bool Presenter::beginFrame()
 {
+  glfwPollEvents();
   m_window->updateWindowSize();
   if(m_window->isMinimized())
     return false;
 
   m_renderer->getCamera()->setScreenSize(m_window->getViewport());
   m_renderPipeline->resize(*m_materialManager, m_window->getViewport());
+  m_renderer->getCamera()->setRenderSize(m_renderPipeline->getRenderSize());
   if(m_screenOverlay != nullptr)
   {
     if(m_screenOverlay->getImage()->getSize() != m_window->getViewport())
@@ -460,6 +563,19 @@ bool Presenter::preFrame()
     m_screenOverlay->getImage()->fill({0, 0, 0, 0});
   }
 
+  m_renderer->clear(
+    gl::api::ClearBufferMask::ColorBufferBit | gl::api::ClearBufferMask::DepthBufferBit, {0, 0, 0, 0}, 1);
+
+  return true;
+}
+
+bool Presenter::preFrame()
+{
+  // sample the input as late as possible before the simulation; events arriving while the frame was paced would
+  // otherwise only be seen a frame later
+  if(!beginFrame())
+    return false;
+
   m_inputHandler->update();
 
   if(m_inputHandler->hasDebouncedAction(hid::Action::Debug))
@@ -467,12 +583,21 @@ bool Presenter::preFrame()
     m_showDebugInfo = !m_showDebugInfo;
   }
 
-  m_renderer->clear(
-    gl::api::ClearBufferMask::ColorBufferBit | gl::api::ClearBufferMask::DepthBufferBit, {0, 0, 0, 0}, 1);
-
   return true;
 }
 
+bool Presenter::preInterpolatedFrame()
+{
+  // the input is only sampled before simulation ticks, otherwise actions pressed between two ticks would not be seen as
+  // debounced by the next tick
+  return beginFrame();
+}
+
+int Presenter::getRefreshRate() const
+{
+  return m_window->getRefreshRate();
+}
+
 bool Presenter::shouldClose() const
 {
   return m_window->windowShouldClose();
@@ -508,6 +633,8 @@ void Presenter::apply(const render::RenderSettings& renderSettings, const AudioS
     m_csm = std::make_shared<render::scene::CSM>(renderSettings.getCSMResolution(), *m_materialManager);
     m_materialManager->setCSM(gsl::not_null{m_csm});
   }
+  m_csm->setFarSplitInterval(renderSettings.getCSMFarSplitInterval());
+  m_lightCollectionDepth = renderSettings.getLightCollectionDepth();
   m_renderPipeline->apply(renderSettings, *m_materialManager);
   m_materialManager->setFiltering(renderSettings.bilinearFiltering, gsl::narrow<float>(renderSettings.anisotropyLevel));
   m_soundEngine->setListenerGain(audioSettings.globalVolume);
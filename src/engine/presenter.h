@@ -3,10 +3,13 @@
 #include "core/magic.h"
 #include "core/units.h"
 #include "qs/quantity.h"
+#include "throttler.h"
 
 #include <array>
 #include <boost/assert.hpp>
+#include <cstddef>
 #include <filesystem>
+#include <functional>
 #include <gl/cimgwrapper.h>
 #include <gl/pixel.h>
 #include <gl/soglb_fwd.h> // IWYU pragma: keep
@@ -43,6 +46,7 @@ namespace render
 {
 class RenderPipeline;
 struct RenderSettings;
+class TextureStreamer;
 } // namespace render
 
 namespace render::scene
@@ -65,6 +69,7 @@ namespace engine
 {
 class ObjectManager;
 class CameraController;
+class LightClusters;
 struct AudioSettings;
 
 class Presenter final
@@ -79,11 +84,13 @@ public:
 
   void playVideo(const std::filesystem::path& path);
 
+  //! prepareScene is called once the camera is set up, right before the scene is drawn
   void renderWorld(const ObjectManager& objectManager,
                    const std::vector<world::Room>& rooms,
                    const CameraController& cameraController,
                    const std::unordered_set<const world::Portal*>& waterEntryPortals,
-                   float waitRatio);
+                   float waitRatio,
+                   const std::function<void()>& prepareScene);
 
   [[nodiscard]] const auto& getSoundEngine() const
   {
@@ -100,6 +107,22 @@ public:
     return m_materialManager;
   }
 
+  [[nodiscard]] const LightClusters& getLightClusters() const
+  {
+    return *m_lightClusters;
+  }
+
+  void setTextureStreamer(const std::shared_ptr<render::TextureStreamer>& textureStreamer)
+  {
+    m_textureStreamer = textureStreamer;
+  }
+
+  //! shown with the debug info
+  void setFramePacingStats(const Throttler::Stats& stats)
+  {
+    m_framePacingStats = stats;
+  }
+
   void setHealthBarTimeout(const core::Frame& f)
   {
     m_healthBarTimeout = f;
@@ -140,6 +163,9 @@ public:
 
   void drawLoadingScreen(const std::string& state);
   bool preFrame();
+  //! prepares a frame rendered between simulation ticks
+  bool preInterpolatedFrame();
+  [[nodiscard]] int getRefreshRate() const;
   [[nodiscard]] bool shouldClose() const;
 
   void setTrFont(std::unique_ptr<ui::TRFont>&& font);
@@ -185,6 +211,10 @@ private:
   const gsl::not_null<std::shared_ptr<render::scene::ShaderCache>> m_shaderCache;
   const gsl::not_null<std::unique_ptr<render::scene::MaterialManager>> m_materialManager;
   std::shared_ptr<render::scene::CSM> m_csm{};
+  const gsl::not_null<std::unique_ptr<LightClusters>> m_lightClusters;
+  size_t m_lightCollectionDepth = 1;
+  std::weak_ptr<render::TextureStreamer> m_textureStreamer;
+  Throttler::Stats m_framePacingStats{};
 
   const gsl::not_null<std::unique_ptr<render::RenderPipeline>> m_renderPipeline;
   std::unique_ptr<render::scene::ScreenOverlay> m_screenOverlay;
@@ -192,5 +222,6 @@ private:
   bool m_showDebugInfo = false;
 
   void scaleSplashImage();
+  bool beginFrame();
 };
 } // namespace engine
@@ -0,0 +1,117 @@
+#include "renderinterpolator.h"
+
+#include "core/interpolation.h"
+#include "objectmanager.h"
+#include "objects/object.h"
+#include "render/scene/camera.h"
+#include "render/scene/node.h"
+#include "skeletalmodelnode.h"
+
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include <glm/vec3.hpp>
+#include <utility>
+
+namespace engine
+{
+namespace
+{
+// movements longer than this within a single tick are teleports, e.g. room swaps or respawns
+constexpr float MaxInterpolationDistance = 2048;
+
+template<typename F>
+void forEachNode(const ObjectManager& objectManager, const F& f)
+{
+  for(const auto& [id, object] : objectManager.getObjects())
+  {
+    if(const auto& node = object->getNode(); node != nullptr)
+      f(node);
+  }
+  for(const auto& object : objectManager.getDynamicObjects())
+  {
+    if(const auto& node = object->getNode(); node != nullptr)
+      f(node);
+  }
+}
+
+bool isTeleport(const glm::mat4& previous, const glm::mat4& current)
+{
+  return glm::distance(glm::vec3{previous[3]}, glm::vec3{current[3]}) > MaxInterpolationDistance;
+}
+} // namespace
+
+void RenderInterpolator::beginTick(const ObjectManager& objectManager, const render::scene::Camera& camera)
+{
+  m_previousMatrices.clear();
+  m_previousBoneCounts.clear();
+  forEachNode(objectManager,
+              [this](const std::shared_ptr<render::scene::Node>& node)
+              {
+                m_previousMatrices.emplace(node.get(), node->getLocalMatrix());
+                if(const auto skeleton = std::dynamic_pointer_cast<SkeletalModelNode>(node))
+                {
+                  skeleton->storePreviousPose();
+                  m_previousBoneCounts.emplace(skeleton.get(), skeleton->getBoneCount());
+                }
+              });
+
+  m_previousCameraTransform = camera.getInverseViewMatrix();
+}
+
+void RenderInterpolator::endTick(const ObjectManager& objectManager, render::scene::Camera& camera)
+{
+  m_nodes.clear();
+  m_skeletons.clear();
+  forEachNode(objectManager,
+              [this](const std::shared_ptr<render::scene::Node>& node)
+              {
+                const auto it = m_previousMatrices.find(node.get());
+                if(it == m_previousMatrices.end())
+                  return;
+
+                const auto& current = node->getLocalMatrix();
+                if(!isTeleport(it->second, current))
+                  m_nodes.emplace_back(NodeState{node, it->second, current});
+
+                if(const auto skeleton = std::dynamic_pointer_cast<SkeletalModelNode>(node))
+                {
+                  const auto boneCount = m_previousBoneCounts.find(skeleton.get());
+                  if(boneCount != m_previousBoneCounts.end() && boneCount->second == skeleton->getBoneCount())
+                    m_skeletons.emplace_back(skeleton);
+                }
+              });
+
+  m_camera = &camera;
+  m_currentCameraView = camera.getViewMatrix();
+  m_currentCameraTransform = camera.getInverseViewMatrix();
+  if(isTeleport(m_previousCameraTransform, m_currentCameraTransform))
+    m_previousCameraTransform = m_currentCameraTransform;
+}
+
+void RenderInterpolator::apply(const float bias)
+{
+  m_applied = true;
+  for(const auto& state : m_nodes)
+    state.node->setLocalMatrix(core::interpolateTransform(state.previous, state.current, bias));
+  for(const auto& skeleton : m_skeletons)
+    skeleton->setPoseInterpolation(bias);
+
+  if(m_camera != nullptr)
+    m_camera->setViewMatrix(
+      glm::inverse(core::interpolateTransform(m_previousCameraTransform, m_currentCameraTransform, bias)));
+}
+
+void RenderInterpolator::restore()
+{
+  if(!std::exchange(m_applied, false))
+    return;
+
+  for(const auto& state : m_nodes)
+    state.node->setLocalMatrix(state.current);
+  for(const auto& skeleton : m_skeletons)
+    skeleton->setPoseInterpolation(1);
+
+  if(m_camera != nullptr)
+    m_camera->setViewMatrix(m_currentCameraView);
+}
+} // namespace engine
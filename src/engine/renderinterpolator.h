@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace render::scene
+{
+class Camera;
+class Node;
+} // namespace render::scene
+
+namespace engine
+{
+class ObjectManager;
+class SkeletalModelNode;
+
+// renders object, camera and skeletal poses between the last two simulation ticks, so frames can be presented at
+// display rate while the simulation keeps running at core::FrameRate
+class RenderInterpolator
+{
+public:
+  // captures the state before a simulation tick
+  void beginTick(const ObjectManager& objectManager, const render::scene::Camera& camera);
+  // captures the state after a simulation tick
+  void endTick(const ObjectManager& objectManager, render::scene::Camera& camera);
+
+  // bias 0 shows the state before the last tick, 1 shows the simulated state
+  void apply(float bias);
+  // restores the simulated state, must be called before the next tick
+  void restore();
+
+private:
+  struct NodeState
+  {
+    std::shared_ptr<render::scene::Node> node;
+    glm::mat4 previous;
+    glm::mat4 current;
+  };
+
+  std::unordered_map<const render::scene::Node*, glm::mat4> m_previousMatrices;
+  std::vector<NodeState> m_nodes;
+  std::vector<std::shared_ptr<SkeletalModelNode>> m_skeletons;
+  std::unordered_map<const SkeletalModelNode*, size_t> m_previousBoneCounts;
+
+  bool m_applied = false;
+  render::scene::Camera* m_camera = nullptr;
+  glm::mat4 m_previousCameraTransform{1.0f};
+  glm::mat4 m_currentCameraTransform{1.0f};
+  glm::mat4 m_currentCameraView{1.0f};
+};
+} // namespace engine
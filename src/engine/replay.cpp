@@ -0,0 +1,165 @@
+#include "replay.h"
+
+#include "hid/actions.h"
+#include "hid/inputhandler.h"
+#include "presenter.h"
+#include "util/helpers.h"
+#include "world/world.h"
+
+#include <algorithm>
+#include <boost/log/trivial.hpp>
+#include <boost/throw_exception.hpp>
+#include <fstream>
+#include <gsl/gsl-lite.hpp>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace engine
+{
+namespace
+{
+uint32_t getActionBit(const hid::Action action)
+{
+  const auto bit = static_cast<uint32_t>(action);
+  Expects(bit < 32);
+  return 1u << bit;
+}
+
+Replay::Frame encode(const hid::InputState& inputState)
+{
+  Replay::Frame frame{};
+  for(const auto& [action, button] : inputState.actions)
+  {
+    if(button.current)
+      frame.actions |= getActionBit(action);
+  }
+  frame.axes = gsl::narrow_cast<uint8_t>(static_cast<uint8_t>(inputState.xMovement.current)
+                                         | (static_cast<uint8_t>(inputState.zMovement.current) << 2u)
+                                         | (static_cast<uint8_t>(inputState.stepMovement.current) << 4u));
+  frame.randomState = util::getRandomState();
+  return frame;
+}
+
+void decode(const Replay::Frame& frame, hid::InputState& inputState)
+{
+  for(auto& [action, button] : inputState.actions)
+    button = (frame.actions & getActionBit(action)) != 0;
+  inputState.xMovement = static_cast<hid::AxisMovement>(frame.axes & 3u);
+  inputState.zMovement = static_cast<hid::AxisMovement>((frame.axes >> 2u) & 3u);
+  inputState.stepMovement = static_cast<hid::AxisMovement>((frame.axes >> 4u) & 3u);
+}
+} // namespace
+
+Replay::Replay(world::World& world)
+{
+  m_file.title = world.getTitle();
+  m_file.keyframes.emplace(0, world.createKeyframe());
+  m_file.restorePoints.emplace(0);
+}
+
+Replay::Replay(const std::filesystem::path& filename)
+{
+  std::ifstream file{filename, std::ios::in | std::ios::binary};
+  if(!file.is_open())
+    BOOST_THROW_EXCEPTION(std::runtime_error("Failed to open replay " + filename.string()));
+
+  readReplay(file, m_file);
+  if(m_file.restorePoints.count(0) == 0)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Replay has no initial state"));
+
+  BOOST_LOG_TRIVIAL(info) << "Loaded replay " << filename << " with " << m_file.frames.size() << " frames";
+}
+
+void Replay::record(const hid::InputState& inputState)
+{
+  m_file.frames.emplace_back(encode(inputState));
+}
+
+void Replay::addRestorePoint(world::World& world)
+{
+  m_file.keyframes[m_file.frames.size()] = world.createKeyframe();
+  m_file.restorePoints.emplace(m_file.frames.size());
+}
+
+void Replay::write(const std::filesystem::path& filename) const
+{
+  std::ofstream file{filename, std::ios::out | std::ios::trunc | std::ios::binary};
+  if(!file.is_open())
+  {
+    BOOST_LOG_TRIVIAL(error) << "Failed to write replay " << filename;
+    return;
+  }
+
+  writeReplay(file, m_file);
+  BOOST_LOG_TRIVIAL(info) << "Wrote replay " << filename << " with " << m_file.frames.size() << " frames";
+}
+
+void Replay::rewind(world::World& world)
+{
+  if(world.getTitle() != m_file.title)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Replay is for level " + m_file.title + ", but current level is "
+                                             + world.getTitle()));
+
+  restore(world, 0);
+}
+
+void Replay::seek(world::World& world, size_t frame, const bool godMode)
+{
+  frame = std::min(frame, m_file.frames.size());
+
+  // the map always contains the initial state
+  const auto keyframe = std::prev(m_file.keyframes.upper_bound(frame));
+  if(frame < m_position || keyframe->first > m_position)
+    restore(world, keyframe->first);
+
+  auto& inputHandler = world.getPresenter().getInputHandler();
+  const auto liveState = inputHandler.getInputState();
+  while(m_position < frame)
+  {
+    inputHandler.setInputState(playFrame(world));
+    world.simulateFrame(godMode);
+  }
+  inputHandler.setInputState(liveState);
+}
+
+const hid::InputState& Replay::playFrame(world::World& world)
+{
+  Expects(!isFinished());
+
+  if(!std::exchange(m_restored, false))
+  {
+    if(m_file.restorePoints.count(m_position) != 0)
+    {
+      restore(world, m_position);
+      m_restored = false;
+    }
+    else if(m_position % KeyframeInterval == 0 && m_file.keyframes.count(m_position) == 0)
+    {
+      m_file.keyframes.emplace(m_position, world.createKeyframe());
+    }
+  }
+
+  const auto& frame = m_file.frames[m_position];
+  if(util::getRandomState() != frame.randomState && !std::exchange(m_desyncReported, true))
+    BOOST_LOG_TRIVIAL(warning) << "Replay desynchronized at frame " << m_position;
+
+  decode(frame, m_inputState);
+  ++m_position;
+  return m_inputState;
+}
+
+void Replay::restore(world::World& world, const size_t frame)
+{
+  world.restoreKeyframe(m_file.keyframes.at(frame));
+  m_position = frame;
+  m_restored = true;
+
+  // the debounced input state needs the input of the previous frame
+  m_inputState = hid::InputState{};
+  if(frame > 0)
+    decode(m_file.frames.at(frame - 1), m_inputState);
+  if(frame < m_file.frames.size())
+    util::setRandomState(m_file.frames[frame].randomState);
+}
+} // namespace engine
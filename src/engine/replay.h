@@ -0,0 +1,70 @@
+#pragma once
+
+#include "hid/inputstate.h"
+#include "replayfile.h"
+
+#include <cstddef>
+#include <filesystem>
+
+namespace engine::world
+{
+class World;
+} // namespace engine::world
+
+namespace engine
+{
+// Records the input and the random number generator state of each simulated frame, so a play session can be replayed
+// bit-exactly from the world state it started with. While playing back, snapshots of the world are kept in memory at
+// fixed intervals, so seeking only needs to simulate the frames since the closest snapshot.
+class Replay final
+{
+public:
+  //! frames between the in-memory snapshots used for seeking
+  static constexpr size_t KeyframeInterval = 300;
+
+  using Frame = ReplayFrame;
+
+  //! starts a recording from the current state of the world
+  explicit Replay(world::World& world);
+  //! loads a recording for playback
+  explicit Replay(const std::filesystem::path& filename);
+
+  void record(const hid::InputState& inputState);
+  //! stores the world state to be restored when playing back the next frame, for changes made outside of the
+  //! simulation, e.g. in the inventory
+  void addRestorePoint(world::World& world);
+  void write(const std::filesystem::path& filename) const;
+
+  //! restores the world state the recording started with
+  void rewind(world::World& world);
+  //! simulates the frames from the closest snapshot until the given frame is the next one to be played
+  void seek(world::World& world, size_t frame, bool godMode);
+  //! prepares the world for the next frame and returns its input; the caller simulates the frame
+  [[nodiscard]] const hid::InputState& playFrame(world::World& world);
+
+  [[nodiscard]] bool isFinished() const
+  {
+    return m_position >= m_file.frames.size();
+  }
+
+  [[nodiscard]] size_t getPosition() const
+  {
+    return m_position;
+  }
+
+  [[nodiscard]] size_t size() const
+  {
+    return m_file.frames.size();
+  }
+
+private:
+  void restore(world::World& world, size_t frame);
+
+  //! during playback, the keyframes also contain the snapshots taken for seeking
+  ReplayFile m_file;
+  size_t m_position = 0;
+  bool m_restored = false;
+  bool m_desyncReported = false;
+  hid::InputState m_inputState{};
+};
+} // namespace engine
@@ -0,0 +1,95 @@
+#include "replayfile.h"
+
+#include "util/binaryio.h"
+
+#include <boost/throw_exception.hpp>
+#include <gsl/gsl-lite.hpp>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+namespace engine
+{
+namespace
+{
+// "ERPL"
+constexpr uint32_t Magic = 0x4c505245u;
+constexpr uint32_t Version = 1;
+constexpr size_t FrameSize
+  = sizeof(ReplayFrame::actions) + sizeof(ReplayFrame::axes) + sizeof(ReplayFrame::randomState);
+
+template<typename T>
+T read(std::istream& stream)
+{
+  T value{};
+  if(!util::readValue(stream, value))
+    BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected end of replay"));
+  return value;
+}
+
+std::string readString(std::istream& stream)
+{
+  std::string value;
+  if(!util::readString(stream, value))
+    BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected end of replay"));
+  return value;
+}
+} // namespace
+
+void writeReplay(std::ostream& stream, const ReplayFile& replay)
+{
+  util::writeValue(stream, Magic);
+  util::writeValue(stream, Version);
+  util::writeString(stream, replay.title);
+  // the frames are written field by field, so the padding of the struct doesn't end up in the file
+  util::writeValue(stream, gsl::narrow<uint32_t>(replay.frames.size()));
+  for(const auto& frame : replay.frames)
+  {
+    util::writeValue(stream, frame.actions);
+    util::writeValue(stream, frame.axes);
+    util::writeValue(stream, frame.randomState);
+  }
+
+  util::writeValue(stream, gsl::narrow<uint32_t>(replay.restorePoints.size()));
+  for(const auto frame : replay.restorePoints)
+  {
+    util::writeValue(stream, gsl::narrow<uint32_t>(frame));
+    util::writeString(stream, replay.keyframes.at(frame));
+  }
+}
+
+void readReplay(std::istream& stream, ReplayFile& replay)
+{
+  if(read<uint32_t>(stream) != Magic)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Not a replay"));
+  if(const auto version = read<uint32_t>(stream); version != Version)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Unsupported replay version " + std::to_string(version)));
+
+  replay.title = readString(stream);
+
+  const auto frames = read<uint32_t>(stream);
+  if(const auto remaining = util::getRemainingSize(stream);
+     remaining >= 0 && uint64_t{frames} * FrameSize > static_cast<uint64_t>(remaining))
+  {
+    BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected end of replay"));
+  }
+  replay.frames.resize(frames);
+  for(auto& frame : replay.frames)
+  {
+    frame.actions = read<uint32_t>(stream);
+    frame.axes = read<uint8_t>(stream);
+    frame.randomState = read<uint32_t>(stream);
+  }
+
+  replay.keyframes.clear();
+  replay.restorePoints.clear();
+  const auto restorePoints = read<uint32_t>(stream);
+  for(uint32_t i = 0; i < restorePoints; ++i)
+  {
+    const auto frame = read<uint32_t>(stream);
+    replay.keyframes.emplace(frame, readString(stream));
+    replay.restorePoints.emplace(frame);
+  }
+}
+} // namespace engine
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace engine
+{
+struct ReplayFrame
+{
+  //! one bit per action, indexed by the action's value
+  uint32_t actions = 0;
+  //! two bits per movement axis
+  uint8_t axes = 0;
+  //! state of the random number generator before the frame was simulated
+  uint32_t randomState = 0;
+};
+
+struct ReplayFile
+{
+  std::string title;
+  std::vector<ReplayFrame> frames;
+  //! world snapshots by the frame played next after restoring them
+  std::map<size_t, std::string> keyframes;
+  //! keyframes which are part of the recording and must be restored during playback
+  std::set<size_t> restorePoints;
+};
+
+//! only the keyframes which are restore points are written
+extern void writeReplay(std::ostream& stream, const ReplayFile& replay);
+//! throws if the data is not a replay or is truncated
+extern void readReplay(std::istream& stream, ReplayFile& replay);
+} // namespace engine
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <gsl/gsl-lite.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace engine
+{
+// groups objects by the room they are in, so queries around a room only visit the objects of the rooms involved
+template<typename TRoom, typename TObject>
+class RoomIndex
+{
+public:
+  using Objects = std::vector<gsl::not_null<TObject*>>;
+
+  void insert(TObject* object, const TRoom* room)
+  {
+    Expects(object != nullptr);
+    if(const auto [it, inserted] = m_rooms.emplace(object, room); !inserted)
+    {
+      if(it->second == room)
+        return;
+      swapRemove(m_objectsByRoom[it->second], object);
+      it->second = room;
+    }
+    m_objectsByRoom[room].emplace_back(object);
+  }
+
+  void erase(const TObject* object)
+  {
+    const auto it = m_rooms.find(object);
+    if(it == m_rooms.end())
+      return;
+
+    swapRemove(m_objectsByRoom[it->second], object);
+    m_rooms.erase(it);
+  }
+
+  //! moves an indexed object to another room; objects not indexed are ignored
+  void update(TObject* object, const TRoom* room)
+  {
+    const auto it = m_rooms.find(object);
+    if(it == m_rooms.end() || it->second == room)
+      return;
+
+    swapRemove(m_objectsByRoom[it->second], object);
+    it->second = room;
+    m_objectsByRoom[room].emplace_back(object);
+  }
+
+  void clear()
+  {
+    m_objectsByRoom.clear();
+    m_rooms.clear();
+  }
+
+  //! the order of the objects within a room is not stable
+  [[nodiscard]] const Objects& getObjects(const TRoom* room) const
+  {
+    static const Objects empty;
+
+    const auto it = m_objectsByRoom.find(room);
+    return it == m_objectsByRoom.end() ? empty : it->second;
+  }
+
+  [[nodiscard]] auto size() const noexcept
+  {
+    return m_rooms.size();
+  }
+
+private:
+  std::unordered_map<const TRoom*, Objects> m_objectsByRoom;
+  std::unordered_map<const TObject*, const TRoom*> m_rooms;
+
+  static void swapRemove(Objects& objects, const TObject* object)
+  {
+    const auto it
+      = std::find_if(objects.begin(), objects.end(), [object](const auto& entry) { return entry.get() == object; });
+    if(it == objects.end())
+      return;
+
+    *it = objects.back();
+    objects.pop_back();
+  }
+};
+} // namespace engine
@@ -74,10 +74,11 @@ std::unique_ptr<loader::file::level::Level>
   loadLevel(Engine& engine, const std::string& basename, const std::string& title)
 {
   engine.getPresenter().drawLoadingScreen(_("Loading %1%", title));
-  auto level = loader::file::level::Level::createLoader(engine.getUserDataPath() / getLocalLevelPath(basename),
-                                                        loader::file::level::Game::Unknown);
-  level->loadFileData();
-  return level;
+  if(auto level = engine.getLevelPreloader().take(engine.getUserDataPath() / getLocalLevelPath(basename));
+     level != nullptr)
+    return level;
+
+  return loader::file::level::Level::load(engine.getUserDataPath() / getLocalLevelPath(basename));
 }
 } // namespace
 
@@ -131,6 +132,11 @@ std::pair<RunResult, std::optional<size_t>> Cutscene::run(Engine& engine, const
   return engine.run(*world, true, false);
 }
 
+void Cutscene::preload(Engine& engine) const
+{
+  engine.getLevelPreloader().preload(engine.getUserDataPath() / getLocalLevelPath(m_name));
+}
+
 std::unique_ptr<world::World> Level::loadWorld(Engine& engine, const std::shared_ptr<Player>& player)
 {
   engine.getPresenter().debounceInput();
@@ -171,6 +177,11 @@ bool Level::isLevel(const std::filesystem::path& path) const
   return util::preferredEqual(getLocalLevelPath(m_name), path);
 }
 
+void Level::preload(Engine& engine) const
+{
+  engine.getLevelPreloader().preload(engine.getUserDataPath() / getLocalLevelPath(m_name));
+}
+
 std::pair<RunResult, std::optional<size_t>> Level::run(Engine& engine, const std::shared_ptr<Player>& player)
 {
   player->requestedWeaponType = m_defaultWeapon;
@@ -68,6 +68,11 @@ public:
     runFromSave(Engine& /*engine*/, const std::optional<size_t>& /*slot*/, const std::shared_ptr<Player>& /*player*/);
 
   [[nodiscard]] virtual bool isLevel(const std::filesystem::path& path) const = 0;
+
+  //! starts loading the item's data in the background, if it has any
+  virtual void preload(Engine& /*engine*/) const
+  {
+  }
 };
 
 class Level : public LevelSequenceItem
@@ -116,6 +121,8 @@ public:
     runFromSave(Engine& engine, const std::optional<size_t>& slot, const std::shared_ptr<Player>& player) override;
 
   [[nodiscard]] bool isLevel(const std::filesystem::path& path) const override;
+
+  void preload(Engine& engine) const override;
 };
 
 class TitleMenu : public Level
@@ -202,6 +209,8 @@ public:
   {
     return false;
   }
+
+  void preload(Engine& engine) const override;
 };
 
 class SplashScreen : public LevelSequenceItem
@@ -21,10 +21,12 @@
 #include "world/animation.h"
 #include "world/rendermeshdata.h"
 #include "world/skeletalmodeltype.h"
+#include "world/skinnedmesh.h"
 #include "world/transition.h"
 #include "world/world.h"
 
 #include <boost/assert.hpp>
+#include <cstdint>
 #include <exception>
 #include <glm/common.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -32,6 +34,7 @@
 #include <initializer_list>
 #include <stack>
 #include <utility>
+#include <vector>
 
 namespace engine
 {
@@ -274,44 +277,50 @@ void SkeletalModelNode::rebuildMesh()
 
   m_forceMeshRebuild = false;
 
-  world::RenderMeshDataCompositor compositor;
-  for(auto& part : m_meshParts)
+  // only the variant table is updated, unless a mesh is shown on a bone for the first time
+  Expects(m_meshParts.size() <= static_cast<size_t>(world::SkinnedMesh::BoneStride));
+  Expects(m_model->skinnedMesh != nullptr);
+  std::vector<int32_t> variants;
+  variants.reserve(m_meshParts.size());
+  bool anyVisible = false;
+  for(size_t i = 0; i < m_meshParts.size(); ++i)
   {
+    auto& part = m_meshParts[i];
     if(part.mesh == nullptr || !part.visible)
-      compositor.appendEmpty();
+    {
+      variants.emplace_back(world::SkinnedMesh::Hidden);
+    }
     else
-      compositor.append(*part.mesh);
+    {
+      variants.emplace_back(m_model->skinnedMesh->getVariant(i, part.mesh));
+      anyVisible = true;
+    }
 
     part.currentVisible = part.visible;
     part.currentMesh = part.mesh;
   }
 
-  if(compositor.empty())
+  if(!anyVisible)
+  {
     setRenderable(nullptr);
-  else
-    setRenderable(compositor.toMesh(*m_world->getPresenter().getMaterialManager(), true, getName()));
+    return;
+  }
+
+  m_boneMeshBuffer.setData(variants, gl::api::BufferUsage::DynamicDraw);
+  setRenderable(m_model->skinnedMesh->getMesh(*m_world->getPresenter().getMaterialManager()));
 }
 
-bool SkeletalModelNode::canBeCulled(const glm::mat4& viewProjection) const
+std::optional<render::scene::Bounds> SkeletalModelNode::getLocalBounds() const
 {
   auto bbox = getInterpolationInfo().firstFrame->bbox.toBBox();
   bbox.x = bbox.x.broadened(bbox.x.size() / 2);
-  bbox.y = bbox.x.broadened(bbox.y.size() / 2);
-  bbox.z = bbox.x.broadened(bbox.z.size() / 2);
+  bbox.y = bbox.y.broadened(bbox.y.size() / 2);
+  bbox.z = bbox.z.broadened(bbox.z.size() / 2);
 
-  glm::vec2 min{1000.0f}, max{-1000.0f};
-  for(const auto& x : {bbox.x.min, bbox.x.max})
-    for(const auto& y : {bbox.y.min, bbox.y.max})
-      for(const auto& z : {bbox.z.min, bbox.z.max})
-      {
-        const auto v = core::TRVec{x, y, z}.toRenderSystem();
-        auto proj = viewProjection * getModelMatrix() * glm::vec4{v, 1.0f};
-        proj /= proj.w;
-        min = glm::min(min, glm::vec2{proj});
-        max = glm::max(max, glm::vec2{proj});
-      }
-
-  return min.x > 1 || min.y > 1 || max.x < -1 || max.y < -1;
+  // the render system flips y and z
+  const auto a = core::TRVec{bbox.x.min, bbox.y.min, bbox.z.min}.toRenderSystem();
+  const auto b = core::TRVec{bbox.x.max, bbox.y.max, bbox.z.max}.toRenderSystem();
+  return render::scene::Bounds{glm::min(a, b), glm::max(a, b)};
 }
 
 void SkeletalModelNode::setAnim(const gsl::not_null<const world::Animation*>& anim,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/id.h"
+#include "core/interpolation.h"
 #include "core/units.h"
 #include "core/vec.h"
 #include "render/scene/node.h"
@@ -8,6 +9,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <gl/buffer.h>
 #include <glm/fwd.hpp>
 #include <glm/mat4x4.hpp>
@@ -129,7 +131,7 @@ public:
 
   void rebuildMesh();
 
-  [[nodiscard]] bool canBeCulled(const glm::mat4& viewProjection) const override;
+  [[nodiscard]] std::optional<render::scene::Bounds> getLocalBounds() const override;
 
   void setMeshPart(size_t idx, const std::shared_ptr<world::RenderMeshData>& mesh)
   {
@@ -173,11 +175,34 @@ public:
     std::transform(m_meshParts.begin(),
                    m_meshParts.end(),
                    std::back_inserter(matrices),
-                   [](const auto& part) { return part.poseMatrix; });
+                   [this](const auto& part)
+                   {
+                     if(m_poseInterpolation >= 1)
+                       return part.poseMatrix;
+                     return core::interpolateTransform(part.previousPoseMatrix, part.poseMatrix, m_poseInterpolation);
+                   });
     m_meshMatricesBuffer.setData(matrices, gl::api::BufferUsage::DynamicDraw);
     return m_meshMatricesBuffer;
   }
 
+  //! selected mesh variant of every bone in the model's shared skinned mesh
+  [[nodiscard]] const auto& getBoneMeshBuffer() const
+  {
+    return m_boneMeshBuffer;
+  }
+
+  // remembers the current pose as the start of the render interpolation towards the next tick's pose
+  void storePreviousPose()
+  {
+    for(auto& part : m_meshParts)
+      part.previousPoseMatrix = part.poseMatrix;
+  }
+
+  void setPoseInterpolation(float bias)
+  {
+    m_poseInterpolation = bias;
+  }
+
   void clearParts()
   {
     m_meshParts.clear();
@@ -215,6 +240,7 @@ private:
 
     glm::mat4 patch{1.0f};
     glm::mat4 poseMatrix{1.0f};
+    glm::mat4 previousPoseMatrix{1.0f};
     std::shared_ptr<world::RenderMeshData> mesh{nullptr};
     std::shared_ptr<world::RenderMeshData> currentMesh{nullptr};
     bool visible = true;
@@ -233,7 +259,9 @@ private:
   gsl::not_null<const world::SkeletalModelType*> m_model;
   std::vector<MeshPart> m_meshParts{};
   mutable gl::ShaderStorageBuffer<glm::mat4> m_meshMatricesBuffer{"mesh-matrices-ssb"};
+  gl::ShaderStorageBuffer<int32_t> m_boneMeshBuffer{"bone-mesh-ssb"};
   bool m_forceMeshRebuild = false;
+  float m_poseInterpolation = 1;
 
   const world::Animation* m_anim = nullptr;
   core::Frame m_frame = 0_frame;
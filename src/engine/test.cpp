@@ -0,0 +1,370 @@
+#define BOOST_TEST_MODULE engine
+
+#include "interpolatedframes.h"
+#include "replayfile.h"
+#include "roomindex.h"
+#include "throttler.h"
+#include "world/cinematicframe.h"
+
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+engine::ReplayFile createReplay()
+{
+  engine::ReplayFile replay;
+  replay.title = "Caves";
+  for(uint32_t i = 0; i < 1000; ++i)
+    replay.frames.emplace_back(engine::ReplayFrame{i * 7919u, static_cast<uint8_t>(i % 64u), i * 0x41c64e6du});
+  replay.keyframes.emplace(0, std::string{"initial\0state", 13});
+  replay.keyframes.emplace(300, "seek");
+  replay.keyframes.emplace(500, "inventory");
+  replay.restorePoints = {0, 500};
+  return replay;
+}
+
+struct Room
+{
+  std::array<const Room*, 4> neighbours{};
+};
+
+struct Object
+{
+  explicit Object(const Room* room)
+      : room{room}
+  {
+  }
+  virtual ~Object() = default;
+
+  const Room* room;
+};
+
+struct Enemy : Object
+{
+  using Object::Object;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(engine_tests)
+
+BOOST_AUTO_TEST_CASE(test_replay_round_trip)
+{
+  const auto replay = createReplay();
+  std::stringstream stream;
+  engine::writeReplay(stream, replay);
+
+  engine::ReplayFile loaded;
+  engine::readReplay(stream, loaded);
+  BOOST_CHECK_EQUAL(loaded.title, replay.title);
+  BOOST_REQUIRE_EQUAL(loaded.frames.size(), replay.frames.size());
+  for(size_t i = 0; i < replay.frames.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(loaded.frames[i].actions, replay.frames[i].actions);
+    BOOST_CHECK_EQUAL(loaded.frames[i].axes, replay.frames[i].axes);
+    BOOST_CHECK_EQUAL(loaded.frames[i].randomState, replay.frames[i].randomState);
+  }
+  BOOST_CHECK(loaded.restorePoints == replay.restorePoints);
+
+  // the keyframes taken for seeking are not part of the file
+  BOOST_CHECK_EQUAL(loaded.keyframes.size(), 2u);
+  BOOST_CHECK_EQUAL(loaded.keyframes.at(0), replay.keyframes.at(0));
+  BOOST_CHECK_EQUAL(loaded.keyframes.at(500), replay.keyframes.at(500));
+}
+
+BOOST_AUTO_TEST_CASE(test_replay_truncated)
+{
+  std::stringstream stream;
+  engine::writeReplay(stream, createReplay());
+  const auto data = stream.str();
+
+  for(const size_t size : {size_t{0}, size_t{6}, size_t{20}, data.size() / 2, data.size() - 1})
+  {
+    std::stringstream truncated{data.substr(0, size)};
+    engine::ReplayFile loaded;
+    BOOST_CHECK_THROW(engine::readReplay(truncated, loaded), std::runtime_error);
+  }
+
+  std::stringstream garbage{"not a replay at all"};
+  engine::ReplayFile loaded;
+  BOOST_CHECK_THROW(engine::readReplay(garbage, loaded), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_room_index)
+{
+  const std::array<Room, 2> rooms{};
+  Object a{&rooms[0]};
+  Object b{&rooms[0]};
+  engine::RoomIndex<Room, Object> index;
+  index.insert(&a, a.room);
+  index.insert(&b, b.room);
+  BOOST_CHECK_EQUAL(index.getObjects(&rooms[0]).size(), 2u);
+  BOOST_CHECK(index.getObjects(&rooms[1]).empty());
+
+  index.update(&a, &rooms[1]);
+  BOOST_REQUIRE_EQUAL(index.getObjects(&rooms[0]).size(), 1u);
+  BOOST_CHECK(index.getObjects(&rooms[0]).front().get() == &b);
+  BOOST_REQUIRE_EQUAL(index.getObjects(&rooms[1]).size(), 1u);
+  BOOST_CHECK(index.getObjects(&rooms[1]).front().get() == &a);
+
+  // unknown objects are not added by updates
+  Object c{&rooms[1]};
+  index.update(&c, &rooms[1]);
+  BOOST_CHECK_EQUAL(index.getObjects(&rooms[1]).size(), 1u);
+
+  index.erase(&b);
+  index.erase(&b);
+  BOOST_CHECK(index.getObjects(&rooms[0]).empty());
+  BOOST_CHECK_EQUAL(index.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_interpolated_frames)
+{
+  // drives the frame loop of one tick with a simulated clock, the tick itself took the first 20% of the frame
+  struct Clock
+  {
+    float progress = 0.2f;
+    float frameCost = 0.05f;
+    std::vector<float> frames{};
+
+    size_t run(const float minFrameInterval, const size_t maxFrames = 100)
+    {
+      return engine::renderInterpolatedFrames(
+        minFrameInterval,
+        [this]() { return progress; },
+        [this](const float until)
+        {
+          BOOST_CHECK_GT(until, progress);
+          progress = until;
+        },
+        [this, maxFrames](const float bias)
+        {
+          BOOST_CHECK_EQUAL(bias, progress);
+          if(frames.size() == maxFrames)
+            return false;
+
+          frames.emplace_back(bias);
+          progress += frameCost;
+          return true;
+        });
+    }
+  };
+
+  {
+    // without a frame rate cap, frames are rendered back to back until the next one wouldn't finish in time
+    Clock clock;
+    BOOST_CHECK_EQUAL(clock.run(0), 15u);
+    BOOST_CHECK_LE(clock.progress, 1.0f);
+  }
+
+  {
+    // capped to twice the tick rate, only one frame is rendered half a tick after the frame of the tick
+    Clock clock;
+    BOOST_CHECK_EQUAL(clock.run(0.5f), 1u);
+    BOOST_CHECK_CLOSE(clock.frames.at(0), 0.7f, 0.001f);
+  }
+
+  {
+    // capped frames keep their distance, and the last one still finishes before the next tick
+    Clock clock;
+    clock.run(0.25f);
+    BOOST_REQUIRE_EQUAL(clock.frames.size(), 2u);
+    for(size_t i = 1; i < clock.frames.size(); ++i)
+      BOOST_CHECK_GE(clock.frames[i] - clock.frames[i - 1], 0.25f - 0.0001f);
+    BOOST_CHECK_LE(clock.progress, 1.0f);
+  }
+
+  {
+    // frames slower than the cap are not delayed any further
+    Clock clock;
+    clock.frameCost = 0.3f;
+    BOOST_CHECK_EQUAL(clock.run(0.1f), 2u);
+    BOOST_CHECK_CLOSE(clock.frames.at(1), clock.frames.at(0) + 0.3f, 0.001f);
+  }
+
+  {
+    // e.g. the window is closed or minimized
+    Clock clock;
+    BOOST_CHECK_EQUAL(clock.run(0, 2), 2u);
+    BOOST_CHECK_CLOSE(clock.progress, 0.3f, 0.001f);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_frame_time_percentile)
+{
+  engine::Throttler::Stats stats;
+  BOOST_CHECK_EQUAL(stats.getPercentile(0.5f), 0u);
+
+  // 90 frames of 33 ms, 9 frames of 40 ms and one frame longer than the histogram
+  stats.frameTimeHistogram[33] = 90;
+  stats.frameTimeHistogram[40] = 9;
+  stats.frameTimeHistogram.back() = 1;
+  stats.frames = 100;
+  BOOST_CHECK_EQUAL(stats.getPercentile(0), 0u);
+  BOOST_CHECK_EQUAL(stats.getPercentile(0.01f), 33u);
+  BOOST_CHECK_EQUAL(stats.getPercentile(0.5f), 33u);
+  BOOST_CHECK_EQUAL(stats.getPercentile(0.9f), 33u);
+  BOOST_CHECK_EQUAL(stats.getPercentile(0.91f), 40u);
+  BOOST_CHECK_EQUAL(stats.getPercentile(0.99f), 40u);
+  BOOST_CHECK_EQUAL(stats.getPercentile(1), engine::Throttler::HistogramBuckets - 1);
+  // shares are clamped
+  BOOST_CHECK_EQUAL(stats.getPercentile(2), engine::Throttler::HistogramBuckets - 1);
+  BOOST_CHECK_EQUAL(stats.getPercentile(-1), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_object_queries_benchmark, *boost::unit_test::label("benchmark"))
+{
+  // roughly the object count of a late-game level, with a third of the objects being enemies
+  static constexpr size_t RoomCount = 200;
+  static constexpr size_t ObjectCount = 600;
+  static constexpr size_t Queries = 2000;
+
+  std::vector<Room> rooms(RoomCount);
+  for(size_t i = 0; i < RoomCount; ++i)
+  {
+    for(size_t j = 0; j < rooms[i].neighbours.size(); ++j)
+      rooms[i].neighbours[j] = &rooms[(i + j * 7 + 1) % RoomCount];
+  }
+
+  std::vector<std::shared_ptr<Object>> objects;
+  std::vector<std::shared_ptr<Enemy>> enemies;
+  engine::RoomIndex<Room, Object> index;
+  for(size_t i = 0; i < ObjectCount; ++i)
+  {
+    const auto* room = &rooms[(i * 31) % RoomCount];
+    if(i % 3 == 0)
+      objects.emplace_back(enemies.emplace_back(std::make_shared<Enemy>(room)));
+    else
+      objects.emplace_back(std::make_shared<Object>(room));
+    index.insert(objects.back().get(), room);
+  }
+
+  const auto measure = [](const auto& query)
+  {
+    size_t found = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < Queries; ++i)
+      found += query(i);
+    return std::pair{found, std::chrono::steady_clock::now() - start};
+  };
+  const auto toMicroseconds = [](const auto& duration)
+  { return std::chrono::duration_cast<std::chrono::microseconds>(duration).count(); };
+
+  // aiming: casting every object versus the typed candidate list
+  const auto [castTargets, castTime] = measure(
+    [&objects](size_t)
+    {
+      size_t found = 0;
+      for(const auto& object : objects)
+      {
+        if(const auto enemy = std::dynamic_pointer_cast<Enemy>(object); enemy != nullptr && enemy->room != nullptr)
+          ++found;
+      }
+      return found;
+    });
+  const auto [listTargets, listTime] = measure(
+    [&enemies](size_t)
+    {
+      size_t found = 0;
+      for(const auto& enemy : enemies)
+      {
+        if(enemy->room != nullptr)
+          ++found;
+      }
+      return found;
+    });
+  BOOST_CHECK_EQUAL(castTargets, listTargets);
+
+  // collision: filtering all objects by the adjacent rooms versus visiting the rooms' object lists
+  const auto [scanCollisions, scanTime] = measure(
+    [&objects, &rooms](const size_t i)
+    {
+      const auto& room = rooms[i % RoomCount];
+      std::set<const Room*> adjacent{room.neighbours.begin(), room.neighbours.end()};
+      adjacent.emplace(&room);
+      size_t found = 0;
+      for(const auto& object : objects)
+      {
+        if(adjacent.count(object->room) != 0)
+          ++found;
+      }
+      return found;
+    });
+  const auto [indexCollisions, indexTime] = measure(
+    [&index, &rooms](const size_t i)
+    {
+      const auto& room = rooms[i % RoomCount];
+      std::set<const Room*> adjacent{room.neighbours.begin(), room.neighbours.end()};
+      adjacent.emplace(&room);
+      size_t found = 0;
+      for(const auto& adjacentRoom : adjacent)
+        found += index.getObjects(adjacentRoom).size();
+      return found;
+    });
+  BOOST_CHECK_EQUAL(scanCollisions, indexCollisions);
+
+  BOOST_TEST_MESSAGE(Queries << " target queries: " << toMicroseconds(castTime) << "us casting, "
+                             << toMicroseconds(listTime) << "us with the candidate list");
+  BOOST_TEST_MESSAGE(Queries << " collision queries: " << toMicroseconds(scanTime) << "us scanning, "
+                             << toMicroseconds(indexTime) << "us with the room index");
+}
+
+BOOST_AUTO_TEST_CASE(test_cinematic_camera_benchmark, *boost::unit_test::label("benchmark"))
+{
+  // about a minute of cutscene
+  static constexpr size_t FrameCount = 1800;
+  std::vector<engine::world::CinematicFrame> frames;
+  for(size_t i = 0; i < FrameCount; ++i)
+  {
+    const auto t = static_cast<float>(i) / 30.0f;
+    frames.emplace_back(engine::world::CinematicFrame{
+      core::TRVec{core::Length{static_cast<core::Length::type>(std::sin(t) * 2048)}, -512_len, 1024_len},
+      core::TRVec{core::Length{static_cast<core::Length::type>(std::cos(t) * 4096)}, -1024_len, -2048_len},
+      1.2f,
+      t / 10});
+  }
+  const core::TRVec base{10240_len, -256_len, 20480_len};
+  const auto rotation = 90_deg;
+
+  // previously, the camera transform of every frame was computed during playback
+  std::vector<engine::world::CinematicCameraFrame> computed;
+  const auto computeStart = std::chrono::steady_clock::now();
+  for(const auto& frame : frames)
+    computed.emplace_back(engine::world::computeCinematicCameraFrames({frame}, base, rotation).front());
+  const auto computeTime = std::chrono::steady_clock::now() - computeStart;
+
+  const auto precomputeStart = std::chrono::steady_clock::now();
+  const auto precomputed = engine::world::computeCinematicCameraFrames(frames, base, rotation);
+  const auto precomputeTime = std::chrono::steady_clock::now() - precomputeStart;
+
+  BOOST_REQUIRE_EQUAL(precomputed.size(), computed.size());
+  glm::mat4 sum{0.0f};
+  const auto lookupStart = std::chrono::steady_clock::now();
+  for(const auto& frame : precomputed)
+    sum += frame.viewMatrix;
+  const auto lookupTime = std::chrono::steady_clock::now() - lookupStart;
+
+  for(size_t i = 0; i < FrameCount; ++i)
+  {
+    BOOST_CHECK(precomputed[i].position == computed[i].position);
+    BOOST_CHECK(precomputed[i].lookAt == computed[i].lookAt);
+    BOOST_CHECK(precomputed[i].viewMatrix == computed[i].viewMatrix);
+  }
+  BOOST_CHECK(std::isfinite(sum[3][3]));
+
+  const auto toMicroseconds = [](const auto& duration)
+  { return std::chrono::duration_cast<std::chrono::microseconds>(duration).count(); };
+  BOOST_TEST_MESSAGE(FrameCount << " cinematic camera frames: " << toMicroseconds(computeTime)
+                                << "us computed during playback, " << toMicroseconds(precomputeTime)
+                                << "us precomputed, " << toMicroseconds(lookupTime) << "us looked up");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
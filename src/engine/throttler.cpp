@@ -0,0 +1,92 @@
+#include "throttler.h"
+
+#include <boost/log/trivial.hpp>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+namespace engine
+{
+size_t Throttler::Stats::getPercentile(const float share) const
+{
+  const auto threshold = static_cast<size_t>(std::ceil(static_cast<float>(frames) * std::clamp(share, 0.0f, 1.0f)));
+  size_t count = 0;
+  for(size_t i = 0; i < frameTimeHistogram.size(); ++i)
+  {
+    count += frameTimeHistogram[i];
+    if(count >= threshold)
+      return i;
+  }
+  return frameTimeHistogram.size() - 1;
+}
+
+Throttler::Throttler()
+    : m_nextFrameTime{Clock::now() + FrameDuration}
+{
+  m_waitRatios.fill(0.0f);
+}
+
+void Throttler::logStats() const
+{
+  if(m_stats.frames == 0)
+    return;
+
+  BOOST_LOG_TRIVIAL(info) << "Frame pacing: " << m_stats.frames << " frames, " << m_stats.missedDeadlines
+                          << " missed deadlines, " << m_stats.resyncs << " resyncs, median "
+                          << m_stats.getPercentile(0.5f) << " ms, 99th percentile " << m_stats.getPercentile(0.99f)
+                          << " ms";
+}
+
+void Throttler::wait()
+{
+  const auto now = Clock::now();
+  const auto wait = std::chrono::duration_cast<TimeType>(m_nextFrameTime - now).count();
+  if(!std::exchange(m_workEnded, false))
+    recordWaitRatio(wait);
+
+  if(wait > 0)
+  {
+    // the scheduler may oversleep by more than a millisecond, so the last part is spent spinning
+    if(m_nextFrameTime - now > SpinDuration)
+      std::this_thread::sleep_until(m_nextFrameTime - SpinDuration);
+    while(Clock::now() < m_nextFrameTime)
+      std::this_thread::yield();
+
+    m_nextFrameTime += FrameDuration;
+  }
+  else
+  {
+    ++m_stats.missedDeadlines;
+    if(now - m_nextFrameTime < FrameDuration)
+    {
+      // keep the schedule, the next frame catches up
+      m_nextFrameTime += FrameDuration;
+    }
+    else
+    {
+      ++m_stats.resyncs;
+      m_nextFrameTime = now + FrameDuration;
+    }
+  }
+
+  recordFrameTime();
+}
+
+void Throttler::waitForProgress(const float progress) const
+{
+  const auto remaining
+    = std::chrono::duration_cast<TimeType>(FrameDuration * (1.0f - std::clamp(progress, 0.0f, 1.0f)));
+  std::this_thread::sleep_until(m_nextFrameTime - remaining);
+}
+
+void Throttler::recordFrameTime()
+{
+  const auto now = Clock::now();
+  if(const auto last = std::exchange(m_lastFrameTime, now); last.has_value())
+  {
+    const auto ms = static_cast<size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - *last).count());
+    ++m_stats.frameTimeHistogram[std::min(ms, HistogramBuckets - 1)];
+    ++m_stats.frames;
+  }
+}
+} // namespace engine
@@ -2,43 +2,62 @@
 
 #include "core/magic.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <numeric>
-#include <thread>
+#include <optional>
 
 namespace engine
 {
+// paces the frames to the tick rate of the game: sleeps until shortly before a frame is due and spins for the rest, so
+// oversleeping of the scheduler doesn't delay frames, and keeps a fixed schedule so frame times don't drift
 class Throttler
 {
 public:
-  Throttler()
-      : m_nextFrameTime{std::chrono::high_resolution_clock::now() + FrameDuration}
+  //! frame times are counted in buckets of one millisecond, the last bucket also counts all longer frames
+  static constexpr size_t HistogramBuckets = 100;
+
+  struct Stats
   {
-    m_waitRatios.fill(0.0f);
-  }
+    size_t frames = 0;
+    size_t missedDeadlines = 0;
+    //! frames too late to catch up with the schedule, so the schedule was restarted
+    size_t resyncs = 0;
+    std::array<size_t, HistogramBuckets> frameTimeHistogram{};
+
+    //! frame time in milliseconds which the given share of frames did not exceed
+    [[nodiscard]] size_t getPercentile(float share) const;
+  };
 
-  void wait()
+  Throttler();
+
+  void wait();
+
+  // marks the end of the work for the current frame, so interpolated frames rendered until the next wait() are not
+  // counted as load
+  void endWork()
   {
-    // frame rate throttling
-    const auto now = std::chrono::high_resolution_clock::now();
-    const auto wait = std::chrono::duration_cast<TimeType>(m_nextFrameTime - now).count();
-    m_waitRatios[m_waitRatioIdx] = static_cast<float>(wait) / static_cast<float>(FrameDuration.count());
-    m_waitRatioIdx = (m_waitRatioIdx + 1u) % AverageSamples;
+    recordWaitRatio(std::chrono::duration_cast<TimeType>(m_nextFrameTime - Clock::now()).count());
+    m_workEnded = true;
+  }
 
-    if(wait > 0)
-    {
-      std::this_thread::sleep_until(m_nextFrameTime);
-      m_nextFrameTime += FrameDuration;
-    }
-    else
-    {
-      m_nextFrameTime = now + FrameDuration;
-    }
+  // share of the current frame duration that has already passed
+  [[nodiscard]] float getFrameProgress() const
+  {
+    const auto remaining = std::chrono::duration_cast<TimeType>(m_nextFrameTime - Clock::now()).count();
+    return std::clamp(1.0f - static_cast<float>(remaining) / static_cast<float>(FrameDuration.count()), 0.0f, 1.0f);
   }
 
+  // sleeps until the given share of the current frame duration has passed
+  void waitForProgress(float progress) const;
+
+  // restarts the schedule after a pause, e.g. a menu or saving; the pause is not counted as a frame
   void reset()
   {
-    m_nextFrameTime = std::chrono::high_resolution_clock::now() + FrameDuration;
+    m_nextFrameTime = Clock::now() + FrameDuration;
+    m_lastFrameTime.reset();
   }
 
   // the higher the value, the better. should never exceed 1 (best performance). can be negative if the machine is too slow.
@@ -48,14 +67,37 @@ public:
            / gsl::narrow_cast<float>(m_waitRatios.size());
   }
 
+  [[nodiscard]] const Stats& getStats() const
+  {
+    return m_stats;
+  }
+
+  void logStats() const;
+
 private:
+  // high_resolution_clock may be the system clock, which isn't monotonic
+  using Clock = std::chrono::steady_clock;
   using TimeType = std::chrono::microseconds;
+
+  void recordWaitRatio(const TimeType::rep wait)
+  {
+    m_waitRatios[m_waitRatioIdx] = static_cast<float>(wait) / static_cast<float>(FrameDuration.count());
+    m_waitRatioIdx = (m_waitRatioIdx + 1u) % AverageSamples;
+  }
+
+  void recordFrameTime();
+
   static constexpr TimeType FrameDuration
     = std::chrono::duration_cast<TimeType>(std::chrono::seconds(1)) / core::FrameRate.get();
   static constexpr size_t AverageSamples = 30;
+  //! the part of the waiting time spent spinning instead of sleeping
+  static constexpr TimeType SpinDuration = std::chrono::milliseconds(2);
 
-  std::chrono::high_resolution_clock::time_point m_nextFrameTime{};
+  Clock::time_point m_nextFrameTime{};
+  std::optional<Clock::time_point> m_lastFrameTime{};
   size_t m_waitRatioIdx{0};
   std::array<float, AverageSamples> m_waitRatios{};
+  bool m_workEnded = false;
+  Stats m_stats{};
 };
 } // namespace engine
@@ -0,0 +1,26 @@
+#include "cinematicframe.h"
+
+#include "util/helpers.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/vec3.hpp>
+
+namespace engine::world
+{
+std::vector<CinematicCameraFrame> computeCinematicCameraFrames(const std::vector<CinematicFrame>& frames,
+                                                               const core::TRVec& base,
+                                                               const core::Angle& rotation)
+{
+  std::vector<CinematicCameraFrame> result;
+  result.reserve(frames.size());
+  for(const auto& frame : frames)
+  {
+    const core::TRVec lookAt = base + util::pitch(frame.lookAt, rotation);
+    const core::TRVec position = base + util::pitch(frame.position, rotation);
+    auto m = glm::lookAt(position.toRenderSystem(), lookAt.toRenderSystem(), {0, 1, 0});
+    m = glm::rotate(m, frame.rotZ, -glm::vec3{m[2]});
+    result.emplace_back(CinematicCameraFrame{position, lookAt, m});
+  }
+  return result;
+}
+} // namespace engine::world
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "core/angle.h"
 #include "core/vec.h"
 
+#include <glm/mat4x4.hpp>
+#include <vector>
+
 namespace engine::world
 {
 struct CinematicFrame
@@ -11,4 +15,16 @@ struct CinematicFrame
   float fov;
   float rotZ;
 };
+
+struct CinematicCameraFrame
+{
+  core::TRVec position;
+  core::TRVec lookAt;
+  glm::mat4 viewMatrix;
+};
+
+//! camera transforms of all frames of a cinematic played at the given base position and rotation
+extern std::vector<CinematicCameraFrame> computeCinematicCameraFrames(const std::vector<CinematicFrame>& frames,
+                                                                      const core::TRVec& base,
+                                                                      const core::Angle& rotation);
 } // namespace engine::world
@@ -41,6 +41,7 @@ RenderMeshData::RenderMeshData(const loader::file::Mesh& mesh,
   for(const auto& quad : mesh.textured_rectangles)
   {
     const auto& tile = atlasTiles.at(quad.tileId.get());
+    m_texturePages.emplace(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask);
 
     const auto firstVertex = m_vertices.size();
 
@@ -148,6 +149,7 @@ RenderMeshData::RenderMeshData(const loader::file::Mesh& mesh,
   for(const auto& tri : mesh.textured_triangles)
   {
     const auto& tile = atlasTiles.at(tri.tileId.get());
+    m_texturePages.emplace(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask);
 
     for(int i = 0; i < 3; ++i)
     {
@@ -205,34 +207,39 @@ RenderMeshData::RenderMeshData(const loader::file::Mesh& mesh,
   }
 }
 
-gsl::not_null<std::shared_ptr<render::scene::Mesh>> RenderMeshDataCompositor::toMesh(
-  render::scene::MaterialManager& materialManager, bool skeletal, const std::string& label)
+template<typename TIndex>
+gsl::not_null<std::shared_ptr<render::scene::Mesh>>
+  createRenderMesh(const std::vector<RenderMeshData::RenderVertex>& vertices,
+                   const std::vector<TIndex>& indices,
+                   render::scene::MaterialManager& materialManager,
+                   const bool skeletal,
+                   const std::string& label)
 {
   auto vb = gslu::make_nn_shared<gl::VertexBuffer<RenderMeshData::RenderVertex>>(
     RenderMeshData::RenderVertex::getLayout(), label);
-  vb->setData(m_vertices, gl::api::BufferUsage::StaticDraw);
+  vb->setData(vertices, gl::api::BufferUsage::StaticDraw);
 
 #ifndef NDEBUG
-  for(auto idx : m_indices)
+  for(auto idx : indices)
   {
-    BOOST_ASSERT(idx < m_vertices.size());
+    BOOST_ASSERT(idx < vertices.size());
   }
 #endif
-  auto indexBuffer = gslu::make_nn_shared<gl::ElementArrayBuffer<RenderMeshData::IndexType>>(label);
-  indexBuffer->setData(m_indices, gl::api::BufferUsage::StaticDraw);
+  auto indexBuffer = gslu::make_nn_shared<gl::ElementArrayBuffer<TIndex>>(label);
+  indexBuffer->setData(indices, gl::api::BufferUsage::StaticDraw);
 
   const auto material = materialManager.getGeometry(false, skeletal, false);
   const auto materialCSMDepthOnly = materialManager.getCSMDepthOnly(skeletal);
   const auto materialDepthOnly = materialManager.getDepthOnly(skeletal);
 
-  auto va = gslu::make_nn_shared<gl::VertexArray<RenderMeshData::IndexType, RenderMeshData::RenderVertex>>(
+  auto va = gslu::make_nn_shared<gl::VertexArray<TIndex, RenderMeshData::RenderVertex>>(
     indexBuffer,
     vb,
     std::vector<const gl::Program*>{&material->getShaderProgram()->getHandle(),
                                     &materialDepthOnly->getShaderProgram()->getHandle(),
                                     &materialCSMDepthOnly->getShaderProgram()->getHandle()},
     label);
-  auto mesh = gslu::make_nn_shared<render::scene::MeshImpl<RenderMeshData::IndexType, RenderMeshData::RenderVertex>>(
+  auto mesh = gslu::make_nn_shared<render::scene::MeshImpl<TIndex, RenderMeshData::RenderVertex>>(
     va, gl::api::PrimitiveType::Triangles);
   mesh->getMaterialGroup()
     .set(render::scene::RenderMode::Full, material)
@@ -244,4 +251,24 @@ gsl::not_null<std::shared_ptr<render::scene::Mesh>> RenderMeshDataCompositor::to
 
   return mesh;
 }
+
+template gsl::not_null<std::shared_ptr<render::scene::Mesh>>
+  createRenderMesh<uint16_t>(const std::vector<RenderMeshData::RenderVertex>& vertices,
+                             const std::vector<uint16_t>& indices,
+                             render::scene::MaterialManager& materialManager,
+                             bool skeletal,
+                             const std::string& label);
+
+template gsl::not_null<std::shared_ptr<render::scene::Mesh>>
+  createRenderMesh<uint32_t>(const std::vector<RenderMeshData::RenderVertex>& vertices,
+                             const std::vector<uint32_t>& indices,
+                             render::scene::MaterialManager& materialManager,
+                             bool skeletal,
+                             const std::string& label);
+
+gsl::not_null<std::shared_ptr<render::scene::Mesh>> RenderMeshDataCompositor::toMesh(
+  render::scene::MaterialManager& materialManager, bool skeletal, const std::string& label)
+{
+  return createRenderMesh(m_vertices, m_indices, materialManager, skeletal, label);
+}
 } // namespace engine::world
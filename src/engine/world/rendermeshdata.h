@@ -14,6 +14,7 @@
 #include <glm/vec4.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -87,11 +88,40 @@ public:
     return m_indices;
   }
 
+  [[nodiscard]] const auto& getTexturePages() const
+  {
+    return m_texturePages;
+  }
+
 private:
   std::vector<RenderVertex> m_vertices{};
   std::vector<IndexType> m_indices{};
+  std::set<uint32_t> m_texturePages{};
 };
 
+//! creates a mesh with the geometry, depth only and CSM depth only materials for render mesh vertices
+template<typename TIndex>
+gsl::not_null<std::shared_ptr<render::scene::Mesh>>
+  createRenderMesh(const std::vector<RenderMeshData::RenderVertex>& vertices,
+                   const std::vector<TIndex>& indices,
+                   render::scene::MaterialManager& materialManager,
+                   bool skeletal,
+                   const std::string& label);
+
+extern template gsl::not_null<std::shared_ptr<render::scene::Mesh>>
+  createRenderMesh<uint16_t>(const std::vector<RenderMeshData::RenderVertex>& vertices,
+                             const std::vector<uint16_t>& indices,
+                             render::scene::MaterialManager& materialManager,
+                             bool skeletal,
+                             const std::string& label);
+
+extern template gsl::not_null<std::shared_ptr<render::scene::Mesh>>
+  createRenderMesh<uint32_t>(const std::vector<RenderMeshData::RenderVertex>& vertices,
+                             const std::vector<uint32_t>& indices,
+                             render::scene::MaterialManager& materialManager,
+                             bool skeletal,
+                             const std::string& label);
+
 class RenderMeshDataCompositor final
 {
 public:
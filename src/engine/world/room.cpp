@@ -4,16 +4,16 @@
 #include "box.h"
 #include "core/containeroffset.h"
 #include "core/id.h"
-#include "engine/engine.h"
-#include "engine/engineconfig.h"
+#include "engine/lightclusters.h"
 #include "engine/lighting.h"
 #include "engine/location.h"
 #include "engine/objects/object.h"
 #include "engine/objects/objectstate.h"
+#include "engine/presenter.h"
 #include "loader/file/datatypes.h"
 #include "loader/file/primitives.h"
 #include "loader/file/texture.h"
-#include "render/rendersettings.h"
+#include "render/scene/culling.h"
 #include "render/scene/material.h"
 #include "render/scene/materialgroup.h"
 #include "render/scene/materialmanager.h"
@@ -23,6 +23,7 @@
 #include "render/scene/rendermode.h"
 #include "render/scene/shaderprogram.h"
 #include "render/textureanimator.h"
+#include "roomgeometry.h"
 #include "sector.h"
 #include "serialization/serialization.h"
 #include "serialization/vector.h"
@@ -41,6 +42,7 @@
 #include <gl/renderstate.h>
 #include <gl/vertexarray.h>
 #include <gl/vertexbuffer.h>
+#include <glm/common.hpp>
 #include <glm/ext/scalar_int_sized.hpp>
 #include <glm/fwd.hpp>
 #include <glm/geometric.hpp>
@@ -53,7 +55,6 @@
 #include <iosfwd>
 #include <iterator>
 #include <limits>
-#include <set>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -62,52 +63,34 @@ namespace engine::world
 {
 namespace
 {
-#pragma pack(push, 1)
-
-struct RenderVertex
+const gl::VertexLayout<RoomRenderVertex>& getRenderVertexLayout()
 {
-  glm::vec3 position{};
-  glm::vec4 color{1.0f};
-  glm::vec3 normal{0.0f};
-  glm::int32 isQuad{0};
-  glm::vec3 quadVert1{};
-  glm::vec3 quadVert2{};
-  glm::vec3 quadVert3{};
-  glm::vec3 quadVert4{};
-  glm::vec4 quadUv12{};
-  glm::vec4 quadUv34{};
-
-  static const gl::VertexLayout<RenderVertex>& getLayout()
-  {
-    static const gl::VertexLayout<RenderVertex> layout{
-      {VERTEX_ATTRIBUTE_POSITION_NAME, &RenderVertex::position},
-      {VERTEX_ATTRIBUTE_NORMAL_NAME, &RenderVertex::normal},
-      {VERTEX_ATTRIBUTE_COLOR_NAME, &RenderVertex::color},
-      {VERTEX_ATTRIBUTE_IS_QUAD, &RenderVertex::isQuad},
-      {VERTEX_ATTRIBUTE_QUAD_VERT1, &RenderVertex::quadVert1},
-      {VERTEX_ATTRIBUTE_QUAD_VERT2, &RenderVertex::quadVert2},
-      {VERTEX_ATTRIBUTE_QUAD_VERT3, &RenderVertex::quadVert3},
-      {VERTEX_ATTRIBUTE_QUAD_VERT4, &RenderVertex::quadVert4},
-      {VERTEX_ATTRIBUTE_QUAD_UV12, &RenderVertex::quadUv12},
-      {VERTEX_ATTRIBUTE_QUAD_UV34, &RenderVertex::quadUv34},
-    };
-
-    return layout;
-  }
-};
+  static const gl::VertexLayout<RoomRenderVertex> layout{
+    {VERTEX_ATTRIBUTE_POSITION_NAME, &RoomRenderVertex::position},
+    {VERTEX_ATTRIBUTE_NORMAL_NAME, &RoomRenderVertex::normal},
+    {VERTEX_ATTRIBUTE_COLOR_NAME, &RoomRenderVertex::color},
+    {VERTEX_ATTRIBUTE_IS_QUAD, &RoomRenderVertex::isQuad},
+    {VERTEX_ATTRIBUTE_QUAD_VERT1, &RoomRenderVertex::quadVert1},
+    {VERTEX_ATTRIBUTE_QUAD_VERT2, &RoomRenderVertex::quadVert2},
+    {VERTEX_ATTRIBUTE_QUAD_VERT3, &RoomRenderVertex::quadVert3},
+    {VERTEX_ATTRIBUTE_QUAD_VERT4, &RoomRenderVertex::quadVert4},
+    {VERTEX_ATTRIBUTE_QUAD_UV12, &RoomRenderVertex::quadUv12},
+    {VERTEX_ATTRIBUTE_QUAD_UV34, &RoomRenderVertex::quadUv34},
+  };
 
-#pragma pack(pop)
+  return layout;
+}
 
 struct RenderMesh
 {
-  using IndexType = uint16_t;
+  using IndexType = RoomGeometry::IndexType;
   std::vector<IndexType> m_indices;
   std::shared_ptr<render::scene::Material> m_materialFull;
   std::shared_ptr<render::scene::Material> m_materialCSMDepthOnly;
   std::shared_ptr<render::scene::Material> m_materialDepthOnly;
 
   std::shared_ptr<render::scene::Mesh>
-    toMesh(const gsl::not_null<std::shared_ptr<gl::VertexBuffer<RenderVertex>>>& vbuf,
+    toMesh(const gsl::not_null<std::shared_ptr<gl::VertexBuffer<RoomRenderVertex>>>& vbuf,
            const gsl::not_null<std::shared_ptr<gl::VertexBuffer<render::TextureAnimator::AnimatedUV>>>& uvBuf,
            const std::string& label)
   {
@@ -123,8 +106,9 @@ struct RenderMesh
 
     auto vBufs = std::make_tuple(vbuf, uvBuf);
 
-    auto mesh = std::make_shared<render::scene::MeshImpl<IndexType, RenderVertex, render::TextureAnimator::AnimatedUV>>(
-      gslu::make_nn_shared<gl::VertexArray<IndexType, RenderVertex, render::TextureAnimator::AnimatedUV>>(
+    using AnimatedUV = render::TextureAnimator::AnimatedUV;
+    auto mesh = std::make_shared<render::scene::MeshImpl<IndexType, RoomRenderVertex, AnimatedUV>>(
+      gslu::make_nn_shared<gl::VertexArray<IndexType, RoomRenderVertex, AnimatedUV>>(
         indexBuffer,
         vBufs,
         std::vector{&m_materialFull->getShaderProgram()->getHandle(),
@@ -188,27 +172,11 @@ void Portal::buildMesh(const loader::file::Portal& srcPortal,
   mesh->getMaterialGroup().set(render::scene::RenderMode::DepthOnly, material);
 }
 
-void Room::createSceneNode(const loader::file::Room& srcRoom,
-                           const size_t roomId,
-                           World& world,
-                           render::TextureAnimator& animator,
-                           render::scene::MaterialManager& materialManager)
+RoomGeometry Room::buildGeometry(const loader::file::Room& srcRoom,
+                                 const World& world,
+                                 const render::TextureAnimator& animator) const
 {
-  RenderMesh renderMesh;
-  renderMesh.m_materialDepthOnly = materialManager.getDepthOnly(false);
-  renderMesh.m_materialCSMDepthOnly = nullptr;
-  renderMesh.m_materialFull = materialManager.getGeometry(isWaterRoom, false, true);
-
-  std::vector<RenderVertex> vbufData;
-  std::vector<render::TextureAnimator::AnimatedUV> uvCoordsData;
-
-  const auto label = "Room:" + std::to_string(roomId);
-  auto vbuf = gslu::make_nn_shared<gl::VertexBuffer<RenderVertex>>(RenderVertex::getLayout(), label);
-
-  static const gl::VertexLayout<render::TextureAnimator::AnimatedUV> uvAttribs{
-    {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, gl::VertexAttribute{&render::TextureAnimator::AnimatedUV::uv}},
-  };
-  auto uvCoords = gslu::make_nn_shared<gl::VertexBuffer<render::TextureAnimator::AnimatedUV>>(uvAttribs, label + "-uv");
+  RoomGeometry geometry;
 
   for(const loader::file::QuadFace& quad : srcRoom.rectangles)
   {
@@ -243,13 +211,13 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
                                            quad.vertices[2].from(srcRoom.vertices).position.toRenderSystem(),
                                            quad.vertices[3].from(srcRoom.vertices).position.toRenderSystem());
 
-    const auto firstVertex = vbufData.size();
+    const auto firstVertex = geometry.vertices.size();
     for(int i = 0; i < 4; ++i)
     {
-      RenderVertex iv;
+      RoomRenderVertex iv;
       iv.position = quad.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
       iv.color = quad.vertices[i].from(srcRoom.vertices).color;
-      uvCoordsData.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask, tile.uvCoordinates[i]);
+      geometry.uvCoords.emplace_back(animator.getUV(quad.tileId, tile, i));
 
       if(useQuadHandling)
       {
@@ -277,13 +245,12 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
                                    quad.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
       }
 
-      vbufData.emplace_back(iv);
+      geometry.vertices.emplace_back(iv);
     }
 
     for(int i : {0, 1, 2, 0, 2, 3})
     {
-      animator.registerVertex(quad.tileId, uvCoords, i, firstVertex + i);
-      renderMesh.m_indices.emplace_back(gsl::narrow<RenderMesh::IndexType>(firstVertex + i));
+      geometry.indices.emplace_back(gsl::narrow<RoomGeometry::IndexType>(firstVertex + i));
     }
   }
   for(const loader::file::Triangle& tri : srcRoom.triangles)
@@ -306,37 +273,88 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
 
     const auto& tile = world.getAtlasTiles().at(tri.tileId.get());
 
-    const auto firstVertex = vbufData.size();
+    const auto firstVertex = geometry.vertices.size();
     for(int i = 0; i < 3; ++i)
     {
-      RenderVertex iv;
+      RoomRenderVertex iv;
       iv.position = tri.vertices[i].from(srcRoom.vertices).position.toRenderSystem();
       iv.color = tri.vertices[i].from(srcRoom.vertices).color;
-      uvCoordsData.emplace_back(tile.textureKey.tileAndFlag & loader::file::TextureIndexMask, tile.uvCoordinates[i]);
+      geometry.uvCoords.emplace_back(animator.getUV(tri.tileId, tile, i));
 
       static const std::array<int, 3> indices{0, 1, 2};
       iv.normal = generateNormal(tri.vertices[indices[(i + 0) % 3]].from(srcRoom.vertices).position,
                                  tri.vertices[indices[(i + 1) % 3]].from(srcRoom.vertices).position,
                                  tri.vertices[indices[(i + 2) % 3]].from(srcRoom.vertices).position);
 
-      vbufData.push_back(iv);
+      geometry.vertices.push_back(iv);
     }
 
     for(int i : {0, 1, 2})
     {
-      animator.registerVertex(tri.tileId, uvCoords, i, firstVertex + i);
-      renderMesh.m_indices.emplace_back(gsl::narrow<RenderMesh::IndexType>(firstVertex + i));
+      geometry.indices.emplace_back(gsl::narrow<RoomGeometry::IndexType>(firstVertex + i));
     }
   }
 
-  vbuf->setData(vbufData, gl::api::BufferUsage::StaticDraw);
-  uvCoords->setData(uvCoordsData, gl::api::BufferUsage::DynamicDraw);
+
+  return geometry;
+}
+
+void Room::prepareSceneNode(const loader::file::Room& srcRoom, const RoomGeometry& geometry)
+{
+  // animated tiles are pinned by the texture streamer
+  texturePages.clear();
+  for(const auto& uv : geometry.uvCoords)
+  {
+    if(uv.uv.z >= 0)
+      texturePages.emplace(static_cast<uint32_t>(uv.uv.z));
+  }
+  for(const RoomStaticMesh& sm : staticMeshes)
+    texturePages.insert(sm.staticMesh->texturePages.begin(), sm.staticMesh->texturePages.end());
+
+  renderBoundsMin = glm::vec3{std::numeric_limits<float>::max()};
+  renderBoundsMax = glm::vec3{std::numeric_limits<float>::lowest()};
+  for(const auto& v : srcRoom.vertices)
+  {
+    const auto p = (position + v.position).toRenderSystem();
+    renderBoundsMin = glm::min(renderBoundsMin, p);
+    renderBoundsMax = glm::max(renderBoundsMax, p);
+  }
+  if(srcRoom.vertices.empty())
+  {
+    renderBoundsMin = position.toRenderSystem();
+    renderBoundsMax = renderBoundsMin;
+  }
+}
+
+void Room::createSceneNode(const loader::file::Room& srcRoom,
+                           const size_t roomId,
+                           World& world,
+                           const RoomGeometry& geometry,
+                           render::scene::MaterialManager& materialManager)
+{
+  RenderMesh renderMesh;
+  renderMesh.m_materialDepthOnly = materialManager.getDepthOnly(false);
+  renderMesh.m_materialCSMDepthOnly = nullptr;
+  renderMesh.m_materialFull = materialManager.getGeometry(isWaterRoom, false, true);
+  renderMesh.m_indices = geometry.indices;
+
+  const auto label = "Room:" + std::to_string(roomId);
+  auto vbuf = gslu::make_nn_shared<gl::VertexBuffer<RoomRenderVertex>>(getRenderVertexLayout(), label);
+  vbuf->setData(geometry.vertices, gl::api::BufferUsage::StaticDraw);
+
+  static const gl::VertexLayout<render::TextureAnimator::AnimatedUV> uvAttribs{
+    {VERTEX_ATTRIBUTE_TEXCOORD_PREFIX_NAME, gl::VertexAttribute{&render::TextureAnimator::AnimatedUV::uv}},
+  };
+  auto uvCoords = gslu::make_nn_shared<gl::VertexBuffer<render::TextureAnimator::AnimatedUV>>(uvAttribs, label + "-uv");
+  uvCoords->setData(geometry.uvCoords, gl::api::BufferUsage::StaticDraw);
 
   auto resMesh = renderMesh.toMesh(vbuf, uvCoords, label);
   resMesh->getRenderState().setCullFace(true);
   resMesh->getRenderState().setCullFaceSide(gl::api::CullFaceMode::Back);
   resMesh->getRenderState().setBlend(false);
 
+  lightsBuffer = world.getPresenter().getLightClusters().getLightsBuffer();
+
   node = std::make_shared<render::scene::Node>("Room:" + std::to_string(roomId));
   node->setRenderable(resMesh);
   node->bind("u_lightAmbient",
@@ -372,6 +390,8 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
     sceneryNodes.emplace_back(std::move(subNode));
   }
   node->setLocalMatrix(translate(glm::mat4{1.0f}, position.toRenderSystem()));
+  node->setLocalBounds(
+    render::scene::Bounds{renderBoundsMin - position.toRenderSystem(), renderBoundsMax - position.toRenderSystem()});
 
   for(const loader::file::SpriteInstance& spriteInstance : srcRoom.sprites)
   {
@@ -412,7 +432,6 @@ void Room::createSceneNode(const loader::file::Room& srcRoom,
                    return p;
                  });
 
-  collectShaderLights(world.getEngine().getEngineConfig()->renderSettings.getLightCollectionDepth());
   resetScenery();
 }
 
@@ -504,49 +523,4 @@ const Sector* Room::getSectorByIndex(const int dx, const int dz) const
   }
   return &sectors[sectorCountZ * dx + dz];
 }
-
-void Room::collectShaderLights(size_t depth)
-{
-  bufferLights.clear();
-  if(lights.empty())
-  {
-    lightsBuffer->setData(bufferLights, gl::api::BufferUsage::StaticDraw);
-    return;
-  }
-
-  std::set<gsl::not_null<const Room*>> testRooms;
-  testRooms.emplace(this);
-  for(size_t i = 0; i < depth; ++i)
-  {
-    std::set<gsl::not_null<const Room*>> newTestRooms;
-    for(const auto& room : testRooms)
-    {
-      newTestRooms.emplace(room);
-      for(const auto& portal : room->portals)
-      {
-        newTestRooms.emplace(portal.adjoiningRoom);
-      }
-    }
-    testRooms = std::move(newTestRooms);
-  }
-
-  for(const auto& room : testRooms)
-  {
-    // http://www-f9.ijs.si/~matevz/docs/PovRay/pov274.htm
-    // 1 / ( 1 + (d/fade_distance) ^ fade_power );
-    // assuming fade_power = 1, multiply numerator and denominator with fade_distance (identity transform):
-    // fade_distance / ( fade_distance + d )
-
-    for(const auto& light : room->lights)
-    {
-      if(light.intensity.get() <= 0)
-        continue;
-      bufferLights.emplace_back(ShaderLight{glm::vec4{light.position.toRenderSystem(), 0.0f},
-                                            toBrightness(light.intensity).get(),
-                                            light.fadeDistance.get<float>()});
-    }
-  }
-
-  lightsBuffer->setData(bufferLights, gl::api::BufferUsage::StaticDraw);
-}
 } // namespace engine::world
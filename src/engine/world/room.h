@@ -12,11 +12,13 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <gl/buffer.h>
 #include <glm/vec3.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
 #include <optional>
+#include <set>
 #include <vector>
 
 // IWYU pragma: no_forward_declare serialization::Serializer
@@ -24,7 +26,8 @@
 namespace engine::world
 {
 class World;
-}
+struct RoomGeometry;
+} // namespace engine::world
 
 namespace render
 {
@@ -105,11 +108,20 @@ struct Room
 
   std::shared_ptr<render::scene::Node> node = nullptr;
   std::vector<gsl::not_null<std::shared_ptr<render::scene::Node>>> sceneryNodes{};
-
+  // world space bounds of the room geometry in render system coordinates
+  glm::vec3 renderBoundsMin{0.0f};
+  glm::vec3 renderBoundsMax{0.0f};
+
+  [[nodiscard]] RoomGeometry buildGeometry(const loader::file::Room& srcRoom,
+                                           const World& world,
+                                           const render::TextureAnimator& animator) const;
+  //! computes the render bounds and texture pages without touching any GL state, so rooms can be prepared concurrently
+  void prepareSceneNode(const loader::file::Room& srcRoom, const RoomGeometry& geometry);
+  //! creates the GL resources and scene nodes; requires prepareSceneNode to be called first
   void createSceneNode(const loader::file::Room& srcRoom,
                        size_t roomId,
                        World&,
-                       render::TextureAnimator& animator,
+                       const RoomGeometry& geometry,
                        render::scene::MaterialManager& materialManager);
 
   [[nodiscard]] const Sector* getSectorByAbsolutePosition(const core::TRVec& worldPos) const
@@ -168,11 +180,12 @@ struct Room
 
   void serialize(const serialization::Serializer<World>& ser);
 
-  std::vector<engine::ShaderLight> bufferLights{};
-  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<engine::ShaderLight>>> lightsBuffer{
-    std::make_shared<gl::ShaderStorageBuffer<engine::ShaderLight>>("lights-buffer")};
+  // atlas pages used by the room geometry and its static meshes
+  std::set<uint32_t> texturePages{};
 
-  void collectShaderLights(size_t depth);
+  // the clustered lights around the visible rooms, shared by all rooms
+  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<engine::ShaderLight>>> lightsBuffer{
+    engine::ShaderLight::getEmptyBuffer()};
 };
 
 extern void patchHeightsForBlock(const engine::objects::Object& object, const core::Length& height);
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "render/textureanimator.h"
+
+#include <cstdint>
+#include <glm/fwd.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <vector>
+
+namespace engine::world
+{
+#pragma pack(push, 1)
+
+struct RoomRenderVertex
+{
+  glm::vec3 position{};
+  glm::vec4 color{1.0f};
+  glm::vec3 normal{0.0f};
+  glm::int32 isQuad{0};
+  glm::vec3 quadVert1{};
+  glm::vec3 quadVert2{};
+  glm::vec3 quadVert3{};
+  glm::vec3 quadVert4{};
+  glm::vec4 quadUv12{};
+  glm::vec4 quadUv34{};
+};
+
+#pragma pack(pop)
+
+// render geometry of a room, ready for upload
+struct RoomGeometry
+{
+  using IndexType = uint16_t;
+
+  std::vector<RoomRenderVertex> vertices;
+  std::vector<render::TextureAnimator::AnimatedUV> uvCoords;
+  std::vector<IndexType> indices;
+};
+} // namespace engine::world
@@ -3,8 +3,12 @@
 #include "core/containeroffset.h"
 #include "core/id.h"
 #include "loader/file/animation.h"
+#include "skinnedmesh.h"
 
+#include <cstdint>
 #include <gsl/gsl-lite.hpp>
+#include <memory>
+#include <set>
 
 namespace engine::world
 {
@@ -42,5 +46,9 @@ struct SkeletalModelType
 
   const loader::file::AnimFrame* frames = nullptr;
   const Animation* animations = nullptr;
+
+  std::set<uint32_t> texturePages{};
+
+  std::shared_ptr<SkinnedMesh> skinnedMesh{};
 };
 } // namespace engine::world
@@ -0,0 +1,53 @@
+#include "skinnedmesh.h"
+
+#include "render/scene/mesh.h" // IWYU pragma: keep
+
+#include <boost/log/trivial.hpp>
+#include <gsl/gsl-lite.hpp>
+
+namespace engine::world
+{
+int32_t SkinnedMesh::getVariant(const size_t bone, const std::shared_ptr<RenderMeshData>& mesh)
+{
+  Expects(mesh != nullptr);
+  Expects(bone < static_cast<size_t>(BoneStride));
+
+  const std::pair key{bone, mesh.get()};
+  if(const auto it = m_variants.find(key); it != m_variants.end())
+    return it->second;
+
+  if(m_variantCounts.size() <= bone)
+    m_variantCounts.resize(bone + 1, 0);
+  const auto variant = m_variantCounts[bone]++;
+  // the combined index is passed to the shaders as a float, which is exact up to 2^24
+  Expects(variant < (1 << 24) / BoneStride);
+
+  m_variants.emplace(key, variant);
+  m_meshes.emplace_back(mesh);
+
+  const auto vertexOffset = m_vertices.size();
+  for(auto v : mesh->getVertices())
+  {
+    v.boneIndex = gsl::narrow<int32_t>(bone) + variant * BoneStride;
+    m_vertices.emplace_back(v);
+  }
+  for(const auto i : mesh->getIndices())
+  {
+    // cppcheck-suppress useStlAlgorithm
+    m_indices.emplace_back(gsl::narrow<IndexType>(i + vertexOffset));
+  }
+
+  // instances keep using the previous mesh until they change their parts; variants are only ever appended, so it
+  // stays valid for them
+  m_mesh.reset();
+  BOOST_LOG_TRIVIAL(trace) << "Skinned mesh " << m_label << ": added variant " << variant << " for bone " << bone;
+  return variant;
+}
+
+std::shared_ptr<render::scene::Mesh> SkinnedMesh::getMesh(render::scene::MaterialManager& materialManager)
+{
+  if(m_mesh == nullptr && !m_indices.empty())
+    m_mesh = createRenderMesh(m_vertices, m_indices, materialManager, true, m_label).get();
+  return m_mesh;
+}
+} // namespace engine::world
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "rendermeshdata.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace render::scene
+{
+class MaterialManager;
+class Mesh;
+} // namespace render::scene
+
+namespace engine::world
+{
+// shared render geometry of all instances of a skeletal model; every mesh that was ever shown on a bone is a variant
+// of that bone, and instances only select the visible variant per bone (see transform_interface.glsl), so swapping
+// or hiding bone meshes does not touch the vertex data
+class SkinnedMesh final
+{
+public:
+  // must match transform_interface.glsl
+  static constexpr int32_t BoneStride = 256;
+  static constexpr int32_t Hidden = -1;
+
+  explicit SkinnedMesh(std::string label)
+      : m_label{std::move(label)}
+  {
+  }
+
+  //! returns the variant of a mesh on a bone, appending the mesh to the shared geometry on first use
+  [[nodiscard]] int32_t getVariant(size_t bone, const std::shared_ptr<RenderMeshData>& mesh);
+
+  //! the geometry of all variants registered so far, or nothing if there is no geometry at all
+  [[nodiscard]] std::shared_ptr<render::scene::Mesh> getMesh(render::scene::MaterialManager& materialManager);
+
+private:
+  using IndexType = uint32_t;
+
+  const std::string m_label;
+  std::map<std::pair<size_t, const RenderMeshData*>, int32_t> m_variants;
+  // keeps the registered meshes alive, so their addresses stay unique
+  std::vector<std::shared_ptr<RenderMeshData>> m_meshes;
+  std::vector<int32_t> m_variantCounts;
+  std::vector<RenderMeshData::RenderVertex> m_vertices;
+  std::vector<IndexType> m_indices;
+  std::shared_ptr<render::scene::Mesh> m_mesh;
+};
+} // namespace engine::world
@@ -3,6 +3,10 @@
 #include "core/boundingbox.h"
 #include "core/id.h"
 
+#include <cstdint>
+#include <memory>
+#include <set>
+
 namespace render::scene
 {
 class Mesh;
@@ -16,5 +20,6 @@ struct StaticMesh
   const bool doNotCollide;
 
   std::shared_ptr<render::scene::Mesh> renderMesh{nullptr};
+  std::set<uint32_t> texturePages{};
 };
 } // namespace engine::world
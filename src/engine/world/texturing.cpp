@@ -8,6 +8,7 @@
 #include "loader/file/texture.h"
 #include "loader/trx/trx.h"
 #include "render/textureatlas.h"
+#include "render/texturestreamer.h"
 #include "sprite.h"
 
 #include <algorithm>
@@ -17,19 +18,15 @@
 #include <boost/log/trivial.hpp>
 #include <cstddef>
 #include <cstdint>
-#include <filesystem>
 #include <gl/cimgwrapper.h>
 #include <gl/image.h>
 #include <gl/pixel.h>
-#include <gl/texture2darray.h>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <iosfwd>
 #include <map>
 #include <memory>
-#include <numeric>
-#include <set>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
@@ -39,52 +36,6 @@ namespace engine::world
 {
 namespace
 {
-struct UVRect
-{
-  explicit UVRect(const std::array<glm::vec2, 4>& cos)
-  {
-    xy0.x = xy0.y = 1;
-    xy1.x = xy1.y = 0;
-    for(const auto& co : cos)
-    {
-      if(co.x == 0 && co.y == 0)
-        continue;
-
-      xy0.x = std::min(xy0.x, co.x);
-      xy0.y = std::min(xy0.y, co.y);
-      xy1.x = std::max(xy1.x, co.x);
-      xy1.y = std::max(xy1.y, co.y);
-    }
-  }
-
-  UVRect(const glm::vec2& t0, const glm::vec2& t1)
-  {
-    xy0.x = std::min(t0.x, t1.x);
-    xy0.y = std::min(t0.y, t1.y);
-    xy1.x = std::max(t0.x, t1.x);
-    xy1.y = std::max(t0.y, t1.y);
-  }
-
-  bool operator==(const UVRect& rhs) const noexcept
-  {
-    return xy0 == rhs.xy0 && xy1 == rhs.xy1;
-  }
-
-  constexpr bool operator<(const UVRect& rhs) const noexcept
-  {
-    if(xy0.x != rhs.xy0.x)
-      return xy0.x < rhs.xy0.x;
-    if(xy0.y != rhs.xy1.y)
-      return xy0.y < rhs.xy0.y;
-    if(xy1.x != rhs.xy1.x)
-      return xy1.x < rhs.xy1.x;
-    return xy1.y < rhs.xy1.y;
-  }
-
-  glm::vec2 xy0{};
-  glm::vec2 xy1{};
-};
-
 void remapRange(glm::vec2& co,
                 const glm::vec2& rangeAMin,
                 const glm::vec2& rangeAMax,
@@ -129,52 +80,32 @@ void remap(Sprite& sprite, size_t atlas, const glm::vec2& replacementUvPos, cons
   remapRange(sprite.uv1, a, b, replacementUvPos, replacementUvMax);
 }
 
-void createMipmaps(const std::vector<std::shared_ptr<gl::CImgWrapper>>& images,
-                   size_t nMips,
-                   gl::Texture2DArray<gl::SRGBA8>& allTextures,
-                   const std::vector<AtlasTile>& atlasTiles,
-                   const std::vector<Sprite>& sprites,
-                   const std::function<void(const std::string&)>& drawLoadingScreen)
+std::vector<render::TextureStreamer::Page>
+  createMipmaps(const std::vector<std::shared_ptr<gl::CImgWrapper>>& images,
+                size_t nMips,
+                const std::function<void(const std::string&)>& drawLoadingScreen)
 {
-  std::map<int, std::set<UVRect>> tilesByTexture;
-  BOOST_LOG_TRIVIAL(debug) << atlasTiles.size() << " total atlas tiles";
-  for(const auto& tile : atlasTiles)
-  {
-    tilesByTexture[tile.textureKey.tileAndFlag & loader::file::TextureIndexMask].emplace(tile.uvCoordinates);
-  }
-  for(const auto& sprite : sprites)
+  std::vector<render::TextureStreamer::Page> pages;
+  pages.reserve(images.size());
+  for(size_t i = 0; i < images.size(); ++i)
   {
-    tilesByTexture[sprite.textureId.get()].emplace(sprite.uv0, sprite.uv1);
-  }
+    drawLoadingScreen(_("Creating mipmaps (%1%%%)", i * 100 / images.size()));
 
-  size_t totalTiles
-    = std::accumulate(tilesByTexture.begin(),
-                      tilesByTexture.end(),
-                      std::size_t{0},
-                      [](size_t n, const auto& textureAndTiles) { return n + textureAndTiles.second.size(); });
-  BOOST_LOG_TRIVIAL(debug) << totalTiles << " unique texture tiles";
-
-  size_t processedTiles = 0;
-  for(const auto& [texture, tiles] : tilesByTexture)
-  {
-    auto src = *images.at(texture);
+    auto& src = *images[i];
     Expects(src.width() == src.height());
 
-    BOOST_LOG_TRIVIAL(debug) << "Mipmapping texture " << texture;
+    BOOST_LOG_TRIVIAL(debug) << "Mipmapping texture " << i;
 
-    auto dstSize = src.width() / 2;
-    auto margin = render::MultiTextureAtlas::BoundaryMargin / 2;
-    for(int mipmapLevel = 1; static_cast<size_t>(mipmapLevel) < nMips; dstSize /= 2, margin /= 2, ++mipmapLevel)
+    auto& page = pages.emplace_back();
+    for(size_t mipmapLevel = 0; mipmapLevel < nMips; ++mipmapLevel)
     {
-      drawLoadingScreen(_("Creating mipmaps (%1%%%)", processedTiles * 100 / (totalTiles * (nMips - 1))));
-      processedTiles += tiles.size();
-
-      BOOST_LOG_TRIVIAL(debug) << "Mipmap level " << mipmapLevel << " (size " << dstSize << ", " << tiles.size()
-                               << " tiles)";
-      src.resizePow2Mipmap(1);
-      allTextures.assign(src.pixels(), texture, mipmapLevel);
+      if(mipmapLevel > 0)
+        src.resizePow2Mipmap(1);
+      const auto pixels = src.pixels();
+      page.emplace_back(pixels.begin(), pixels.end());
     }
   }
+  return pages;
 }
 
 void processGlidosPack(const loader::file::level::Level& level,
@@ -193,7 +124,8 @@ void processGlidosPack(const loader::file::level::Level& level,
     for(const auto& [tile, path] : mappings.tiles)
     {
       std::unique_ptr<gl::CImgWrapper> replacementImg;
-      if(path.empty() || !std::filesystem::is_regular_file(path))
+      // missing replacement files were already resolved to empty paths when the pack was indexed
+      if(path.empty())
       {
         replacementImg = std::make_unique<gl::CImgWrapper>(
           // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
@@ -404,7 +336,7 @@ void remapTextures(const loader::file::level::Level& level,
 }
 } // namespace
 
-std::unique_ptr<gl::Texture2DArray<gl::SRGBA8>>
+std::vector<render::TextureStreamer::Page>
   buildTextures(const loader::file::level::Level& level,
                 const std::unique_ptr<loader::trx::Glidos>& glidos,
                 render::MultiTextureAtlas& atlases,
@@ -432,15 +364,6 @@ std::unique_ptr<gl::Texture2DArray<gl::SRGBA8>>
   remapTextures(level, atlases, atlasTiles, sprites, doneTiles, doneSprites);
 
   const int textureLevels = static_cast<int>(std::log2(atlases.getSize()) + 1) / 2;
-  auto images = atlases.takeImages();
-
-  auto allTextures = std::make_unique<gl::Texture2DArray<gl::SRGBA8>>(
-    glm::ivec3{atlases.getSize(), atlases.getSize(), gsl::narrow<int>(images.size())}, "all-textures", textureLevels);
-
-  for(size_t i = 0; i < images.size(); ++i)
-    allTextures->assign(images[i]->pixels(), gsl::narrow_cast<int>(i));
-  createMipmaps(images, textureLevels, *allTextures, atlasTiles, sprites, drawLoadingScreen);
-
-  return allTextures;
+  return createMipmaps(atlases.takeImages(), textureLevels, drawLoadingScreen);
 }
 } // namespace engine::world
@@ -1,14 +1,12 @@
 #pragma once
 
+#include "render/texturestreamer.h"
+
 #include <functional>
-#include <gl/pixel.h>
-#include <gl/soglb_fwd.h>
 #include <memory>
 #include <string>
 #include <vector>
 
-// IWYU pragma: no_forward_declare gl::Texture2DArray
-
 namespace loader::file::level
 {
 class Level;
@@ -29,7 +27,8 @@ namespace engine::world
 struct AtlasTile;
 struct Sprite;
 
-extern std::unique_ptr<gl::Texture2DArray<gl::SRGBA8>>
+// returns the mip levels of all atlas pages
+extern std::vector<render::TextureStreamer::Page>
   buildTextures(const loader::file::level::Level& level,
                 const std::unique_ptr<loader::trx::Glidos>& glidos,
                 render::MultiTextureAtlas& atlases,
@@ -28,7 +28,7 @@
 #include "engine/objects/objectstate.h"
 #include "engine/objects/pickupobject.h"
 #include "engine/objects/tallblock.h" // IWYU pragma: keep
-#include "engine/particle.h"
+#include "engine/particlepool.h"
 #include "engine/player.h"
 #include "engine/presenter.h"
 #include "engine/skeletalmodelnode.h"
@@ -56,8 +56,10 @@
 #include "render/scene/sprite.h"
 #include "render/textureanimator.h"
 #include "render/textureatlas.h"
+#include "render/texturestreamer.h"
 #include "rendermeshdata.h"
 #include "room.h"
+#include "roomgeometry.h"
 #include "sector.h"
 #include "serialization/array.h"
 #include "serialization/bitset.h"
@@ -67,6 +69,7 @@
 #include "serialization/vector.h"
 #include "serialization/yamldocument.h"
 #include "skeletalmodeltype.h"
+#include "skinnedmesh.h"
 #include "sprite.h"
 #include "staticmesh.h"
 #include "staticsoundeffect.h"
@@ -76,6 +79,7 @@
 #include "ui/ui.h"
 #include "util/fsutil.h"
 #include "util/helpers.h"
+#include "util/parallel.h"
 
 #include <algorithm>
 #include <boost/log/trivial.hpp>
@@ -91,10 +95,12 @@
 #include <glm/gtx/norm.hpp>
 #include <glm/vec2.hpp>
 #include <gslu.h>
+#include <initializer_list>
 #include <iterator>
 #include <set>
 #include <sstream>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -213,6 +219,14 @@ bool evaluateCondition(floordata::SequenceCondition condition,
 }
 } // namespace
 
+struct World::RenderFrame
+{
+  ui::Ui ui;
+  std::unordered_set<const Portal*> waterEntryPortals;
+  float blackAlpha;
+  bool showPerformanceBar;
+};
+
 void World::swapAllRooms()
 {
   BOOST_LOG_TRIVIAL(info) << "Swapping rooms";
@@ -271,6 +285,18 @@ const std::vector<Box>& World::getBoxes() const
   return m_boxes;
 }
 
+const std::vector<gsl::not_null<const Box*>>& World::getBoxesInZone(const ZoneId Box::*zoneRef,
+                                                                    const ZoneId zone) const
+{
+  static const std::vector<gsl::not_null<const Box*>> empty;
+
+  const auto it = std::find_if(
+    m_zoneBoxes.begin(), m_zoneBoxes.end(), [zoneRef](const auto& zoneBoxes) { return zoneBoxes.first == zoneRef; });
+  Expects(it != m_zoneBoxes.end());
+  const auto boxesIt = it->second.find(zone);
+  return boxesIt == it->second.end() ? empty : boxesIt->second;
+}
+
 void World::useAlternativeLaraAppearance(const bool withHead)
 {
   const auto& base = *findAnimatedModelForType(TR1ItemId::Lara);
@@ -327,11 +353,7 @@ void World::laraBubblesEffect(objects::Object& object)
   const auto position = core::TRVec{boneSpheres.at(14).relative(core::TRVec{0_len, 0_len, 50_len}.toRenderSystem())};
 
   while(bubbleCount-- > 0)
-  {
-    auto particle = gslu::make_nn_shared<BubbleParticle>(Location{object.m_state.location.room, position}, *this);
-    setParent(particle, object.m_state.location.room->node);
-    m_objectManager.registerParticle(particle);
-  }
+    m_objectManager.getParticlePool().emitBubble(*this, Location{object.m_state.location.room, position});
 }
 
 void World::finishLevelEffect()
@@ -612,7 +634,7 @@ void World::update(const bool godMode)
   m_uvAnimTime += 1_frame;
   if(m_uvAnimTime >= UVAnimTime)
   {
-    m_textureAnimator->updateCoordinates(m_atlasTiles);
+    m_textureAnimator->update();
     m_uvAnimTime -= UVAnimTime;
   }
 
@@ -777,7 +799,7 @@ void World::handleCommandSequence(const floordata::FloorDataValue* floorData, co
     {
       const auto& sink = m_cameraSinks.at(command.parameter);
       {
-        m_objectManager.getLara().m_underwaterRoute.setTargetBox(gsl::not_null{&m_boxes.at(sink.box_index)});
+        m_objectManager.getLara().m_underwaterRoute.setTargetBox(*this, gsl::not_null{&m_boxes.at(sink.box_index)});
         auto newTarget = sink.position;
         newTarget.X = m_boxes[sink.box_index].xInterval.clamp(newTarget.X);
         newTarget.Z = m_boxes[sink.box_index].zInterval.clamp(newTarget.Z);
@@ -909,13 +931,11 @@ void World::serialize(const serialization::Serializer<World>& ser)
 
 void World::gameLoop(bool godMode, float waitRatio, float blackAlpha)
 {
-  ui::Ui ui{getPresenter().getMaterialManager()->getUi(), getPalette()};
+  beginTick();
 
-  update(godMode);
-  m_player->laraHealth = m_objectManager.getLara().m_state.health;
+  ui::Ui ui{getPresenter().getMaterialManager()->getUi(), getPalette()};
 
-  const auto waterEntryPortals = m_cameraController->update();
-  doGlobalEffect();
+  const auto waterEntryPortals = simulateFrame(godMode);
   getPresenter().drawBars(ui, m_palette, getObjectManager());
   if(getObjectManager().getLara().getHandStatus() == engine::objects::HandStatus::Combat
      && m_player->selectedWeaponType != WeaponType::Pistols)
@@ -935,42 +955,183 @@ void World::gameLoop(bool godMode, float waitRatio, float blackAlpha)
   }
 
   drawPickupWidgets(ui);
-  getPresenter().renderWorld(getObjectManager(), getRooms(), getCameraController(), waterEntryPortals, waitRatio);
-  getPresenter().renderScreenOverlay();
-  if(blackAlpha > 0)
-  {
-    ui.drawBox({0, 0}, getPresenter().getViewport(), gl::SRGBA8{0, 0, 0, gsl::narrow_cast<uint8_t>(255 * blackAlpha)});
-  }
+  endTick(ui, waterEntryPortals, blackAlpha, true);
+  renderFrame(std::move(ui), waterEntryPortals, waitRatio, blackAlpha, true);
+}
 
-  drawPerformanceBar(ui, waitRatio);
+std::unordered_set<const Portal*> World::simulateFrame(const bool godMode)
+{
+  update(godMode);
+  m_player->laraHealth = m_objectManager.getLara().m_state.health;
 
-  getPresenter().renderUi(ui, 1);
-  getPresenter().updateSoundEngine();
-  getPresenter().swapBuffers();
+  auto waterEntryPortals = m_cameraController->update();
+  doGlobalEffect();
+  return waterEntryPortals;
 }
 
-bool World::cinematicLoop()
+bool World::cinematicLoop(float waitRatio)
 {
   if(++m_cameraController->m_cinematicFrame >= m_cinematicFrames.size())
     return false;
 
+  beginTick();
+
   update(false);
 
-  const auto waterEntryPortals
-    = m_cameraController->updateCinematic(m_cinematicFrames.at(m_cameraController->m_cinematicFrame), false);
+  const auto& waterEntryPortals = m_cameraController->updateCinematic(false);
   doGlobalEffect();
 
   ui::Ui ui{getPresenter().getMaterialManager()->getUi(), getPalette()};
-  getPresenter().renderWorld(getObjectManager(), getRooms(), getCameraController(), waterEntryPortals, 0);
+  endTick(ui, waterEntryPortals, 0, false);
+  renderFrame(std::move(ui), waterEntryPortals, waitRatio, 0, false);
+  return true;
+}
+
+void World::renderInterpolatedFrame(const float bias, const float waitRatio)
+{
+  if(m_lastRenderFrame == nullptr)
+    return;
+
+  m_renderInterpolator.apply(bias);
+  renderFrame(m_lastRenderFrame->ui,
+              m_lastRenderFrame->waterEntryPortals,
+              waitRatio,
+              m_lastRenderFrame->blackAlpha,
+              m_lastRenderFrame->showPerformanceBar);
+}
+
+void World::beginTick()
+{
+  m_renderInterpolator.restore();
+  if(m_engine.getEngineConfig()->renderSettings.renderInterpolation)
+    m_renderInterpolator.beginTick(m_objectManager, *m_cameraController->getCamera());
+}
+
+void World::endTick(const ui::Ui& ui,
+                    const std::unordered_set<const Portal*>& waterEntryPortals,
+                    const float blackAlpha,
+                    const bool showPerformanceBar)
+{
+  if(!m_engine.getEngineConfig()->renderSettings.renderInterpolation)
+  {
+    m_lastRenderFrame.reset();
+    return;
+  }
+
+  m_renderInterpolator.endTick(m_objectManager, *m_cameraController->getCamera());
+  // present the state before the tick first; the following interpolated frames move towards the simulated state
+  m_renderInterpolator.apply(0);
+  m_lastRenderFrame
+    = std::make_unique<RenderFrame>(RenderFrame{ui, waterEntryPortals, blackAlpha, showPerformanceBar});
+}
+
+void World::renderFrame(ui::Ui ui,
+                        const std::unordered_set<const Portal*>& waterEntryPortals,
+                        const float waitRatio,
+                        const float blackAlpha,
+                        const bool showPerformanceBar)
+{
+  updateTextureStreaming();
+  getPresenter().renderWorld(getObjectManager(),
+                             getRooms(),
+                             getCameraController(),
+                             waterEntryPortals,
+                             waitRatio,
+                             [this]() { renderParticlePool(); });
   getPresenter().renderScreenOverlay();
+  if(blackAlpha > 0)
+  {
+    ui.drawBox({0, 0}, getPresenter().getViewport(), gl::SRGBA8{0, 0, 0, gsl::narrow_cast<uint8_t>(255 * blackAlpha)});
+  }
+
+  if(showPerformanceBar)
+    drawPerformanceBar(ui, waitRatio);
+
   getPresenter().renderUi(ui, 1);
   getPresenter().updateSoundEngine();
   getPresenter().swapBuffers();
-  return true;
+}
+
+void World::renderParticlePool()
+{
+  m_objectManager.getParticlePool().render(*this, *m_cameraController->getCamera());
+}
+
+void World::updateTextureStreaming()
+{
+  // rooms are requested by their portal distance to the visible rooms, objects with the priority of their room
+  static constexpr uint32_t MaxPortalDistance = 2;
+  static constexpr auto NotRequested = render::TextureStreamer::LowestPriority;
+
+  std::vector<uint32_t> roomPriorities(m_rooms.size(), NotRequested);
+  std::vector<const Room*> currentRooms;
+  for(const auto& room : m_rooms)
+  {
+    if(!room.node->isVisible())
+      continue;
+    roomPriorities.at(room.physicalId) = 0;
+    currentRooms.emplace_back(&room);
+  }
+  for(uint32_t priority = 1; priority <= MaxPortalDistance; ++priority)
+  {
+    std::vector<const Room*> nextRooms;
+    for(const auto& room : currentRooms)
+    {
+      for(const auto& portal : room->portals)
+      {
+        if(auto& roomPriority = roomPriorities.at(portal.adjoiningRoom->physicalId); roomPriority == NotRequested)
+        {
+          roomPriority = priority;
+          nextRooms.emplace_back(portal.adjoiningRoom.get());
+        }
+      }
+    }
+    currentRooms = std::move(nextRooms);
+  }
+
+  for(const auto& room : m_rooms)
+  {
+    if(const auto priority = roomPriorities.at(room.physicalId); priority != NotRequested)
+    {
+      for(const auto page : room.texturePages)
+        m_textureStreamer->request(page, priority);
+    }
+  }
+
+  const auto requestModel = [this](const core::TypeId& type, const uint32_t priority)
+  {
+    if(const auto& model = findAnimatedModelForType(type); model != nullptr)
+    {
+      for(const auto page : model->texturePages)
+        m_textureStreamer->request(page, priority);
+    }
+  };
+  const auto requestObject = [&requestModel, &roomPriorities](const objects::Object& object)
+  {
+    if(const auto priority = roomPriorities.at(object.m_state.location.room->physicalId); priority != NotRequested)
+      requestModel(object.m_state.type, priority);
+  };
+  for(const auto& object : m_objectManager.getObjects() | boost::adaptors::map_values)
+    requestObject(*object);
+  for(const auto& object : m_objectManager.getDynamicObjects())
+    requestObject(*object);
+
+  // lara's meshes are swapped with the ones of her weapon and outfit models
+  for(const auto type : {TR1ItemId::Lara,
+                         TR1ItemId::LaraPistolsAnim,
+                         TR1ItemId::LaraShotgunAnim,
+                         TR1ItemId::LaraMagnumsAnim,
+                         TR1ItemId::LaraUzisAnim,
+                         TR1ItemId::AlternativeLara})
+    requestModel(type, 0);
+
+  m_textureStreamer->update();
 }
 
 void World::load(const std::optional<size_t>& slot)
 {
+  m_renderInterpolator.restore();
+  m_lastRenderFrame.reset();
   getPresenter().drawLoadingScreen(_("Loading..."));
   const auto filename = m_engine.getSavegamePath(slot);
   BOOST_LOG_TRIVIAL(info) << "Load " << filename;
@@ -992,6 +1153,7 @@ void World::load(const std::optional<size_t>& slot)
 
 void World::save(const std::optional<size_t>& slot)
 {
+  m_renderInterpolator.restore();
   getPresenter().drawLoadingScreen(_("Saving..."));
   const auto filename = m_engine.getSavegamePath(slot);
   BOOST_LOG_TRIVIAL(info) << "Save " << filename;
@@ -1003,6 +1165,25 @@ void World::save(const std::optional<size_t>& slot)
   getPresenter().disableScreenOverlay();
 }
 
+std::string World::createKeyframe()
+{
+  m_renderInterpolator.restore();
+  serialization::YAMLDocument<false> doc{serialization::InMemory{}};
+  doc.save("data", *this, *this);
+  return doc.toString();
+}
+
+void World::restoreKeyframe(const std::string& keyframe)
+{
+  m_renderInterpolator.restore();
+  m_lastRenderFrame.reset();
+  serialization::YAMLDocument<true> doc{serialization::InMemory{}, keyframe};
+  doc.load("data", *this, *this);
+  m_objectManager.getLara().m_state.health = m_player->laraHealth;
+  m_objectManager.getLara().initWeaponAnimData();
+  connectSectors();
+}
+
 std::map<size_t, SavegameInfo> World::getSavedGames() const
 {
   std::map<size_t, SavegameInfo> result;
@@ -1063,24 +1244,52 @@ World::World(Engine& engine,
     = loadControllerButtonIcons(atlases,
                                 util::ensureFileExists(m_engine.getEngineDataPath() / "button-icons" / "buttons.yaml"),
                                 getPresenter().getMaterialManager()->getSprite(true));
-  m_allTextures = buildTextures(*level,
-                                m_engine.getGlidos(),
-                                atlases,
-                                m_atlasTiles,
-                                m_sprites,
-                                [this](const std::string& s) { getPresenter().drawLoadingScreen(s); });
-
-  auto sampler = gslu::make_nn_unique<gl::Sampler>("all-textures");
-  sampler->set(gl::api::TextureMinFilter::NearestMipmapLinear);
-  sampler->set(gl::api::TextureMagFilter::Nearest);
-  sampler->set(gl::api::SamplerParameterI::TextureWrapS, gl::api::TextureWrapMode::ClampToEdge);
-  sampler->set(gl::api::SamplerParameterI::TextureWrapT, gl::api::TextureWrapMode::ClampToEdge);
-  if(const auto anisotropyLevel = getEngine().getEngineConfig()->renderSettings.anisotropyLevel;
-     anisotropyLevel != 0 && gl::hasAnisotropicFilteringExtension())
-    sampler->set(gl::api::SamplerParameterF::TextureMaxAnisotropy, gsl::narrow<float>(anisotropyLevel));
+  // the button icons are used by the ui and must always be resident
+  std::set<size_t> pinnedTexturePages;
+  for(size_t i = 0; i < atlases.getPageCount(); ++i)
+    pinnedTexturePages.emplace(i);
+
+  auto texturePages = buildTextures(*level,
+                                    m_engine.getGlidos(),
+                                    atlases,
+                                    m_atlasTiles,
+                                    m_sprites,
+                                    [this](const std::string& s) { getPresenter().drawLoadingScreen(s); });
+
+  // sprites are used by the ui, and animated tiles are not tracked per room
+  for(const auto& sprite : m_sprites)
+    pinnedTexturePages.emplace(sprite.textureId.get());
+  for(const auto& tileId : m_textureAnimator->getTileIds())
+    pinnedTexturePages.emplace(m_atlasTiles.at(tileId.get()).textureKey.tileAndFlag & loader::file::TextureIndexMask);
+
+  m_textureStreamer
+    = std::make_shared<render::TextureStreamer>(atlases.getSize(),
+                                                std::move(texturePages),
+                                                pinnedTexturePages,
+                                                getEngine().getEngineConfig()->renderSettings.getTextureBudgetBytes());
+
+  const auto createSampler = [this]()
+  {
+    auto sampler = gslu::make_nn_unique<gl::Sampler>("all-textures");
+    sampler->set(gl::api::TextureMinFilter::NearestMipmapLinear);
+    sampler->set(gl::api::TextureMagFilter::Nearest);
+    sampler->set(gl::api::SamplerParameterI::TextureWrapS, gl::api::TextureWrapMode::ClampToEdge);
+    sampler->set(gl::api::SamplerParameterI::TextureWrapT, gl::api::TextureWrapMode::ClampToEdge);
+    if(const auto anisotropyLevel = getEngine().getEngineConfig()->renderSettings.anisotropyLevel;
+       anisotropyLevel != 0 && gl::hasAnisotropicFilteringExtension())
+      sampler->set(gl::api::SamplerParameterF::TextureMaxAnisotropy, gsl::narrow<float>(anisotropyLevel));
+    return sampler;
+  };
   m_allTexturesHandle = std::make_shared<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>>(
-    gsl::not_null{m_allTextures}, std::move(sampler));
-  getPresenter().getMaterialManager()->setGeometryTextures(m_allTexturesHandle);
+    gsl::not_null{m_textureStreamer->getTextures()}, createSampler());
+  m_allTexturesFallbackHandle = std::make_shared<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>>(
+    gsl::not_null{m_textureStreamer->getFallbackTextures()}, createSampler());
+  getPresenter().getMaterialManager()->setGeometryTextures(
+    m_allTexturesHandle, m_allTexturesFallbackHandle, m_textureStreamer->getPageTableBuffer());
+  getPresenter().setTextureStreamer(m_textureStreamer);
+  m_textureAnimator->setAtlasTiles(m_atlasTiles);
+  getPresenter().getMaterialManager()->setTextureAnimation(m_textureAnimator->getAtlasTilesBuffer(),
+                                                           m_textureAnimator->getAnimatedTilesBuffer());
 
   for(size_t i = 0; i < m_sprites.size(); ++i)
   {
@@ -1113,6 +1322,7 @@ World::World(Engine& engine,
   {
     m_audioEngine->addWav(gsl::not_null{&m_samplesData.at(offset)});
   }
+  m_audioEngine->preloadSamples();
 
   getPresenter().drawLoadingScreen(util::unescape(m_title));
 
@@ -1132,6 +1342,8 @@ World::World(Engine& engine,
 
 World::~World()
 {
+  // the samples are decoded from data owned by the world
+  m_audioEngine->stopSampleDecoding();
   m_engine.unregisterWorld(gsl::not_null{this});
 }
 
@@ -1290,9 +1502,14 @@ void World::initFromLevel(loader::file::level::Level& level)
       }
     }
 
-    m_animatedModels.emplace(modelId,
-                             std::make_unique<SkeletalModelType>(SkeletalModelType{
-                               model->type, model->mesh_base_index, std::move(bones), frames, animations}));
+    auto modelType = std::make_unique<SkeletalModelType>(
+      SkeletalModelType{model->type, model->mesh_base_index, std::move(bones), frames, animations});
+    for(const auto& bone : modelType->bones)
+      modelType->texturePages.insert(bone.mesh->getTexturePages().begin(), bone.mesh->getTexturePages().end());
+    modelType->skinnedMesh = std::make_shared<SkinnedMesh>("skinned-mesh:" + std::to_string(model->type.get()));
+    for(size_t i = 0; i < modelType->bones.size(); ++i)
+      (void)modelType->skinnedMesh->getVariant(i, modelType->bones[i].mesh.get());
+    m_animatedModels.emplace(modelId, std::move(modelType));
   }
 
   for(const auto& transitionCase : level.m_transitionCases)
@@ -1373,6 +1590,20 @@ void World::initFromLevel(loader::file::level::Level& level)
     m_boxes[i].zoneGround2Swapped = level.m_alternateZones.groundZone2[i];
   }
 
+  m_zoneBoxes.clear();
+  for(const ZoneId Box::*zoneRef : {&Box::zoneFly,
+                                    &Box::zoneFlySwapped,
+                                    &Box::zoneGround1,
+                                    &Box::zoneGround1Swapped,
+                                    &Box::zoneGround2,
+                                    &Box::zoneGround2Swapped})
+  {
+    auto& [ref, zoneBoxes] = m_zoneBoxes.emplace_back();
+    ref = zoneRef;
+    for(const auto& box : m_boxes)
+      zoneBoxes[box.*zoneRef].emplace_back(&box);
+  }
+
   for(const auto& staticMesh : level.m_staticMeshes)
   {
     RenderMeshDataCompositor compositor;
@@ -1380,9 +1611,16 @@ void World::initFromLevel(loader::file::level::Level& level)
       compositor.append(*meshesDirect.at(staticMesh.mesh)->meshData);
     auto mesh = compositor.toMesh(*getPresenter().getMaterialManager(), false, {});
     mesh->getRenderState().setScissorTest(false);
-    const bool distinct
-      = m_staticMeshes.emplace(staticMesh.id, StaticMesh{staticMesh.collision_box, staticMesh.doNotCollide(), mesh})
-          .second;
+    std::set<uint32_t> texturePages;
+    if(staticMesh.isVisible())
+      texturePages = meshesDirect.at(staticMesh.mesh)->meshData->getTexturePages();
+    const bool distinct = m_staticMeshes
+                            .emplace(staticMesh.id,
+                                     StaticMesh{staticMesh.collision_box,
+                                                staticMesh.doNotCollide(),
+                                                mesh,
+                                                std::move(texturePages)})
+                            .second;
 
     Expects(distinct);
   }
@@ -1433,9 +1671,25 @@ void World::initFromLevel(loader::file::level::Level& level)
                    return CinematicFrame{frame.lookAt, frame.position, toRad(frame.fov), toRad(frame.rotZ)};
                  });
 
+  getPresenter().drawLoadingScreen(_("Building rooms"));
+  // building the geometry only reads the level and the world
+  std::vector<RoomGeometry> roomGeometries(m_rooms.size());
+  util::parallelFor(m_rooms.size(),
+                    [this, &level, &roomGeometries](const size_t i)
+                    {
+                      roomGeometries[i] = m_rooms[i].buildGeometry(level.m_rooms.at(i), *this, *m_textureAnimator);
+                      m_rooms[i].prepareSceneNode(level.m_rooms.at(i), roomGeometries[i]);
+                    });
+
+  // GL resources must be created on the context thread
+  static constexpr size_t ProgressInterval = 32;
   for(size_t i = 0; i < m_rooms.size(); ++i)
   {
-    m_rooms[i].createSceneNode(level.m_rooms.at(i), i, *this, *m_textureAnimator, *getPresenter().getMaterialManager());
+    if(i % ProgressInterval == 0)
+      getPresenter().drawLoadingScreen(_("Uploading rooms (%1%%%)", i * 100 / m_rooms.size()));
+
+    m_rooms[i].createSceneNode(
+      level.m_rooms.at(i), i, *this, roomGeometries[i], *getPresenter().getMaterialManager());
     setParent(gsl::not_null{m_rooms[i].node}, getPresenter().getRenderer().getRootNode());
   }
 
@@ -1488,7 +1742,6 @@ void World::connectSectors()
 {
   for(auto& room : m_rooms)
   {
-    room.collectShaderLights(m_engine.getEngineConfig()->renderSettings.getLightCollectionDepth());
     for(auto& sector : room.sectors)
       sector.connect(m_rooms);
   }
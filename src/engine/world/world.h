@@ -15,6 +15,7 @@
 #include "engine/items_tr1.h"
 #include "engine/objectmanager.h"
 #include "engine/objects/object.h"
+#include "engine/renderinterpolator.h"
 #include "loader/file/item.h"
 #include "mesh.h"
 #include "room.h"
@@ -41,6 +42,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -78,6 +80,7 @@ class Level;
 namespace render
 {
 class TextureAnimator;
+class TextureStreamer;
 } // namespace render
 
 namespace engine::objects
@@ -204,6 +207,9 @@ public:
   bool isValid(const loader::file::AnimFrame* frame) const;
   void swapWithAlternate(Room& orig, Room& alternate);
   [[nodiscard]] const std::vector<Box>& getBoxes() const;
+  //! boxes within the zone, ordered by box id; zoneRef is one of the references returned by Box::getZoneRef
+  [[nodiscard]] const std::vector<gsl::not_null<const Box*>>& getBoxesInZone(const ZoneId Box::*zoneRef,
+                                                                             ZoneId zone) const;
   [[nodiscard]] const std::vector<Room>& getRooms() const;
   std::vector<Room>& getRooms();
   [[nodiscard]] const StaticMesh* findStaticMeshById(const core::StaticMeshId& meshId) const;
@@ -245,9 +251,16 @@ public:
   core::TypeId find(const Sprite* sprite) const;
   void serialize(const serialization::Serializer<World>& ser);
   void gameLoop(bool godMode, float waitRatio, float blackAlpha);
-  bool cinematicLoop();
+  //! advances the game by one frame without rendering it
+  std::unordered_set<const Portal*> simulateFrame(bool godMode);
+  bool cinematicLoop(float waitRatio);
+  // re-renders the last tick with object, camera and pose transforms interpolated from the previous tick
+  void renderInterpolatedFrame(float bias, float waitRatio);
   void load(const std::optional<size_t>& slot);
   void save(const std::optional<size_t>& slot);
+  //! serializes the world into memory, without the savegame metadata
+  [[nodiscard]] std::string createKeyframe();
+  void restoreKeyframe(const std::string& keyframe);
   [[nodiscard]] std::map<size_t, SavegameInfo> getSavedGames() const;
   [[nodiscard]] bool hasSavedGames() const;
 
@@ -289,6 +302,11 @@ public:
     return m_title;
   }
 
+  [[nodiscard]] const auto& getLevelFilename() const
+  {
+    return m_levelFilename;
+  }
+
   [[nodiscard]] auto getTotalSecrets() const
   {
     return m_totalSecrets;
@@ -351,6 +369,8 @@ public:
   }
 
   void drawPerformanceBar(ui::Ui& ui, float waitRatio) const;
+  //! must be called after the portal tracing marked the visible rooms
+  void renderParticlePool();
 
   [[nodiscard]] const auto& getControllerLayouts() const
   {
@@ -363,7 +383,21 @@ public:
   }
 
 private:
+  // everything besides the scene needed to present a tick again
+  struct RenderFrame;
+
   void drawPickupWidgets(ui::Ui& ui);
+  void renderFrame(ui::Ui ui,
+                   const std::unordered_set<const Portal*>& waterEntryPortals,
+                   float waitRatio,
+                   float blackAlpha,
+                   bool showPerformanceBar);
+  void beginTick();
+  void endTick(const ui::Ui& ui,
+               const std::unordered_set<const Portal*>& waterEntryPortals,
+               float blackAlpha,
+               bool showPerformanceBar);
+  void updateTextureStreaming();
 
   Engine& m_engine;
   const std::filesystem::path m_levelFilename;
@@ -371,6 +405,8 @@ private:
   std::unique_ptr<AudioEngine> m_audioEngine;
 
   std::unique_ptr<CameraController> m_cameraController;
+  RenderInterpolator m_renderInterpolator;
+  std::unique_ptr<RenderFrame> m_lastRenderFrame;
 
   core::Frame m_effectTimer = 0_frame;
   std::optional<size_t> m_activeEffect{};
@@ -407,8 +443,9 @@ private:
   std::string m_title{};
   size_t m_totalSecrets = 0;
   std::unordered_map<std::string, std::unordered_map<TR1ItemId, std::string>> m_itemTitles{};
-  std::shared_ptr<gl::Texture2DArray<gl::SRGBA8>> m_allTextures;
+  std::shared_ptr<render::TextureStreamer> m_textureStreamer;
   std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> m_allTexturesHandle;
+  std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> m_allTexturesFallbackHandle;
   core::Frame m_uvAnimTime = 0_frame;
   std::unique_ptr<render::TextureAnimator> m_textureAnimator;
 
@@ -426,6 +463,8 @@ private:
   std::vector<Transitions> m_transitions;
   std::vector<TransitionCase> m_transitionCases;
   std::vector<Box> m_boxes;
+  std::vector<std::pair<const ZoneId Box::*, std::unordered_map<ZoneId, std::vector<gsl::not_null<const Box*>>>>>
+    m_zoneBoxes;
   std::unordered_map<core::StaticMeshId, StaticMesh> m_staticMeshes;
   std::vector<Mesh> m_meshes;
   std::map<core::TypeId, std::unique_ptr<SkeletalModelType>> m_animatedModels;
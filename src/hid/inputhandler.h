@@ -33,6 +33,12 @@ public:
     return m_inputState;
   }
 
+  //! overrides the polled state until the next update, e.g. to play back recorded input
+  void setInputState(const InputState& inputState)
+  {
+    m_inputState = inputState;
+  }
+
   [[nodiscard]] bool hasAction(Action action) const
   {
     if(auto it = m_inputState.actions.find(action); it != m_inputState.actions.end())
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <zlib.h>
@@ -25,6 +26,8 @@ namespace loader::file::io
 {
 using DataStreamBuf = boost::iostreams::filtering_istreambuf;
 
+struct SDLReaderTestAccess;
+
 class SDLReader
 {
 public:
@@ -174,10 +177,18 @@ public:
   void readVector(std::vector<T>& elements, size_t count)
   {
     elements.clear();
-    elements.reserve(count);
-    for(size_t i = 0; i < count; ++i)
+    if constexpr(IsBulkReadable<T>::value)
+    {
+      elements.resize(count);
+      readBulk(elements.data(), count);
+    }
+    else
     {
-      elements.emplace_back(read<T>());
+      elements.reserve(count);
+      for(size_t i = 0; i < count; ++i)
+      {
+        elements.emplace_back(read<T>());
+      }
     }
   }
 
@@ -237,6 +248,29 @@ public:
   }
 
 private:
+  //! gives the tests access to the bulk read traits
+  friend struct SDLReaderTestAccess;
+
+  // types whose in-memory representation matches the file layout, so arrays of them can be read with a single call
+  template<typename T>
+  struct IsBulkReadable : std::bool_constant<std::is_integral_v<T> || std::is_floating_point_v<T>>
+  {
+  };
+
+  template<typename T>
+  struct IsBulkReadable<type_safe::integer<T>>
+      : std::bool_constant<IsBulkReadable<T>::value && sizeof(type_safe::integer<T>) == sizeof(T)
+                           && std::is_trivially_copyable_v<type_safe::integer<T>>>
+  {
+  };
+
+  template<typename U, typename T>
+  struct IsBulkReadable<qs::quantity<U, T>>
+      : std::bool_constant<IsBulkReadable<T>::value && sizeof(qs::quantity<U, T>) == sizeof(T)
+                           && std::is_trivially_copyable_v<qs::quantity<U, T>>>
+  {
+  };
+
   // Do not change the order of these member variables.
   std::vector<char> m_memory;
 
@@ -248,6 +282,25 @@ private:
 
   std::istream m_stream;
 
+  template<typename T>
+  void readBulk(T* dest, const size_t n)
+  {
+    static_assert(IsBulkReadable<T>::value);
+    const auto bytes = static_cast<std::streamsize>(n * sizeof(T));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    m_stream.read(reinterpret_cast<char*>(dest), bytes);
+    if(m_stream.gcount() != bytes)
+    {
+      BOOST_THROW_EXCEPTION(std::runtime_error("EOF unexpectedly reached"));
+    }
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      SwapTraits<T, sizeof(T), std::is_integral_v<T> || std::is_floating_point_v<T>>::doSwap(dest[i]);
+    }
+  }
+
   template<typename T, int dataSize, bool isIntegral>
   struct SwapTraits
   {
@@ -9,11 +9,14 @@
 #include "tr5level.h"
 #include "util/helpers.h"
 #include "util/md5.h"
+#include "util/parallel.h"
 
 #include <algorithm>
 #include <array>
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/log/trivial.hpp>
 #include <boost/throw_exception.hpp>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <gsl/gsl-lite.hpp>
@@ -22,6 +25,7 @@
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace loader::file::level
 {
@@ -87,6 +91,19 @@ std::unique_ptr<Level> Level::createLoader(const std::filesystem::path& filename
   return createLoader(std::move(reader), filename, gameVersion, sfxPath);
 }
 
+std::unique_ptr<Level> Level::load(const std::filesystem::path& filename)
+{
+  auto level = createLoader(filename, Game::Unknown);
+  if(level == nullptr)
+    BOOST_THROW_EXCEPTION(std::runtime_error("Unsupported level file"));
+
+  const auto start = std::chrono::steady_clock::now();
+  level->loadFileData();
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  BOOST_LOG_TRIVIAL(info) << "Parsed " << filename << " in " << elapsed.count() << "ms";
+  return level;
+}
+
 std::unique_ptr<Level> Level::createLoader(io::SDLReader&& reader,
                                            const std::filesystem::path& filename,
                                            Game game_version,
@@ -194,7 +211,9 @@ Game Level::probeVersion(io::SDLReader& reader, const std::filesystem::path& fil
   return ret;
 }
 
-void Level::convertTexture(ByteTexture& tex, Palette& pal, DWordTexture& dst)
+namespace
+{
+void convertTexture(const ByteTexture& tex, const Palette& pal, DWordTexture& dst)
 {
   for(int y = 0; y < 256; y++)
   {
@@ -208,11 +227,9 @@ void Level::convertTexture(ByteTexture& tex, Palette& pal, DWordTexture& dst)
         dst.pixels[y][x] = {0, 0, 0, 0};
     }
   }
-
-  dst.md5 = util::md5(&tex.pixels[0][0], 256u * 256u);
 }
 
-void Level::convertTexture(WordTexture& tex, DWordTexture& dst)
+void convertTexture(const WordTexture& tex, DWordTexture& dst)
 {
   for(int y = 0; y < 256; y++)
   {
@@ -234,4 +251,46 @@ void Level::convertTexture(WordTexture& tex, DWordTexture& dst)
     }
   }
 }
+} // namespace
+
+void Level::convertTextures(const std::vector<ByteTexture>& textures,
+                            const Palette& pal,
+                            std::vector<DWordTexture>& dst)
+{
+  const auto start = std::chrono::steady_clock::now();
+  dst.resize(textures.size());
+  // each task converts and hashes a batch of textures, so all lanes of the multi-buffer hash are used
+  const auto batches = (textures.size() + util::Md5Lanes - 1) / util::Md5Lanes;
+  util::parallelFor(batches,
+                    [&](const size_t batch)
+                    {
+                      const auto first = batch * util::Md5Lanes;
+                      const auto last = std::min(first + util::Md5Lanes, textures.size());
+                      std::vector<gsl::span<const uint8_t>> pixels;
+                      pixels.reserve(last - first);
+                      for(auto i = first; i < last; ++i)
+                      {
+                        convertTexture(textures[i], pal, dst[i]);
+                        pixels.emplace_back(&textures[i].pixels[0][0], 256u * 256u);
+                      }
+                      const auto hashes = util::md5(pixels);
+                      for(auto i = first; i < last; ++i)
+                        dst[i].md5 = hashes[i - first];
+                    });
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  BOOST_LOG_TRIVIAL(debug) << "Converted and hashed " << textures.size() << " textures in "
+                           << elapsed.count() << "ms";
+}
+
+void Level::convertTextures(const std::vector<WordTexture>& textures, std::vector<DWordTexture>& dst)
+{
+  const auto start = std::chrono::steady_clock::now();
+  dst.resize(textures.size());
+  util::parallelFor(textures.size(), [&](const size_t i) { convertTexture(textures[i], dst[i]); });
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  BOOST_LOG_TRIVIAL(debug) << "Converted " << textures.size() << " textures in "
+                           << elapsed.count() << "ms";
+}
 } // namespace loader::file::level
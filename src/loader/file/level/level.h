@@ -102,6 +102,9 @@ public:
 
   static std::unique_ptr<Level> createLoader(const std::filesystem::path& filename, Game gameVersion);
 
+  //! creates the loader for the file, detecting the game version, and parses the file
+  static std::unique_ptr<Level> load(const std::filesystem::path& filename);
+
   virtual void loadFileData() = 0;
 
   const auto& getFilename() const
@@ -116,9 +119,13 @@ protected:
 
   void readMeshData(io::SDLReader& reader);
 
-  static void convertTexture(ByteTexture& tex, Palette& pal, DWordTexture& dst);
+  //! converts all pages in parallel and hashes the palettized source pixels
+  static void convertTextures(const std::vector<ByteTexture>& textures,
+                              const Palette& pal,
+                              std::vector<DWordTexture>& dst);
 
-  static void convertTexture(WordTexture& tex, DWordTexture& dst);
+  //! converts all pages in parallel
+  static void convertTextures(const std::vector<WordTexture>& textures, std::vector<DWordTexture>& dst);
 
 private:
   const std::filesystem::path m_filename;
@@ -151,8 +151,6 @@ void TR3Level::loadFileData()
     m_reader.readVector(m_samplesData, newsrc.size());
   }
 
-  m_textures.resize(texture16.size());
-  for(size_t i = 0; i < texture16.size(); i++)
-    convertTexture(texture16[i], m_textures[i]);
+  convertTextures(texture16, m_textures);
 }
 } // namespace loader::file::level
@@ -237,8 +237,6 @@ void TR5Level::loadFileData()
   if(!m_textures.empty())
     return;
 
-  m_textures.resize(texture16.size());
-  for(size_t i = 0; i < texture16.size(); i++)
-    convertTexture(texture16[i], m_textures[i]);
+  convertTextures(texture16, m_textures);
 }
 } // namespace loader::file::level
@@ -0,0 +1,138 @@
+#define BOOST_TEST_MODULE loader
+
+#include "core/units.h"
+#include "file/io/sdlreader.h"
+
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using loader::file::io::SDLReader;
+
+namespace loader::file::io
+{
+struct SDLReaderTestAccess
+{
+  template<typename T>
+  static constexpr bool IsBulkReadable = SDLReader::IsBulkReadable<T>::value;
+};
+} // namespace loader::file::io
+
+using loader::file::io::SDLReaderTestAccess;
+
+static_assert(SDLReaderTestAccess::IsBulkReadable<uint8_t>);
+static_assert(SDLReaderTestAccess::IsBulkReadable<int16_t>);
+static_assert(SDLReaderTestAccess::IsBulkReadable<float>);
+static_assert(SDLReaderTestAccess::IsBulkReadable<type_safe::integer<int16_t>>);
+static_assert(SDLReaderTestAccess::IsBulkReadable<type_safe::integer<uint32_t>>);
+static_assert(SDLReaderTestAccess::IsBulkReadable<core::Length>);
+static_assert(SDLReaderTestAccess::IsBulkReadable<core::Frame>);
+static_assert(!SDLReaderTestAccess::IsBulkReadable<glm::vec3>);
+
+namespace
+{
+std::vector<char> createData(const size_t size)
+{
+  std::vector<char> data(size);
+  for(size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>((i * 37u + 11u) & 0xffu);
+  return data;
+}
+
+// reads the same data with the bulk path and element by element
+template<typename T>
+void checkBulkReadMatchesElementwise()
+{
+  static_assert(SDLReaderTestAccess::IsBulkReadable<T>);
+  static constexpr size_t Count = 13;
+  const auto data = createData(Count * sizeof(T) + 3);
+
+  SDLReader bulkReader{data};
+  // start at an odd offset, the bulk path must not rely on alignment
+  bulkReader.skip(1);
+  std::vector<T> bulk;
+  bulkReader.readVector(bulk, Count);
+
+  SDLReader elementReader{data};
+  elementReader.skip(1);
+  BOOST_REQUIRE_EQUAL(bulk.size(), Count);
+  for(size_t i = 0; i < Count; ++i)
+    BOOST_CHECK(bulk[i] == elementReader.read<T>());
+
+  BOOST_CHECK_EQUAL(bulkReader.tell(), elementReader.tell());
+}
+
+// reads an array the size of a large level's geometry both ways, and returns the bulk and element-wise read times
+template<typename T>
+std::pair<std::chrono::steady_clock::duration, std::chrono::steady_clock::duration> measureReadVector()
+{
+  static constexpr size_t Count = 1u << 20u;
+  const auto data = createData(Count * sizeof(T));
+
+  SDLReader bulkReader{data};
+  std::vector<T> bulk;
+  const auto bulkStart = std::chrono::steady_clock::now();
+  bulkReader.readVector(bulk, Count);
+  const auto bulkTime = std::chrono::steady_clock::now() - bulkStart;
+
+  SDLReader elementReader{data};
+  std::vector<T> elements;
+  const auto elementStart = std::chrono::steady_clock::now();
+  elements.reserve(Count);
+  for(size_t i = 0; i < Count; ++i)
+    elements.emplace_back(elementReader.read<T>());
+  const auto elementTime = std::chrono::steady_clock::now() - elementStart;
+
+  BOOST_CHECK(bulk == elements);
+  return {bulkTime, elementTime};
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(loader_tests)
+
+BOOST_AUTO_TEST_CASE(test_bulk_read_primitives)
+{
+  checkBulkReadMatchesElementwise<int16_t>();
+  checkBulkReadMatchesElementwise<uint32_t>();
+  checkBulkReadMatchesElementwise<float>();
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk_read_type_safe_integers)
+{
+  checkBulkReadMatchesElementwise<type_safe::integer<int16_t>>();
+  checkBulkReadMatchesElementwise<type_safe::integer<uint32_t>>();
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk_read_quantities)
+{
+  checkBulkReadMatchesElementwise<core::Length>();
+  checkBulkReadMatchesElementwise<core::Frame>();
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk_read_eof)
+{
+  SDLReader reader{createData(10)};
+  std::vector<uint32_t> values;
+  BOOST_CHECK_THROW(reader.readVector(values, 3), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(test_bulk_read_benchmark, *boost::unit_test::label("benchmark"))
+{
+  const auto report = [](const char* type, const auto& times)
+  {
+    BOOST_TEST_MESSAGE("readVector<" << type << ">: "
+                                     << std::chrono::duration_cast<std::chrono::microseconds>(times.first).count()
+                                     << "us bulk, "
+                                     << std::chrono::duration_cast<std::chrono::microseconds>(times.second).count()
+                                     << "us element-wise");
+  };
+  report("int16_t", measureReadVector<int16_t>());
+  report("type_safe::integer<uint16_t>", measureReadVector<type_safe::integer<uint16_t>>());
+  report("core::Length", measureReadVector<core::Length>());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,8 +1,10 @@
 #include "trx.h"
 
 #include "core/i18n.h"
+#include "util/binaryio.h"
 #include "util/helpers.h"
 
+#include <array>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/replace.hpp>
@@ -21,6 +23,7 @@
 #include <regex>
 #include <sstream>
 #include <stdexcept>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 
@@ -49,6 +52,31 @@ std::filesystem::path readSymlink(const std::filesystem::path& root,
   srcTimestamp = std::max(srcTimestamp, last_write_time(root / ref));
   return readSymlink(root, head, srcTimestamp);
 }
+
+constexpr std::array<char, 4> ManifestMagic{'E', 'E', 'G', 'M'};
+// bump whenever the manifest layout or the pack resolution producing it changes
+constexpr uint32_t ManifestVersion = 1;
+
+struct ManifestTile
+{
+  uint32_t x0;
+  uint32_t y0;
+  uint32_t x1;
+  uint32_t y1;
+  //! index into the manifest's file table, or -1 if the replacement file does not exist
+  int32_t file;
+};
+
+int64_t toManifestTime(const std::filesystem::file_time_type& timestamp)
+{
+  return gsl::narrow<int64_t>(timestamp.time_since_epoch().count());
+}
+
+std::filesystem::file_time_type fromManifestTime(const int64_t timestamp)
+{
+  return std::filesystem::file_time_type{
+    std::filesystem::file_time_type::duration{gsl::narrow<std::filesystem::file_time_type::rep>(timestamp)}};
+}
 } // namespace
 
 namespace loader::trx
@@ -318,7 +346,9 @@ PathMap::PathMap(const std::filesystem::path& baseTxtName,
   }
 }
 
-Glidos::Glidos(std::filesystem::path baseDir, const std::function<void(const std::string&)>& statusCallback)
+Glidos::Glidos(std::filesystem::path baseDir,
+               const std::filesystem::path& manifestPath,
+               const std::function<void(const std::string&)>& statusCallback)
     : m_baseDir{std::move(baseDir)}
 {
   if(!is_directory(m_baseDir))
@@ -328,9 +358,61 @@ Glidos::Glidos(std::filesystem::path baseDir, const std::function<void(const std
 
   m_rootTimestamp = last_write_time(util::ensureFileExists(m_baseDir / "equiv.txt"));
 
+  const auto packTimestamp = getPackTimestamp();
+  if(loadManifest(manifestPath, packTimestamp))
+    return;
+
+  scan(statusCallback);
+  saveManifest(manifestPath, packTimestamp);
+}
+
+std::filesystem::file_time_type Glidos::getPackTimestamp() const
+{
+  // adding, removing or renaming part maps and texture directories touches the top-level directories, and the
+  // replacement files are covered by the newest source timestamps stored in the manifest
+  auto timestamp = std::max(last_write_time(m_baseDir), m_rootTimestamp);
+  const std::filesystem::directory_iterator end{};
+  for(std::filesystem::directory_iterator it{m_baseDir}; it != end; ++it)
+  {
+    std::error_code ec;
+    if(!it->is_directory(ec) || ec)
+      continue;
+
+    const auto entryTimestamp = it->last_write_time(ec);
+    if(!ec)
+      timestamp = std::max(timestamp, entryTimestamp);
+  }
+  return timestamp;
+}
+
+void Glidos::updateNewestSources()
+{
+  std::map<std::filesystem::path, std::filesystem::file_time_type> fileTimestamps;
+  for(auto& [textureId, texture] : m_tilesByTexture)
+  {
+    for(const auto& [tile, file] : texture.tiles)
+    {
+      if(file.empty())
+        continue;
+
+      auto [it, inserted] = fileTimestamps.emplace(file, std::filesystem::file_time_type{});
+      if(inserted)
+      {
+        std::error_code ec;
+        it->second = last_write_time(file, ec);
+      }
+      texture.newestSource = std::max(texture.newestSource, it->second);
+    }
+  }
+}
+
+void Glidos::scan(const std::function<void(const std::string&)>& statusCallback)
+{
   BOOST_LOG_TRIVIAL(debug) << "Loading equiv.txt";
   const Equiv equiv{m_baseDir / "equiv.txt", statusCallback};
 
+  std::map<TexturePart, std::filesystem::path> filesByPart;
+  std::map<std::string, std::filesystem::file_time_type> newestTextureSourceTimestamps;
   std::vector<PathMap> maps;
 
   const std::filesystem::directory_iterator end{};
@@ -344,29 +426,182 @@ Glidos::Glidos(std::filesystem::path baseDir, const std::function<void(const std
 
     statusCallback(_("Glidos - Loading %1%", it->path().filename().string()));
     BOOST_LOG_TRIVIAL(debug) << "Loading part map " << it->path();
-    maps.emplace_back(it->path(), m_newestTextureSourceTimestamps, m_rootTimestamp, m_filesByPart);
+    maps.emplace_back(it->path(), newestTextureSourceTimestamps, m_rootTimestamp, filesByPart);
   }
 
   BOOST_LOG_TRIVIAL(debug) << "Resolving links and equiv sets for " << maps.size() << " mappings";
   for(const auto& map : maps)
   {
-    equiv.resolve(map.getRoot(), m_newestTextureSourceTimestamps, m_rootTimestamp, m_filesByPart, statusCallback);
+    equiv.resolve(map.getRoot(), newestTextureSourceTimestamps, m_rootTimestamp, filesByPart, statusCallback);
   }
   statusCallback(_("Glidos - Resolving maps (100%)"));
+
+  // probe every referenced file once, so loading a level does not need to touch the file system for missing files
+  std::map<std::filesystem::path, bool> fileExists;
+  for(const auto& [part, file] : filesByPart)
+  {
+    auto [it, inserted] = fileExists.emplace(file, false);
+    if(inserted)
+      it->second = is_regular_file(file);
+
+    m_tilesByTexture[part.getId()].tiles[part.getRectangle()] = it->second ? file : std::filesystem::path{};
+  }
+  for(const auto& [textureId, timestamp] : newestTextureSourceTimestamps)
+    m_tilesByTexture[textureId].newestSource = timestamp;
+  updateNewestSources();
+}
+
+bool Glidos::loadManifest(const std::filesystem::path& manifestPath,
+                          const std::filesystem::file_time_type& packTimestamp)
+{
+  std::ifstream stream{manifestPath, std::ios::in | std::ios::binary};
+  if(!stream.is_open())
+    return false;
+
+  std::array<char, 4> magic{};
+  uint32_t version = 0;
+  std::vector<char> baseDir;
+  int64_t timestamp = 0;
+  if(!util::readValue(stream, magic) || magic != ManifestMagic || !util::readValue(stream, version)
+     || version != ManifestVersion || !util::readBlock(stream, baseDir)
+     || std::string{baseDir.begin(), baseDir.end()} != m_baseDir.string() || !util::readValue(stream, timestamp)
+     || timestamp != toManifestTime(packTimestamp))
+  {
+    BOOST_LOG_TRIVIAL(info) << "Glidos manifest " << manifestPath << " is outdated";
+    return false;
+  }
+
+  const auto fail = [this, &manifestPath]()
+  {
+    BOOST_LOG_TRIVIAL(warning) << "Glidos manifest " << manifestPath << " is truncated";
+    m_tilesByTexture.clear();
+    return false;
+  };
+
+  uint32_t fileCount = 0;
+  if(!util::readValue(stream, fileCount))
+    return fail();
+  std::vector<std::filesystem::path> files;
+  files.reserve(fileCount);
+  for(uint32_t i = 0; i < fileCount; ++i)
+  {
+    std::vector<char> file;
+    if(!util::readBlock(stream, file))
+      return fail();
+    files.emplace_back(std::string{file.begin(), file.end()});
+  }
+
+  uint32_t textureCount = 0;
+  if(!util::readValue(stream, textureCount))
+    return fail();
+  for(uint32_t i = 0; i < textureCount; ++i)
+  {
+    std::vector<char> textureId;
+    int64_t newestSource = 0;
+    std::vector<ManifestTile> tiles;
+    if(!util::readBlock(stream, textureId) || !util::readValue(stream, newestSource) || !util::readBlock(stream, tiles))
+      return fail();
+
+    auto& texture = m_tilesByTexture[std::string{textureId.begin(), textureId.end()}];
+    texture.newestSource = fromManifestTime(newestSource);
+    for(const auto& tile : tiles)
+    {
+      if(tile.file >= 0 && static_cast<size_t>(tile.file) >= files.size())
+        return fail();
+
+      texture.tiles[Rectangle{tile.x0, tile.y0, tile.x1, tile.y1}]
+        = tile.file >= 0 ? files[static_cast<size_t>(tile.file)] : std::filesystem::path{};
+    }
+  }
+
+  BOOST_LOG_TRIVIAL(debug) << "Loaded Glidos manifest " << manifestPath << " with " << m_tilesByTexture.size()
+                           << " textures";
+  return true;
+}
+
+void Glidos::saveManifest(const std::filesystem::path& manifestPath,
+                          const std::filesystem::file_time_type& packTimestamp) const
+{
+  std::error_code ec;
+  std::filesystem::create_directories(manifestPath.parent_path(), ec);
+
+  // write to a temporary file first so an interrupted write never leaves a valid-looking manifest behind
+  auto tmpPath = manifestPath;
+  tmpPath += ".tmp";
+  {
+    std::ofstream stream{tmpPath, std::ios::out | std::ios::binary | std::ios::trunc};
+    if(!stream.is_open())
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Failed to write Glidos manifest " << manifestPath;
+      return;
+    }
+
+    std::map<std::filesystem::path, int32_t> fileIndices;
+    for(const auto& [textureId, texture] : m_tilesByTexture)
+    {
+      for(const auto& [tile, file] : texture.tiles)
+      {
+        if(!file.empty())
+          fileIndices.emplace(file, gsl::narrow<int32_t>(fileIndices.size()));
+      }
+    }
+    std::vector<const std::filesystem::path*> files(fileIndices.size());
+    for(const auto& [file, index] : fileIndices)
+      files[static_cast<size_t>(index)] = &file;
+
+    const auto baseDir = m_baseDir.string();
+    util::writeValue(stream, ManifestMagic);
+    util::writeValue(stream, ManifestVersion);
+    util::writeBlock(stream, std::vector<char>{baseDir.begin(), baseDir.end()});
+    util::writeValue(stream, toManifestTime(packTimestamp));
+
+    util::writeValue(stream, gsl::narrow<uint32_t>(files.size()));
+    for(const auto& file : files)
+    {
+      const auto str = file->string();
+      util::writeBlock(stream, std::vector<char>{str.begin(), str.end()});
+    }
+
+    util::writeValue(stream, gsl::narrow<uint32_t>(m_tilesByTexture.size()));
+    for(const auto& [textureId, texture] : m_tilesByTexture)
+    {
+      std::vector<ManifestTile> tiles;
+      tiles.reserve(texture.tiles.size());
+      for(const auto& [tile, file] : texture.tiles)
+      {
+        tiles.emplace_back(ManifestTile{
+          tile.getX0(), tile.getY0(), tile.getX1(), tile.getY1(), file.empty() ? -1 : fileIndices.at(file)});
+      }
+
+      util::writeBlock(stream, std::vector<char>{textureId.begin(), textureId.end()});
+      util::writeValue(stream, toManifestTime(texture.newestSource));
+      util::writeBlock(stream, tiles);
+    }
+
+    if(!stream.good())
+    {
+      BOOST_LOG_TRIVIAL(warning) << "Failed to write Glidos manifest " << manifestPath;
+      return;
+    }
+  }
+
+  std::filesystem::rename(tmpPath, manifestPath, ec);
+  if(ec)
+    BOOST_LOG_TRIVIAL(warning) << "Failed to write Glidos manifest " << manifestPath << ": " << ec.message();
+  else
+    BOOST_LOG_TRIVIAL(info) << "Glidos manifest written to " << manifestPath;
 }
 
 Glidos::TileMap Glidos::getMappingsForTexture(const std::string& textureId) const
 {
   TileMap result;
-  result.newestSource = std::max(m_newestTextureSourceTimestamps[textureId], m_rootTimestamp);
+  result.newestSource = m_rootTimestamp;
   result.baseDir = m_baseDir;
 
-  for(const auto& [part, file] : m_filesByPart)
+  if(const auto it = m_tilesByTexture.find(textureId); it != m_tilesByTexture.end())
   {
-    if(part.getId() != textureId)
-      continue;
-
-    result.tiles[part.getRectangle()] = file;
+    result.tiles = it->second.tiles;
+    result.newestSource = std::max(it->second.newestSource, m_rootTimestamp);
   }
 
   return result;
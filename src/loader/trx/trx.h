@@ -181,10 +181,15 @@ private:
 class Glidos
 {
 public:
-  explicit Glidos(std::filesystem::path baseDir, const std::function<void(const std::string&)>& statusCallback);
+  //! the resolved mappings are cached in manifestPath and reused as long as equiv.txt and the top-level directories
+  //! of the pack are unchanged
+  explicit Glidos(std::filesystem::path baseDir,
+                  const std::filesystem::path& manifestPath,
+                  const std::function<void(const std::string&)>& statusCallback);
 
   struct TileMap
   {
+    //! empty paths refer to tiles whose replacement file does not exist
     std::map<Rectangle, std::filesystem::path> tiles;
     std::filesystem::file_time_type newestSource;
     std::filesystem::path baseDir;
@@ -198,9 +203,24 @@ public:
   }
 
 private:
-  std::map<TexturePart, std::filesystem::path> m_filesByPart;
+  struct TextureTiles
+  {
+    std::map<Rectangle, std::filesystem::path> tiles;
+    std::filesystem::file_time_type newestSource{};
+  };
+
+  //! newest modification time of equiv.txt, the pack directory and its top-level directories
+  [[nodiscard]] std::filesystem::file_time_type getPackTimestamp() const;
+  //! includes the modification times of the replacement files in the texture timestamps; only done while scanning,
+  //! the manifest stores the result
+  void updateNewestSources();
+  void scan(const std::function<void(const std::string&)>& statusCallback);
+  bool loadManifest(const std::filesystem::path& manifestPath, const std::filesystem::file_time_type& packTimestamp);
+  void saveManifest(const std::filesystem::path& manifestPath,
+                    const std::filesystem::file_time_type& packTimestamp) const;
+
   const std::filesystem::path m_baseDir;
-  mutable std::map<std::string, std::filesystem::file_time_type> m_newestTextureSourceTimestamps;
   std::filesystem::file_time_type m_rootTimestamp;
+  std::map<std::string, TextureTiles> m_tilesByTexture;
 };
 } // namespace loader::trx
@@ -178,6 +178,21 @@ RenderSettingsMenuState::RenderSettingsMenuState(const std::shared_ptr<MenuRingT
     /* translators: TR charmap encoding */ _("HBAO"),
     [&engine]() { return engine.getEngineConfig()->renderSettings.hbao; },
     [&engine]() { toggle(engine, engine.getEngineConfig()->renderSettings.hbao); });
+  m_hbaoResolutionCheckbox = listBox->addSetting(
+    "",
+    [&engine]() { return engine.getEngineConfig()->renderSettings.getHBAOResolutionDivisor() > 1; },
+    [&engine]()
+    {
+      auto& divisor = engine.getEngineConfig()->renderSettings.hbaoResolutionDivisor;
+      divisor = engine.getEngineConfig()->renderSettings.getHBAOResolutionDivisor() * 2;
+      if(divisor > 4)
+        divisor = 1;
+      engine.applySettings();
+    });
+  listBox->addSetting(
+    /* translators: TR charmap encoding */ _("Temporal HBAO"),
+    [&engine]() { return engine.getEngineConfig()->renderSettings.hbaoTemporal; },
+    [&engine]() { toggle(engine, engine.getEngineConfig()->renderSettings.hbaoTemporal); });
   listBox->addSetting(
     /* translators: TR charmap encoding */ _("FXAA"),
     [&engine]() { return engine.getEngineConfig()->renderSettings.fxaa; },
@@ -186,6 +201,14 @@ RenderSettingsMenuState::RenderSettingsMenuState(const std::shared_ptr<MenuRingT
     /* translators: TR charmap encoding */ _("High Quality Shadows"),
     [&engine]() { return engine.getEngineConfig()->renderSettings.highQualityShadows; },
     [&engine]() { toggle(engine, engine.getEngineConfig()->renderSettings.highQualityShadows); });
+  listBox->addSetting(
+    /* translators: TR charmap encoding */ _("Throttle Far Shadows"),
+    [&engine]() { return engine.getEngineConfig()->renderSettings.throttleFarShadows; },
+    [&engine]() { toggle(engine, engine.getEngineConfig()->renderSettings.throttleFarShadows); });
+  listBox->addSetting(
+    /* translators: TR charmap encoding */ _("Dynamic Resolution"),
+    [&engine]() { return engine.getEngineConfig()->renderSettings.dynamicResolution; },
+    [&engine]() { toggle(engine, engine.getEngineConfig()->renderSettings.dynamicResolution); });
 
   listBox = std::make_shared<CheckListBox>(/* translators: TR charmap encoding */ _("Other"));
   m_listBoxes.emplace_back(listBox);
@@ -197,6 +220,10 @@ RenderSettingsMenuState::RenderSettingsMenuState(const std::shared_ptr<MenuRingT
     /* translators: TR charmap encoding */ _("More Lights"),
     [&engine]() { return engine.getEngineConfig()->renderSettings.moreLights; },
     [&engine]() { toggle(engine, engine.getEngineConfig()->renderSettings.moreLights); });
+  listBox->addSetting(
+    /* translators: TR charmap encoding */ _("Render Interpolation"),
+    [&engine]() { return engine.getEngineConfig()->renderSettings.renderInterpolation; },
+    [&engine]() { toggle(engine, engine.getEngineConfig()->renderSettings.renderInterpolation); });
   listBox->addSetting(
     /* translators: TR charmap encoding */ _("Performance Meter"),
     [&engine]() { return engine.getEngineConfig()->displaySettings.performanceMeter; },
@@ -210,6 +237,11 @@ RenderSettingsMenuState::RenderSettingsMenuState(const std::shared_ptr<MenuRingT
 std::unique_ptr<MenuState>
   RenderSettingsMenuState::onFrame(ui::Ui& ui, engine::world::World& world, MenuDisplay& /*display*/)
 {
+  const uint32_t hbaoResolutionDivisor
+    = world.getEngine().getEngineConfig()->renderSettings.getHBAOResolutionDivisor();
+  m_hbaoResolutionCheckbox->setLabel(
+    /* translators: TR charmap encoding */ _("1/%1% HBAO Resolution", hbaoResolutionDivisor));
+
   if(m_anisotropyCheckbox != nullptr)
   {
     m_anisotropyCheckbox->setLabel(/* translators: TR charmap encoding */ _(
@@ -40,6 +40,7 @@ private:
   size_t m_currentListBox = 0;
   std::unique_ptr<MenuState> m_previous;
   std::shared_ptr<ui::widgets::Checkbox> m_anisotropyCheckbox;
+  std::shared_ptr<ui::widgets::Checkbox> m_hbaoResolutionCheckbox;
 
 public:
   explicit RenderSettingsMenuState(const std::shared_ptr<MenuRingTransform>& ringTransform,
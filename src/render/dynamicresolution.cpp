@@ -0,0 +1,67 @@
+#include "dynamicresolution.h"
+
+#include "rendersettings.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <glm/common.hpp>
+
+namespace render
+{
+void DynamicResolution::configure(const RenderSettings& renderSettings)
+{
+  m_enabled = renderSettings.dynamicResolution;
+  m_maxScale = std::clamp(renderSettings.dynamicResolutionMaxScale, ScaleStep, 1.0f);
+  m_minScale = std::clamp(renderSettings.dynamicResolutionMinScale, ScaleStep, m_maxScale);
+  m_upperBudget = renderSettings.dynamicResolutionUpperBudget;
+  m_lowerBudget = std::min(renderSettings.dynamicResolutionLowerBudget, m_upperBudget);
+  m_scale = m_enabled ? std::clamp(m_scale, m_minScale, m_maxScale) : 1.0f;
+  m_cooldown = 0;
+  m_cooldownLength = Cooldown;
+  m_sustained = 0;
+  m_lastStep = 0;
+}
+
+bool DynamicResolution::update(const float budgetUsage)
+{
+  if(!m_enabled)
+    return false;
+
+  if(m_cooldown > 0)
+  {
+    --m_cooldown;
+    return false;
+  }
+
+  if(budgetUsage > m_upperBudget)
+    m_sustained = std::max(m_sustained, 0) + 1;
+  else if(budgetUsage < m_lowerBudget)
+    m_sustained = std::min(m_sustained, 0) - 1;
+  else
+    m_sustained = 0;
+
+  if(static_cast<uint32_t>(std::abs(m_sustained)) < SustainFrames)
+    return false;
+
+  const int32_t step = m_sustained > 0 ? -1 : 1;
+  m_sustained = 0;
+  const auto scale = std::clamp(m_scale + static_cast<float>(step) * ScaleStep, m_minScale, m_maxScale);
+  if(scale == m_scale)
+    return false;
+
+  if(m_lastStep != 0 && step != m_lastStep)
+    m_cooldownLength = std::min(m_cooldownLength * 2, MaxCooldown);
+  else
+    m_cooldownLength = Cooldown;
+
+  m_lastStep = step;
+  m_scale = scale;
+  m_cooldown = m_cooldownLength;
+  return true;
+}
+
+glm::ivec2 DynamicResolution::getRenderSize(const glm::ivec2& displaySize) const
+{
+  return glm::max(glm::ivec2{glm::vec2{displaySize} * m_scale}, glm::ivec2{1});
+}
+} // namespace render
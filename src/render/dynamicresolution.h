@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace render
+{
+struct RenderSettings;
+
+// Adjusts the internal render scale from the share of the frame budget spent on the previous frames; the result only
+// depends on the fed samples, so it can be driven by synthetic frame timings. Changing the scale recreates the render
+// targets, so the budget must be missed for a while before a step is taken, and a step reverting the previous one
+// doubles the time until the next step, so an oscillating load doesn't cause a step every few frames.
+class DynamicResolution
+{
+public:
+  static constexpr float ScaleStep = 0.125f;
+  //! consecutive frames outside of the budget range before the scale is changed
+  static constexpr uint32_t SustainFrames = 15;
+  //! frames to wait after a scale change, so the averaged budget usage reflects the new scale
+  static constexpr uint32_t Cooldown = 30;
+  static constexpr uint32_t MaxCooldown = 32 * Cooldown;
+
+  void configure(const RenderSettings& renderSettings);
+
+  // returns true if the scale was changed
+  bool update(float budgetUsage);
+
+  [[nodiscard]] float getScale() const noexcept
+  {
+    return m_scale;
+  }
+
+  [[nodiscard]] glm::ivec2 getRenderSize(const glm::ivec2& displaySize) const;
+
+private:
+  bool m_enabled = false;
+  float m_minScale = 1.0f;
+  float m_maxScale = 1.0f;
+  float m_lowerBudget = 0.0f;
+  float m_upperBudget = 1.0f;
+  float m_scale = 1.0f;
+  uint32_t m_cooldown = 0;
+  uint32_t m_cooldownLength = Cooldown;
+  //! frames in a row over (positive) or under (negative) the budget range
+  int32_t m_sustained = 0;
+  //! direction of the last step
+  int32_t m_lastStep = 0;
+};
+} // namespace render
@@ -149,6 +149,8 @@ void CompositionPass::render(bool water, const RenderSettings& renderSettings)
 
   gl::RenderState::resetWantedState();
   gl::RenderState::getWantedState().setBlend(false);
+  // the scene may have been rendered at a lower internal resolution
+  gl::RenderState::getWantedState().setViewport(m_colorBuffer->size());
   scene::RenderContext context{scene::RenderMode::Full, std::nullopt};
   if(water)
     m_waterMesh->render(context);
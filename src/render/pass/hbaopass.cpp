@@ -2,6 +2,7 @@
 
 #include "config.h"
 #include "geometrypass.h"
+#include "render/scene/camera.h"
 #include "render/scene/material.h"
 #include "render/scene/materialmanager.h"
 #include "render/scene/mesh.h"
@@ -9,6 +10,7 @@
 #include "render/scene/rendermode.h"
 #include "render/scene/uniformparameter.h"
 
+#include <boost/assert.hpp>
 #include <gl/debuggroup.h>
 #include <gl/framebuffer.h>
 #include <gl/glassert.h>
@@ -18,10 +20,13 @@
 #include <gl/sampler.h>
 #include <gl/texture2d.h>
 #include <gl/texturehandle.h>
+#include <glm/common.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/matrix.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <gslu.h>
 #include <optional>
+#include <string>
 #include <utility>
 
 namespace render::scene
@@ -31,53 +36,243 @@ class Node;
 
 namespace render::pass
 {
+namespace
+{
+// weight of the accumulated history when it passes reprojection
+constexpr float HistoryWeight = 0.8f;
+
+glm::ivec2 getAOSize(const glm::ivec2& viewport, const uint8_t resolutionDivisor)
+{
+  return glm::max(viewport / glm::ivec2{resolutionDivisor}, glm::ivec2{1});
+}
+
+template<typename PixelT>
+std::shared_ptr<gl::TextureHandle<gl::Texture2D<PixelT>>>
+  createBuffer(const glm::ivec2& size, const std::string& name, const bool linear)
+{
+  return std::make_shared<gl::TextureHandle<gl::Texture2D<PixelT>>>(
+    gslu::make_nn_shared<gl::Texture2D<PixelT>>(size, name),
+    gslu::make_nn_unique<gl::Sampler>(name)
+      | set(gl::api::SamplerParameterI::TextureWrapS, gl::api::TextureWrapMode::ClampToEdge)
+      | set(gl::api::SamplerParameterI::TextureWrapT, gl::api::TextureWrapMode::ClampToEdge)
+      | set(linear ? gl::api::TextureMinFilter::Linear : gl::api::TextureMinFilter::Nearest)
+      | set(linear ? gl::api::TextureMagFilter::Linear : gl::api::TextureMagFilter::Nearest));
+}
+} // namespace
+
 HBAOPass::HBAOPass(scene::MaterialManager& materialManager,
                    const glm::ivec2& viewport,
-                   const GeometryPass& geometryPass)
-    : m_material{materialManager.getHBAO()}
+                   const GeometryPass& geometryPass,
+                   const uint8_t resolutionDivisor,
+                   const bool temporal)
+    : m_resolutionDivisor{resolutionDivisor}
+    , m_material{materialManager.getHBAO()}
     , m_renderMesh{scene::createScreenQuad(m_material, "hbao")}
-    , m_aoBuffer{std::make_shared<gl::Texture2D<gl::ScalarByte>>(viewport, "hbao-ao")}
+    , m_aoBuffer{std::make_shared<gl::Texture2D<gl::ScalarByte>>(getAOSize(viewport, resolutionDivisor), "hbao-ao")}
     , m_aoBufferHandle{std::make_shared<gl::TextureHandle<gl::Texture2D<gl::ScalarByte>>>(
         m_aoBuffer,
         gslu::make_nn_unique<gl::Sampler>("hbao-ao")
           | set(gl::api::SamplerParameterI::TextureWrapS, gl::api::TextureWrapMode::ClampToEdge)
           | set(gl::api::SamplerParameterI::TextureWrapT, gl::api::TextureWrapMode::ClampToEdge)
           | set(gl::api::TextureMinFilter::Linear) | set(gl::api::TextureMagFilter::Linear))}
-    , m_blur{"hbao", materialManager, 2, false}
     , m_fb{gl::FrameBufferBuilder()
              .textureNoBlend(gl::api::FramebufferAttachment::ColorAttachment0, m_aoBuffer)
              .build("hbao-fb")}
+    , m_positionBufferHandle{geometryPass.getPositionBuffer()}
+    , m_normalBufferHandle{geometryPass.getNormalBuffer()}
+    , m_blur{"hbao", materialManager, 2, false}
 {
+  Expects(resolutionDivisor > 0);
+
+  if(m_resolutionDivisor > 1)
+    initDownsample(materialManager, geometryPass);
+
   m_renderMesh->bind("u_normals",
-                     [buffer = geometryPass.getNormalBuffer()](
-                       const render::scene::Node& /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-                     { uniform.set(buffer); });
+                     [this](const render::scene::Node& /*node*/,
+                            const render::scene::Mesh& /*mesh*/,
+                            gl::Uniform& uniform) { uniform.set(gsl::not_null{m_normalBufferHandle}); });
   m_renderMesh->bind("u_position",
-                     [buffer = geometryPass.getPositionBuffer()](
-                       const render::scene::Node& /*node*/, const render::scene::Mesh& /*mesh*/, gl::Uniform& uniform)
-                     { uniform.set(buffer); });
+                     [this](const render::scene::Node& /*node*/,
+                            const render::scene::Mesh& /*mesh*/,
+                            gl::Uniform& uniform) { uniform.set(gsl::not_null{m_positionBufferHandle}); });
+  // the frame counter only advances with temporal accumulation, varying the sampling pattern so it converges
+  m_renderMesh->bind("u_noiseOffset",
+                     [this](const render::scene::Node& /*node*/,
+                            const render::scene::Mesh& /*mesh*/,
+                            gl::Uniform& uniform)
+                     {
+                       static constexpr uint32_t Period = 8;
+                       const auto phase = static_cast<float>(m_frame % Period);
+                       uniform.set(glm::vec2{phase * 0.37f, phase * 0.61f});
+                     });
+
+  if(temporal)
+  {
+    initTemporal(materialManager);
+    m_blur.setInput(gsl::not_null{m_temporalBufferHandle});
+  }
+  else
+  {
+    m_blur.setInput(gsl::not_null{m_aoBufferHandle});
+  }
+
+  if(m_resolutionDivisor > 1)
+    initUpsample(materialManager, viewport, geometryPass);
+}
+
+void HBAOPass::initDownsample(scene::MaterialManager& materialManager, const GeometryPass& geometryPass)
+{
+  const auto size = m_aoBuffer->size();
+  m_positionBufferHandle = createBuffer<gl::RGB32F>(size, "hbao-position", false);
+  m_normalBufferHandle = createBuffer<gl::RGB16F>(size, "hbao-normal", false);
+
+  m_downsampleMesh = scene::createScreenQuad(materialManager.getHBAODownsample(), "hbao-downsample");
+  m_downsampleMesh->bind("u_position",
+                         [buffer = geometryPass.getPositionBuffer()](const render::scene::Node& /*node*/,
+                                                                     const render::scene::Mesh& /*mesh*/,
+                                                                     gl::Uniform& uniform) { uniform.set(buffer); });
+  m_downsampleMesh->bind("u_normals",
+                         [buffer = geometryPass.getNormalBuffer()](const render::scene::Node& /*node*/,
+                                                                   const render::scene::Mesh& /*mesh*/,
+                                                                   gl::Uniform& uniform) { uniform.set(buffer); });
+  m_downsampleMesh->bind("u_divisor",
+                         [this](const render::scene::Node& /*node*/,
+                                const render::scene::Mesh& /*mesh*/,
+                                gl::Uniform& uniform) { uniform.set(int(m_resolutionDivisor)); });
 
-  m_blur.setInput(gsl::not_null{m_aoBufferHandle});
+  m_downsampleFb = gl::FrameBufferBuilder()
+                     .textureNoBlend(gl::api::FramebufferAttachment::ColorAttachment0,
+                                     m_positionBufferHandle->getTexture())
+                     .textureNoBlend(gl::api::FramebufferAttachment::ColorAttachment1,
+                                     m_normalBufferHandle->getTexture())
+                     .build("hbao-downsample-fb");
+}
+
+void HBAOPass::initTemporal(scene::MaterialManager& materialManager)
+{
+  const auto size = m_aoBuffer->size();
+  m_temporalBufferHandle = createBuffer<gl::ScalarByte>(size, "hbao-temporal", true);
+  m_temporalBuffer = m_temporalBufferHandle->getTexture();
+  m_historyBufferHandle = createBuffer<gl::ScalarByte>(size, "hbao-history", true);
+  m_historyPositionBufferHandle = createBuffer<gl::RGB32F>(size, "hbao-history-position", false);
+
+  m_temporalMesh = scene::createScreenQuad(materialManager.getHBAOTemporal(), "hbao-temporal");
+  m_temporalMesh->bind("u_ao",
+                       [this](const render::scene::Node& /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::Uniform& uniform) { uniform.set(m_aoBufferHandle); });
+  m_temporalMesh->bind("u_position",
+                       [this](const render::scene::Node& /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::Uniform& uniform) { uniform.set(gsl::not_null{m_positionBufferHandle}); });
+  m_temporalMesh->bind("u_history",
+                       [this](const render::scene::Node& /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::Uniform& uniform) { uniform.set(gsl::not_null{m_historyBufferHandle}); });
+  m_temporalMesh->bind("u_historyPosition",
+                       [this](const render::scene::Node& /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::Uniform& uniform) { uniform.set(gsl::not_null{m_historyPositionBufferHandle}); });
+  m_temporalMesh->bind("u_reprojection",
+                       [this](const render::scene::Node& /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::Uniform& uniform) { uniform.set(m_reprojection); });
+  m_temporalMesh->bind("u_historyWeight",
+                       [this](const render::scene::Node& /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::Uniform& uniform) { uniform.set(m_hasHistory ? HistoryWeight : 0.0f); });
+
+  m_temporalFb = gl::FrameBufferBuilder()
+                   .textureNoBlend(gl::api::FramebufferAttachment::ColorAttachment0, m_temporalBuffer)
+                   .build("hbao-temporal-fb");
+}
+
+void HBAOPass::initUpsample(scene::MaterialManager& materialManager,
+                            const glm::ivec2& viewport,
+                            const GeometryPass& geometryPass)
+{
+  m_upsampledBufferHandle = createBuffer<gl::ScalarByte>(viewport, "hbao-upsampled", true);
+
+  m_upsampleMesh = scene::createScreenQuad(materialManager.getHBAOUpsample(), "hbao-upsample");
+  m_upsampleMesh->bind("u_ao",
+                       [texture = m_blur.getBlurredTexture()](const render::scene::Node& /*node*/,
+                                                              const render::scene::Mesh& /*mesh*/,
+                                                              gl::Uniform& uniform) { uniform.set(texture); });
+  m_upsampleMesh->bind("u_lowPosition",
+                       [this](const render::scene::Node& /*node*/,
+                              const render::scene::Mesh& /*mesh*/,
+                              gl::Uniform& uniform) { uniform.set(gsl::not_null{m_positionBufferHandle}); });
+  m_upsampleMesh->bind("u_position",
+                       [buffer = geometryPass.getPositionBuffer()](const render::scene::Node& /*node*/,
+                                                                   const render::scene::Mesh& /*mesh*/,
+                                                                   gl::Uniform& uniform) { uniform.set(buffer); });
+
+  m_upsampleFb = gl::FrameBufferBuilder()
+                   .textureNoBlend(gl::api::FramebufferAttachment::ColorAttachment0,
+                                   m_upsampledBufferHandle->getTexture())
+                   .build("hbao-upsample-fb");
 }
 
 void HBAOPass::updateCamera(const gsl::not_null<std::shared_ptr<scene::Camera>>& camera)
 {
   m_material->getUniformBlock("Camera")->bindCameraBuffer(camera);
+  if(m_temporalMesh != nullptr)
+    m_temporalMesh->getMaterialGroup()
+      .get(scene::RenderMode::Full)
+      ->getUniformBlock("Camera")
+      ->bindCameraBuffer(camera);
+  m_camera = camera;
 }
 
-void HBAOPass::render(const glm::ivec2& size)
+void HBAOPass::render()
 {
   SOGLB_DEBUGGROUP("hbao-pass");
-  m_fb->bindWithAttachments();
 
   gl::RenderState::resetWantedState();
   gl::RenderState::getWantedState().setBlend(false);
-  gl::RenderState::getWantedState().setViewport(size);
+  gl::RenderState::getWantedState().setViewport(m_aoBuffer->size());
   scene::RenderContext context{scene::RenderMode::Full, std::nullopt};
 
+  if(m_downsampleMesh != nullptr)
+  {
+    SOGLB_DEBUGGROUP("hbao-downsample-pass");
+    m_downsampleFb->bindWithAttachments();
+    m_downsampleMesh->render(context);
+  }
+
+  m_fb->bindWithAttachments();
   m_renderMesh->render(context);
+
+  if(m_temporalMesh != nullptr)
+  {
+    SOGLB_DEBUGGROUP("hbao-temporal-pass");
+    BOOST_ASSERT(m_camera != nullptr);
+    const auto& viewMatrix = m_camera->getViewMatrix();
+    m_reprojection = m_prevViewMatrix * glm::inverse(viewMatrix);
+
+    m_temporalFb->bindWithAttachments();
+    m_temporalMesh->render(context);
+
+    m_historyBufferHandle->getTexture()->copyFrom(*m_temporalBuffer);
+    m_historyPositionBufferHandle->getTexture()->copyFrom(*m_positionBufferHandle->getTexture());
+    m_prevViewMatrix = viewMatrix;
+    m_hasHistory = true;
+    ++m_frame;
+  }
+
   m_blur.render();
 
+  if(m_upsampleMesh != nullptr)
+  {
+    SOGLB_DEBUGGROUP("hbao-upsample-pass");
+    gl::RenderState::resetWantedState();
+    gl::RenderState::getWantedState().setBlend(false);
+    gl::RenderState::getWantedState().setViewport(m_upsampledBufferHandle->getTexture()->size());
+    scene::RenderContext upsampleContext{scene::RenderMode::Full, std::nullopt};
+    m_upsampleFb->bindWithAttachments();
+    m_upsampleMesh->render(upsampleContext);
+  }
+
   if constexpr(FlushPasses)
     GL_ASSERT(gl::api::finish());
 }
@@ -3,8 +3,11 @@
 #include "render/scene/blur.h"
 
 #include <gl/pixel.h>
+#include <cstdint>
 #include <gl/soglb_fwd.h>
 #include <glm/fwd.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
 
@@ -28,19 +31,31 @@ class GeometryPass;
 class HBAOPass
 {
 public:
+  // the ambient occlusion is computed at 1/resolutionDivisor of the viewport size, and upsampled if needed
   explicit HBAOPass(scene::MaterialManager& materialManager,
                     const glm::ivec2& viewport,
-                    const GeometryPass& geometryPass);
+                    const GeometryPass& geometryPass,
+                    uint8_t resolutionDivisor,
+                    bool temporal);
   void updateCamera(const gsl::not_null<std::shared_ptr<scene::Camera>>& camera);
 
-  void render(const glm::ivec2& size);
+  void render();
 
-  [[nodiscard]] auto getBlurredTexture() const
+  [[nodiscard]] gsl::not_null<std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::ScalarByte>>>>
+    getBlurredTexture() const
   {
+    if(m_upsampledBufferHandle != nullptr)
+      return gsl::not_null{m_upsampledBufferHandle};
     return m_blur.getBlurredTexture();
   }
 
 private:
+  void initDownsample(scene::MaterialManager& materialManager, const GeometryPass& geometryPass);
+  void initTemporal(scene::MaterialManager& materialManager);
+  void
+    initUpsample(scene::MaterialManager& materialManager, const glm::ivec2& viewport, const GeometryPass& geometryPass);
+
+  const uint8_t m_resolutionDivisor;
   const gsl::not_null<std::shared_ptr<scene::Material>> m_material;
 
   gsl::not_null<std::shared_ptr<scene::Mesh>> m_renderMesh;
@@ -49,6 +64,29 @@ private:
   gsl::not_null<std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::ScalarByte>>>> m_aoBufferHandle;
   gsl::not_null<std::shared_ptr<gl::Framebuffer>> m_fb;
 
+  // view space positions and normals the ambient occlusion is computed from
+  std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::RGB32F>>> m_positionBufferHandle;
+  std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::RGB16F>>> m_normalBufferHandle;
+
+  std::shared_ptr<scene::Mesh> m_downsampleMesh;
+  std::shared_ptr<gl::Framebuffer> m_downsampleFb;
+
+  std::shared_ptr<scene::Mesh> m_temporalMesh;
+  std::shared_ptr<gl::Texture2D<gl::ScalarByte>> m_temporalBuffer;
+  std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::ScalarByte>>> m_temporalBufferHandle;
+  std::shared_ptr<gl::Framebuffer> m_temporalFb;
+  std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::ScalarByte>>> m_historyBufferHandle;
+  std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::RGB32F>>> m_historyPositionBufferHandle;
+  std::shared_ptr<scene::Camera> m_camera;
+  glm::mat4 m_prevViewMatrix{1.0f};
+  glm::mat4 m_reprojection{1.0f};
+  bool m_hasHistory = false;
+  uint32_t m_frame = 0;
+
   scene::SeparableBlur<gl::ScalarByte> m_blur;
+
+  std::shared_ptr<scene::Mesh> m_upsampleMesh;
+  std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::ScalarByte>>> m_upsampledBufferHandle;
+  std::shared_ptr<gl::Framebuffer> m_upsampleFb;
 };
 } // namespace render::pass
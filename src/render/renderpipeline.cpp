@@ -27,10 +27,10 @@ void RenderPipeline::compositionPass(const bool water)
     m_portalPass->renderBlur();
   BOOST_ASSERT(m_hbaoPass != nullptr);
   if(m_renderSettings.hbao)
-    m_hbaoPass->render(m_size);
+    m_hbaoPass->render();
   BOOST_ASSERT(m_fxaaPass != nullptr);
   if(m_renderSettings.fxaa)
-    m_fxaaPass->render(m_size);
+    m_fxaaPass->render(m_renderSize);
   BOOST_ASSERT(m_compositionPass != nullptr);
   m_compositionPass->render(water, m_renderSettings);
 }
@@ -47,6 +47,7 @@ void RenderPipeline::updateCamera(const gsl::not_null<std::shared_ptr<scene::Cam
 void RenderPipeline::apply(const RenderSettings& renderSettings, scene::MaterialManager& materialManager)
 {
   m_renderSettings = renderSettings;
+  m_dynamicResolution.configure(m_renderSettings);
   resize(materialManager, m_size, true);
 }
 
@@ -58,20 +59,44 @@ void RenderPipeline::resize(scene::MaterialManager& materialManager, const glm::
   }
 
   m_size = viewport;
+  createScaledPasses(materialManager);
+  m_uiPass = std::make_shared<pass::UIPass>(materialManager, viewport);
+}
 
-  m_geometryPass = std::make_shared<pass::GeometryPass>(viewport);
-  m_portalPass = std::make_shared<pass::PortalPass>(materialManager, m_geometryPass->getDepthBuffer(), viewport);
-  m_hbaoPass = std::make_shared<pass::HBAOPass>(materialManager, viewport, *m_geometryPass);
-  m_fxaaPass = std::make_shared<pass::FXAAPass>(materialManager, viewport, *m_geometryPass);
+void RenderPipeline::createScaledPasses(scene::MaterialManager& materialManager)
+{
+  m_renderSize = m_dynamicResolution.getRenderSize(m_size);
+
+  // everything up to the composition is rendered at the internal resolution, the composition upscales it
+  m_geometryPass = std::make_shared<pass::GeometryPass>(m_renderSize);
+  m_portalPass = std::make_shared<pass::PortalPass>(materialManager, m_geometryPass->getDepthBuffer(), m_renderSize);
+  m_hbaoPass = std::make_shared<pass::HBAOPass>(materialManager,
+                                                m_renderSize,
+                                                *m_geometryPass,
+                                                m_renderSettings.getHBAOResolutionDivisor(),
+                                                m_renderSettings.hbaoTemporal);
+  m_fxaaPass = std::make_shared<pass::FXAAPass>(materialManager, m_renderSize, *m_geometryPass);
   m_compositionPass = std::make_shared<pass::CompositionPass>(materialManager,
                                                               m_renderSettings,
-                                                              viewport,
+                                                              m_size,
                                                               *m_geometryPass,
                                                               *m_portalPass,
                                                               *m_hbaoPass,
                                                               m_renderSettings.fxaa ? m_fxaaPass->getColorBuffer()
                                                                                     : m_geometryPass->getColorBuffer());
-  m_uiPass = std::make_shared<pass::UIPass>(materialManager, viewport);
+}
+
+bool RenderPipeline::updateDynamicResolution(scene::MaterialManager& materialManager, const float budgetUsage)
+{
+  if(!m_dynamicResolution.update(budgetUsage))
+    return false;
+
+  if(m_dynamicResolution.getRenderSize(m_size) == m_renderSize)
+    return false;
+
+  // the ui is rendered at the display resolution and is not affected
+  createScaledPasses(materialManager);
+  return true;
 }
 
 void RenderPipeline::bindPortalFrameBuffer()
@@ -87,10 +112,10 @@ void RenderPipeline::bindUiFrameBuffer()
   m_uiPass->bind();
 }
 
-void RenderPipeline::bindGeometryFrameBuffer(const glm::ivec2& size, float farPlane)
+void RenderPipeline::bindGeometryFrameBuffer(float farPlane)
 {
   BOOST_ASSERT(m_geometryPass != nullptr);
-  m_geometryPass->bind(size);
+  m_geometryPass->bind(m_renderSize);
   m_geometryPass->getColorBuffer()->getTexture()->clear({0, 0, 0, 255});
   m_geometryPass->getPositionBuffer()->getTexture()->clear({0.0f, 0.0f, -farPlane});
   m_geometryPass->getDepthBuffer()->clear(gl::ScalarDepth{1.0f});
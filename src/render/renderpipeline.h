@@ -1,5 +1,6 @@
 #pragma once
 
+#include "dynamicresolution.h"
 #include "rendersettings.h"
 
 #include <glm/vec2.hpp>
@@ -31,6 +32,8 @@ class RenderPipeline
 private:
   RenderSettings m_renderSettings{};
   glm::ivec2 m_size{-1};
+  glm::ivec2 m_renderSize{-1};
+  DynamicResolution m_dynamicResolution{};
   std::shared_ptr<pass::PortalPass> m_portalPass;
   std::shared_ptr<pass::GeometryPass> m_geometryPass;
   std::shared_ptr<pass::HBAOPass> m_hbaoPass;
@@ -38,10 +41,12 @@ private:
   std::shared_ptr<pass::CompositionPass> m_compositionPass;
   std::shared_ptr<pass::UIPass> m_uiPass;
 
+  void createScaledPasses(scene::MaterialManager& materialManager);
+
 public:
   explicit RenderPipeline(scene::MaterialManager& materialManager, const glm::ivec2& viewport);
 
-  void bindGeometryFrameBuffer(const glm::ivec2& size, float farPlane);
+  void bindGeometryFrameBuffer(float farPlane);
   void bindPortalFrameBuffer();
   void bindUiFrameBuffer();
   void renderUiFrameBuffer(float alpha);
@@ -51,6 +56,19 @@ public:
 
   void resize(scene::MaterialManager& materialManager, const glm::ivec2& viewport, bool force = false);
 
+  // feeds the frame budget usage to the dynamic resolution controller; returns true if the render size changed
+  bool updateDynamicResolution(scene::MaterialManager& materialManager, float budgetUsage);
+
+  [[nodiscard]] const auto& getRenderSize() const
+  {
+    return m_renderSize;
+  }
+
+  [[nodiscard]] float getRenderScale() const
+  {
+    return m_dynamicResolution.getScale();
+  }
+
   void apply(const RenderSettings& renderSettings, scene::MaterialManager& materialManager);
 };
 } // namespace render
@@ -19,10 +19,20 @@ void RenderSettings::serialize(const serialization::Serializer<engine::EngineCon
       S_NVO("bilinearFiltering", bilinearFiltering),
       S_NVO("waterDenoise", waterDenoise),
       S_NVO("hbao", hbao),
+      S_NVO("hbaoResolutionDivisor", hbaoResolutionDivisor),
+      S_NVO("hbaoTemporal", hbaoTemporal),
       S_NVO("velvia", velvia),
       S_NVO("fxaa", fxaa),
       S_NVO("moreLights", moreLights),
       S_NVO("highQualityShadows", highQualityShadows),
+      S_NVO("throttleFarShadows", throttleFarShadows),
+      S_NVO("dynamicResolution", dynamicResolution),
+      S_NVO("dynamicResolutionMinScale", dynamicResolutionMinScale),
+      S_NVO("dynamicResolutionMaxScale", dynamicResolutionMaxScale),
+      S_NVO("dynamicResolutionLowerBudget", dynamicResolutionLowerBudget),
+      S_NVO("dynamicResolutionUpperBudget", dynamicResolutionUpperBudget),
+      S_NVO("renderInterpolation", renderInterpolation),
+      S_NVO("textureBudget", textureBudget),
       S_NVO("anisotropyLevel", anisotropyLevel),
       S_NVO("glidosPack", glidosPack));
 }
@@ -28,10 +28,23 @@ struct RenderSettings
   uint32_t anisotropyLevel = std::numeric_limits<uint32_t>::max();
   bool waterDenoise = false;
   bool hbao = true;
+  uint32_t hbaoResolutionDivisor = 1;
+  bool hbaoTemporal = false;
   bool velvia = true;
   bool fxaa = true;
   bool moreLights = true;
   bool highQualityShadows = true;
+  bool throttleFarShadows = false;
+  bool dynamicResolution = false;
+  float dynamicResolutionMinScale = 0.5f;
+  float dynamicResolutionMaxScale = 1.0f;
+  // share of the frame budget below/above which the render scale is raised/lowered
+  float dynamicResolutionLowerBudget = 0.7f;
+  float dynamicResolutionUpperBudget = 0.95f;
+  // render at display rate with transforms interpolated between simulation ticks
+  bool renderInterpolation = false;
+  // video memory for full resolution texture pages in MB, applied on level load
+  uint32_t textureBudget = 1024;
   std::optional<std::string> glidosPack = std::nullopt;
 
   [[nodiscard]] size_t getLightCollectionDepth() const
@@ -39,11 +52,28 @@ struct RenderSettings
     return moreLights ? 2 : 1;
   }
 
+  [[nodiscard]] uint8_t getHBAOResolutionDivisor() const
+  {
+    if(hbaoResolutionDivisor >= 4)
+      return 4;
+    return hbaoResolutionDivisor >= 2 ? 2 : 1;
+  }
+
+  [[nodiscard]] size_t getTextureBudgetBytes() const
+  {
+    return size_t{textureBudget} * 1024 * 1024;
+  }
+
   [[nodiscard]] int32_t getCSMResolution() const
   {
     return highQualityShadows ? 2048 : 1024;
   }
 
+  [[nodiscard]] uint32_t getCSMFarSplitInterval() const
+  {
+    return throttleFarShadows ? 4 : 1;
+  }
+
   void serialize(const serialization::Serializer<engine::EngineConfig>& ser);
 };
 } // namespace render
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace render::scene
+{
+class MaterialParameter;
+
+// remembers which parameter value was last applied to a uniform or a buffer binding point
+struct BindingStamp
+{
+  const MaterialParameter* writer = nullptr;
+  uint64_t version = 0;
+  //! bind count of the binding point after the last bind through a material, to detect buffers bound directly
+  uint64_t bindCount = 0;
+};
+
+enum class BindResult
+{
+  NoValue,
+  Applied,
+  Skipped
+};
+} // namespace render::scene
@@ -3,39 +3,40 @@
 #include "engine/skeletalmodelnode.h"
 #include "mesh.h"
 #include "node.h"
-#include "shaderprogram.h"
 
-#include <boost/log/trivial.hpp>
 #include <gl/program.h>
-#include <iosfwd>
 
 namespace render::scene
 {
-bool BufferParameter::bind(const Node& node,
-                           const Mesh& mesh,
-                           const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram)
+BindResult BufferParameter::bind(const Node& node,
+                                 const Mesh& mesh,
+                                 gl::ShaderStorageBlock& shaderStorageBlock,
+                                 BindingStamp& stamp)
 {
   auto binder = mesh.findShaderStorageBlockBinder(getName());
   if(!m_bufferBinder && binder == nullptr)
   {
     binder = node.findShaderStorageBlockBinder(getName());
-    if(!m_bufferBinder && binder == nullptr)
+    if(binder == nullptr)
     {
       // don't have an explicit binder present on material, node or mesh level, assuming it's set on shader level
-      return true;
+      return BindResult::NoValue;
     }
   }
 
-  const auto block = findShaderStorageBlock(shaderProgram);
-  if(block == nullptr)
-    return false;
-
   if(binder != nullptr)
-    (*binder)(node, mesh, *block);
-  else
-    m_bufferBinder(node, mesh, *block);
+  {
+    (*binder)(node, mesh, shaderStorageBlock);
+    markApplied(stamp, true);
+    return BindResult::Applied;
+  }
 
-  return true;
+  if(isApplied(stamp))
+    return BindResult::Skipped;
+
+  m_bufferBinder(node, mesh, shaderStorageBlock);
+  markApplied(stamp, false);
+  return BindResult::Applied;
 }
 
 void BufferParameter::bindBoneTransformBuffer()
@@ -45,17 +46,16 @@ void BufferParameter::bindBoneTransformBuffer()
     if(const auto* mo = dynamic_cast<const engine::SkeletalModelNode*>(&node))
       ssb.bind(mo->getMeshMatricesBuffer());
   };
+  valueChanged(false);
 }
 
-gl::ShaderStorageBlock*
-  BufferParameter::findShaderStorageBlock(const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram) const
+void BufferParameter::bindBoneMeshBuffer()
 {
-  if(const auto block = shaderProgram->findShaderStorageBlock(getName()))
-    return block;
-
-  BOOST_LOG_TRIVIAL(warning) << "Shader storage block '" << getName() << "' not found in program '"
-                             << shaderProgram->getId() << "'";
-
-  return nullptr;
+  m_bufferBinder = [](const Node& node, const Mesh& /*mesh*/, gl::ShaderStorageBlock& ssb)
+  {
+    if(const auto* mo = dynamic_cast<const engine::SkeletalModelNode*>(&node))
+      ssb.bind(mo->getBoneMeshBuffer());
+  };
+  valueChanged(false);
 }
 } // namespace render::scene
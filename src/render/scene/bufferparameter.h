@@ -33,6 +33,7 @@ public:
   {
     m_bufferBinder = [value](const Node& /*node*/, const Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
     { shaderStorageBlock.bind(*value); };
+    valueChanged(true);
   }
 
   template<class ClassType, typename T>
@@ -41,6 +42,7 @@ public:
     m_bufferBinder = [classInstance, valueMethod](
                        const Node& /*node*/, const Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
     { shaderStorageBlock.bind((classInstance->*valueMethod)()); };
+    valueChanged(false);
   }
 
   using BufferBinder = void(const Node& node, const Mesh& mesh, gl::ShaderStorageBlock& shaderStorageBlock);
@@ -48,17 +50,15 @@ public:
   void bind(std::function<BufferBinder>&& setter)
   {
     m_bufferBinder = std::move(setter);
+    valueChanged(false);
   }
 
-  bool bind(const Node& node,
-            const Mesh& mesh,
-            const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram) override;
+  BindResult
+    bind(const Node& node, const Mesh& mesh, gl::ShaderStorageBlock& shaderStorageBlock, BindingStamp& stamp);
   void bindBoneTransformBuffer();
+  void bindBoneMeshBuffer();
 
 private:
-  [[nodiscard]] gl::ShaderStorageBlock*
-    findShaderStorageBlock(const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram) const;
-
   std::function<BufferBinder> m_bufferBinder;
 };
 } // namespace render::scene
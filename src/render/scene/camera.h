@@ -39,7 +39,7 @@ public:
   {
     m_dirty.set_all();
     m_matrices.aspectRatio = screenSize.x / screenSize.y;
-    m_matrices.screenSize = glm::vec4{screenSize, 0, 0};
+    m_matrices.screenSize = glm::vec4{screenSize, screenSize};
     m_matrices.nearPlane = nearPlane;
     m_matrices.farPlane = farPlane;
 
@@ -71,12 +71,24 @@ public:
       return;
 
     m_matrices.aspectRatio = screenSize.x / screenSize.y;
-    m_matrices.screenSize = glm::vec4{screenSize, 0, 0};
+    m_matrices.screenSize.x = screenSize.x;
+    m_matrices.screenSize.y = screenSize.y;
     m_dirty.set(CameraMatrices::DirtyFlag::Projection);
     m_dirty.set(CameraMatrices::DirtyFlag::ViewProjection);
     m_dirty.set(CameraMatrices::DirtyFlag::BufferData);
   }
 
+  // size of the scene render targets, which may differ from the screen size
+  void setRenderSize(const glm::vec2& renderSize)
+  {
+    if(glm::vec2{m_matrices.screenSize.z, m_matrices.screenSize.w} == renderSize)
+      return;
+
+    m_matrices.screenSize.z = renderSize.x;
+    m_matrices.screenSize.w = renderSize.y;
+    m_dirty.set(CameraMatrices::DirtyFlag::BufferData);
+  }
+
   [[nodiscard]] float getNearPlane() const
   {
     return m_matrices.nearPlane;
@@ -173,6 +173,23 @@ std::array<glm::mat4, CSMBuffer::NSplits> CSM::getMatrices(const glm::mat4& mode
 
 void CSM::updateCamera(const Camera& camera)
 {
+  const auto position = camera.getPosition();
+  const auto up = camera.getUpVector();
+  const auto right = camera.getRightVector();
+  const auto forward = camera.getFrontVector();
+
+  if(isCameraCut(m_lastCameraPosition, m_lastCameraFront, position, forward))
+    m_forceUpdate = true;
+  m_lastCameraPosition = position;
+  m_lastCameraFront = forward;
+
+  ++m_frame;
+  for(size_t i = 0; i < m_splits.size(); ++i)
+  {
+    m_splits[i].due = m_forceUpdate || i < NearSplits || (m_frame + i) % m_farSplitInterval == 0;
+  }
+  m_forceUpdate = false;
+
   //Start off by calculating the split distances
   const float nearClip = camera.getNearPlane();
   const float farClip = camera.getFarPlane();
@@ -198,13 +215,11 @@ void CSM::updateCamera(const Camera& camera)
   }
 #endif
 
-  const auto position = camera.getPosition();
-  const auto up = camera.getUpVector();
-  const auto right = camera.getRightVector();
-  const auto forward = camera.getFrontVector();
-
   for(size_t cascadeIterator = 0; cascadeIterator < m_splits.size(); ++cascadeIterator)
   {
+    if(!m_splits[cascadeIterator].due)
+      continue; // keep the matrix in sync with the previously rendered shadow map
+
     const auto nc = position + forward * cascadeSplits[cascadeIterator];
     const auto fc = position + forward * cascadeSplits[cascadeIterator + 1];
 
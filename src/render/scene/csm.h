@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/magic.h"
 #include "core/units.h"
 #include "core/vec.h"
 
@@ -12,10 +13,13 @@
 #include <gl/renderstate.h>
 #include <gl/soglb_fwd.h>
 #include <glm/fwd.hpp>
+#include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
+#include <utility>
 
 // IWYU pragma: no_forward_declare gl::Framebuffer
 // IWYU pragma: no_forward_declare gl::Texture2D
@@ -41,6 +45,19 @@ struct CSMBuffer
 };
 static_assert(sizeof(CSMBuffer) % 16 == 0);
 
+// a camera moving or turning this far within one frame, e.g. when switching to a fixed or cinematic camera, makes the
+// throttled splits show the shadows of the previous view
+[[nodiscard]] inline bool isCameraCut(const glm::vec3& prevPosition,
+                                      const glm::vec3& prevFront,
+                                      const glm::vec3& position,
+                                      const glm::vec3& front)
+{
+  static constexpr float MaxDistance = 2 * static_cast<float>(core::SectorSize.get());
+  // about 60 degrees
+  static constexpr float MinFrontDot = 0.5f;
+  return glm::distance(prevPosition, position) > MaxDistance || glm::dot(prevFront, front) < MinFrontDot;
+}
+
 class CSM final
 {
 public:
@@ -54,6 +71,7 @@ public:
     std::shared_ptr<Material> squareMaterial{};
     std::shared_ptr<Mesh> squareMesh{};
     std::shared_ptr<SeparableBlur<gl::RG16F>> squareBlur;
+    bool due = true;
 
     void init(int32_t resolution, size_t idx, MaterialManager& materialManager);
     void renderSquare();
@@ -86,8 +104,23 @@ public:
     m_activeSplit = idx;
   }
 
+  // splits closer than this are updated every frame, farther ones follow the far split interval
+  static constexpr size_t NearSplits = 2;
+
   void updateCamera(const Camera& camera);
 
+  void setFarSplitInterval(uint32_t interval)
+  {
+    Expects(interval > 0);
+    if(std::exchange(m_farSplitInterval, interval) != interval)
+      m_forceUpdate = true;
+  }
+
+  [[nodiscard]] bool isSplitDue(size_t idx) const
+  {
+    return m_splits.at(idx).due;
+  }
+
   auto& getBuffer(const glm::mat4& modelMatrix)
   {
     m_bufferData.lightMVP = getMatrices(modelMatrix);
@@ -123,6 +156,12 @@ private:
   const glm::vec3 m_lightDirOrtho{core::TRVec{1_len, 0_len, 0_len}.toRenderSystem()};
   std::array<Split, CSMBuffer::NSplits> m_splits;
   size_t m_activeSplit = 0;
+  uint32_t m_farSplitInterval = 1;
+  uint32_t m_frame = 0;
+  //! forces all splits to be updated in the next frame
+  bool m_forceUpdate = true;
+  glm::vec3 m_lastCameraPosition{0.0f};
+  glm::vec3 m_lastCameraFront{0.0f};
   CSMBuffer m_bufferData;
   gl::UniformBuffer<CSMBuffer> m_buffer{"csm-data-ubo"};
 };
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <glm/common.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/vector_relational.hpp>
+#include <limits>
+
+namespace render::scene
+{
+struct CullingStats
+{
+  size_t tested = 0;
+  size_t culled = 0;
+};
+
+[[nodiscard]] inline CullingStats& getCullingStats()
+{
+  static CullingStats stats;
+  return stats;
+}
+
+// axis-aligned box; the default box is empty and contains nothing
+struct Bounds
+{
+  glm::vec3 min{std::numeric_limits<float>::max()};
+  glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+  [[nodiscard]] bool isEmpty() const
+  {
+    return glm::any(glm::greaterThan(min, max));
+  }
+
+  void merge(const Bounds& other)
+  {
+    min = glm::min(min, other.min);
+    max = glm::max(max, other.max);
+  }
+
+  [[nodiscard]] Bounds broadened(const glm::vec3& margin) const
+  {
+    return {min - margin, max + margin};
+  }
+
+  //! bounds of the transformed box, using the transformed center and the absolute matrix for the extents
+  [[nodiscard]] Bounds transformed(const glm::mat4& m) const
+  {
+    if(isEmpty())
+      return {};
+
+    const auto center = glm::vec3{m * glm::vec4{(min + max) * 0.5f, 1.0f}};
+    const auto extents = (max - min) * 0.5f;
+    const auto newExtents = glm::abs(glm::vec3{m[0]}) * extents.x + glm::abs(glm::vec3{m[1]}) * extents.y
+                            + glm::abs(glm::vec3{m[2]}) * extents.z;
+    return {center - newExtents, center + newExtents};
+  }
+};
+
+// The left, right, bottom and top clip planes of a view projection. Near and far planes are ignored, as the depth-only
+// passes rely on depth clamping for occluders outside of the depth range.
+class Frustum
+{
+public:
+  explicit Frustum(const glm::mat4& viewProjection)
+  {
+    const glm::vec4 rowX{viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]};
+    const glm::vec4 rowY{viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]};
+    const glm::vec4 rowW{viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]};
+    const glm::vec4 left = rowW + rowX;
+    const glm::vec4 right = rowW - rowX;
+    const glm::vec4 bottom = rowW + rowY;
+    const glm::vec4 top = rowW - rowY;
+    m_planesX = {left.x, right.x, bottom.x, top.x};
+    m_planesY = {left.y, right.y, bottom.y, top.y};
+    m_planesZ = {left.z, right.z, bottom.z, top.z};
+    m_planesW = {left.w, right.w, bottom.w, top.w};
+  }
+
+  // Checks if the box is completely outside of one of the planes. The planes are stored per component, so all four
+  // planes are tested at once against the corner furthest along each plane's normal.
+  [[nodiscard]] bool isOutside(const Bounds& bounds) const
+  {
+    if(bounds.isEmpty())
+      return true;
+
+    static const glm::vec4 zero{0.0f};
+    const auto cornersX = glm::mix(glm::vec4{bounds.min.x}, glm::vec4{bounds.max.x}, glm::greaterThan(m_planesX, zero));
+    const auto cornersY = glm::mix(glm::vec4{bounds.min.y}, glm::vec4{bounds.max.y}, glm::greaterThan(m_planesY, zero));
+    const auto cornersZ = glm::mix(glm::vec4{bounds.min.z}, glm::vec4{bounds.max.z}, glm::greaterThan(m_planesZ, zero));
+    const auto distances = m_planesX * cornersX + m_planesY * cornersY + m_planesZ * cornersZ + m_planesW;
+    return glm::any(glm::lessThan(distances, zero));
+  }
+
+private:
+  glm::vec4 m_planesX{0.0f};
+  glm::vec4 m_planesY{0.0f};
+  glm::vec4 m_planesZ{0.0f};
+  glm::vec4 m_planesW{0.0f};
+};
+} // namespace render::scene
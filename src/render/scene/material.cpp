@@ -6,12 +6,62 @@
 
 #include <algorithm>
 #include <boost/log/trivial.hpp>
+#include <cstdint>
 #include <gl/program.h>
 #include <iosfwd>
+#include <unordered_map>
 #include <utility>
 
 namespace render::scene
 {
+namespace
+{
+// buffer binding points are global state, so their stamps are shared between all programs
+BindingStamp& getUniformBlockStamp(const gl::UniformBlock& block)
+{
+  static std::unordered_map<int32_t, BindingStamp> stamps;
+  return stamps[block.getBinding()];
+}
+
+BindingStamp& getShaderStorageBlockStamp(const gl::ShaderStorageBlock& block)
+{
+  static std::unordered_map<int32_t, BindingStamp> stamps;
+  return stamps[block.getBinding()];
+}
+
+// a buffer bound to the binding point outside of the material path invalidates the stamp
+template<typename TParameter, typename TBlock>
+BindResult bindBlock(TParameter& parameter, const Node& node, const Mesh& mesh, TBlock& block, BindingStamp& stamp)
+{
+  if(stamp.bindCount != block.getBindCount())
+    stamp.writer = nullptr;
+  const auto result = parameter.bind(node, mesh, block, stamp);
+  stamp.bindCount = block.getBindCount();
+  return result;
+}
+
+void count(Material::BindStats& stats, BindResult result)
+{
+  switch(result)
+  {
+  case BindResult::NoValue:
+    break;
+  case BindResult::Applied:
+    ++stats.applied;
+    break;
+  case BindResult::Skipped:
+    ++stats.skipped;
+    break;
+  }
+}
+} // namespace
+
+Material::BindStats& Material::getBindStats()
+{
+  static BindStats stats;
+  return stats;
+}
+
 Material::Material(gsl::not_null<std::shared_ptr<ShaderProgram>> shaderProgram)
     : m_shaderProgram{std::move(shaderProgram)}
 {
@@ -24,45 +74,72 @@ Material::Material(gsl::not_null<std::shared_ptr<ShaderProgram>> shaderProgram)
   for(const auto& u : m_shaderProgram->getHandle().getShaderStorageBlocks())
     // cppcheck-suppress useStlAlgorithm
     m_buffers.emplace_back(std::make_shared<BufferParameter>(u.getName()));
+
+  for(const auto& param : m_uniforms)
+    compile(param);
+  for(const auto& param : m_uniformBlocks)
+    compile(param);
+  for(const auto& param : m_buffers)
+    compile(param);
 }
 
 Material::~Material() = default;
 
-void Material::bind(const Node& node, const Mesh& mesh) const
+void Material::compile(const gsl::not_null<std::shared_ptr<UniformParameter>>& parameter) const
 {
-  for(const auto& param : m_uniforms)
+  auto uniform = m_shaderProgram->findUniform(parameter->getName());
+  if(uniform == nullptr)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, m_shaderProgram);
-#ifndef NDEBUG
-    if(!success)
-    {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform " << param->getName();
-    }
-#endif
+    BOOST_LOG_TRIVIAL(debug) << "Uniform '" << parameter->getName() << "' not directly accessible in program '"
+                             << m_shaderProgram->getId() << "'";
+    return;
   }
 
-  for(const auto& param : m_uniformBlocks)
+  m_compiledUniforms.emplace_back(
+    CompiledParameter<UniformParameter, gl::Uniform>{parameter, uniform, &m_shaderProgram->getStamp(*uniform)});
+}
+
+void Material::compile(const gsl::not_null<std::shared_ptr<UniformBlockParameter>>& parameter) const
+{
+  auto block = m_shaderProgram->findUniformBlock(parameter->getName());
+  if(block == nullptr)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, m_shaderProgram);
-#ifndef NDEBUG
-    if(!success)
-    {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material uniform block " << param->getName();
-    }
-#endif
+    BOOST_LOG_TRIVIAL(warning) << "Uniform block '" << parameter->getName() << "' not found in program '"
+                               << m_shaderProgram->getId() << "'";
+    return;
   }
 
-  for(const auto& param : m_buffers)
+  m_compiledUniformBlocks.emplace_back(
+    CompiledParameter<UniformBlockParameter, gl::UniformBlock>{parameter, block, &getUniformBlockStamp(*block)});
+}
+
+void Material::compile(const gsl::not_null<std::shared_ptr<BufferParameter>>& parameter) const
+{
+  auto block = m_shaderProgram->findShaderStorageBlock(parameter->getName());
+  if(block == nullptr)
   {
-    [[maybe_unused]] const auto success = param->bind(node, mesh, m_shaderProgram);
-#ifndef NDEBUG
-    if(!success)
-    {
-      BOOST_LOG_TRIVIAL(warning) << "Failed to bind material buffer " << param->getName();
-    }
-#endif
+    BOOST_LOG_TRIVIAL(warning) << "Shader storage block '" << parameter->getName() << "' not found in program '"
+                               << m_shaderProgram->getId() << "'";
+    return;
   }
 
+  m_compiledBuffers.emplace_back(CompiledParameter<BufferParameter, gl::ShaderStorageBlock>{
+    parameter, block, &getShaderStorageBlockStamp(*block)});
+}
+
+void Material::bind(const Node& node, const Mesh& mesh) const
+{
+  auto& stats = getBindStats();
+
+  for(const auto& compiled : m_compiledUniforms)
+    count(stats, compiled.parameter->bind(node, mesh, *compiled.target, *compiled.stamp));
+
+  for(const auto& compiled : m_compiledUniformBlocks)
+    count(stats, bindBlock(*compiled.parameter, node, mesh, *compiled.target, *compiled.stamp));
+
+  for(const auto& compiled : m_compiledBuffers)
+    count(stats, bindBlock(*compiled.parameter, node, mesh, *compiled.target, *compiled.stamp));
+
   m_shaderProgram->bind();
 }
 
@@ -76,8 +153,9 @@ std::shared_ptr<UniformParameter> Material::tryGetUniform(const std::string& nam
   if(m_shaderProgram->findUniform(name) == nullptr)
     return nullptr;
 
-  auto param = std::make_shared<UniformParameter>(name);
+  auto param = gsl::not_null{std::make_shared<UniformParameter>(name)};
   m_uniforms.emplace_back(param);
+  compile(param);
   return param;
 }
 
@@ -90,8 +168,9 @@ std::shared_ptr<UniformBlockParameter> Material::tryGetUniformBlock(const std::s
 
   if(m_shaderProgram->findUniformBlock(name) == nullptr)
     return nullptr;
-  auto param = std::make_shared<UniformBlockParameter>(name);
+  auto param = gsl::not_null{std::make_shared<UniformBlockParameter>(name)};
   m_uniformBlocks.emplace_back(param);
+  compile(param);
   return param;
 }
 
@@ -104,8 +183,9 @@ std::shared_ptr<BufferParameter> Material::tryGetBuffer(const std::string& name)
 
   if(m_shaderProgram->findShaderStorageBlock(name) == nullptr)
     return nullptr;
-  auto param = std::make_shared<BufferParameter>(name);
+  auto param = gsl::not_null{std::make_shared<BufferParameter>(name)};
   m_buffers.emplace_back(param);
+  compile(param);
   return param;
 }
 } // namespace render::scene
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "bindingstamp.h"
+
+#include <cstddef>
+#include <gl/program.h>
 #include <gl/renderstate.h>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
@@ -18,6 +22,14 @@ class UniformParameter;
 class Material final
 {
 public:
+  struct BindStats
+  {
+    size_t applied = 0;
+    size_t skipped = 0;
+  };
+
+  static BindStats& getBindStats();
+
   explicit Material(gsl::not_null<std::shared_ptr<ShaderProgram>> shaderProgram);
 
   ~Material();
@@ -58,12 +70,29 @@ public:
   }
 
 private:
+  // parameters resolved against the shader program when they are created, so that binding doesn't need any lookups
+  template<typename TParameter, typename TTarget>
+  struct CompiledParameter
+  {
+    gsl::not_null<std::shared_ptr<TParameter>> parameter;
+    gsl::not_null<TTarget*> target;
+    gsl::not_null<BindingStamp*> stamp;
+  };
+
   gsl::not_null<std::shared_ptr<ShaderProgram>> m_shaderProgram;
 
   mutable std::vector<gsl::not_null<std::shared_ptr<UniformParameter>>> m_uniforms;
   mutable std::vector<gsl::not_null<std::shared_ptr<UniformBlockParameter>>> m_uniformBlocks;
   mutable std::vector<gsl::not_null<std::shared_ptr<BufferParameter>>> m_buffers;
 
+  mutable std::vector<CompiledParameter<UniformParameter, gl::Uniform>> m_compiledUniforms;
+  mutable std::vector<CompiledParameter<UniformBlockParameter, gl::UniformBlock>> m_compiledUniformBlocks;
+  mutable std::vector<CompiledParameter<BufferParameter, gl::ShaderStorageBlock>> m_compiledBuffers;
+
+  void compile(const gsl::not_null<std::shared_ptr<UniformParameter>>& parameter) const;
+  void compile(const gsl::not_null<std::shared_ptr<UniformBlockParameter>>& parameter) const;
+  void compile(const gsl::not_null<std::shared_ptr<BufferParameter>>& parameter) const;
+
   gl::RenderState m_renderState{};
 };
 } // namespace render::scene
@@ -4,6 +4,7 @@
 #include "csm.h"
 #include "material.h"
 #include "node.h"
+#include "render/textureanimator.h"
 #include "renderer.h"
 #include "shadercache.h"
 #include "uniformparameter.h"
@@ -54,14 +55,31 @@ gsl::not_null<std::shared_ptr<Material>> MaterialManager::getSprite(bool billboa
 
   m->getUniformBlock("Transform")->bindTransformBuffer();
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
-  m->getUniform("u_diffuseTextures")
-    ->bind([this](const Node& /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
-           { uniform.set(gsl::not_null{m_geometryTextures}); });
+  bindGeometryTextures(*m);
+  bindTextureAnimation(*m);
+  bindLightClusters(*m);
 
   m_sprite.emplace(billboard, m);
   return m;
 }
 
+gsl::not_null<std::shared_ptr<Material>> MaterialManager::getSpriteBatch()
+{
+  if(m_spriteBatch != nullptr)
+    return gsl::not_null{m_spriteBatch};
+
+  m_spriteBatch = std::make_shared<Material>(m_shaderCache->getGeometry(false, false, true, 3));
+  m_spriteBatch->getRenderState().setCullFace(false);
+
+  m_spriteBatch->getUniformBlock("Transform")->bindTransformBuffer();
+  m_spriteBatch->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
+  bindGeometryTextures(*m_spriteBatch);
+  bindTextureAnimation(*m_spriteBatch);
+  bindLightClusters(*m_spriteBatch);
+
+  return gsl::not_null{m_spriteBatch};
+}
+
 gsl::not_null<std::shared_ptr<Material>> MaterialManager::getCSMDepthOnly(bool skeletal)
 {
   if(auto it = m_csmDepthOnly.find(skeletal); it != m_csmDepthOnly.end())
@@ -78,6 +96,8 @@ gsl::not_null<std::shared_ptr<Material>> MaterialManager::getCSMDepthOnly(bool s
   m->getRenderState().setDepthWrite(true);
   if(auto buffer = m->tryGetBuffer("BoneTransform"))
     buffer->bindBoneTransformBuffer();
+  if(auto buffer = m->tryGetBuffer("BoneMesh"))
+    buffer->bindBoneMeshBuffer();
 
   m_csmDepthOnly.emplace(skeletal, m);
   return m;
@@ -95,9 +115,10 @@ gsl::not_null<std::shared_ptr<Material>> MaterialManager::getDepthOnly(bool skel
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
   if(auto buffer = m->tryGetBuffer("BoneTransform"))
     buffer->bindBoneTransformBuffer();
-  m->getUniform("u_diffuseTextures")
-    ->bind([this](const Node& /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
-           { uniform.set(gsl::not_null{m_geometryTextures}); });
+  if(auto buffer = m->tryGetBuffer("BoneMesh"))
+    buffer->bindBoneMeshBuffer();
+  bindGeometryTextures(*m);
+  bindTextureAnimation(*m);
 
   m_depthOnly.emplace(skeletal, m);
   return m;
@@ -111,13 +132,15 @@ gsl::not_null<std::shared_ptr<Material>> MaterialManager::getGeometry(bool water
     return it->second;
 
   auto m = gslu::make_nn_shared<Material>(m_shaderCache->getGeometry(water, skeletal, roomShadowing, 0));
-  m->getUniform("u_diffuseTextures")
-    ->bind([this](const Node& /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
-           { uniform.set(gsl::not_null{m_geometryTextures}); });
+  bindGeometryTextures(*m);
 
   m->getUniformBlock("Transform")->bindTransformBuffer();
   if(auto buffer = m->tryGetBuffer("BoneTransform"))
     buffer->bindBoneTransformBuffer();
+  if(auto buffer = m->tryGetBuffer("BoneMesh"))
+    buffer->bindBoneMeshBuffer();
+  bindTextureAnimation(*m);
+  bindLightClusters(*m);
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
   m->getUniformBlock("CSM")->bind(
     [this](const Node& node, const Mesh& /*mesh*/, gl::UniformBlock& ub)
@@ -263,8 +286,7 @@ gsl::not_null<std::shared_ptr<Material>> MaterialManager::getUi()
     return gsl::not_null{m_ui};
 
   auto m = std::make_shared<Material>(m_shaderCache->getUi());
-  m->getUniform("u_input")->bind([this](const Node& /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
-                                 { uniform.set(gsl::not_null{m_geometryTextures}); });
+  bindGeometryTextures(*m);
   m->getUniformBlock("Camera")->bindCameraBuffer(m_renderer->getCamera());
   configureForScreenSpaceEffect(*m, true);
   m_ui = m;
@@ -322,6 +344,39 @@ gsl::not_null<std::shared_ptr<Material>> MaterialManager::getHBAO()
   return m;
 }
 
+gsl::not_null<std::shared_ptr<Material>> MaterialManager::getHBAODownsample()
+{
+  if(m_hbaoDownsample != nullptr)
+    return gsl::not_null{m_hbaoDownsample};
+
+  auto m = gslu::make_nn_shared<Material>(m_shaderCache->getHBAODownsample());
+  configureForScreenSpaceEffect(*m);
+  m_hbaoDownsample = m;
+  return m;
+}
+
+gsl::not_null<std::shared_ptr<Material>> MaterialManager::getHBAOTemporal()
+{
+  if(m_hbaoTemporal != nullptr)
+    return gsl::not_null{m_hbaoTemporal};
+
+  auto m = gslu::make_nn_shared<Material>(m_shaderCache->getHBAOTemporal());
+  configureForScreenSpaceEffect(*m);
+  m_hbaoTemporal = m;
+  return m;
+}
+
+gsl::not_null<std::shared_ptr<Material>> MaterialManager::getHBAOUpsample()
+{
+  if(m_hbaoUpsample != nullptr)
+    return gsl::not_null{m_hbaoUpsample};
+
+  auto m = gslu::make_nn_shared<Material>(m_shaderCache->getHBAOUpsample());
+  configureForScreenSpaceEffect(*m);
+  m_hbaoUpsample = m;
+  return m;
+}
+
 gsl::not_null<std::shared_ptr<Material>> MaterialManager::getVSMSquare()
 {
   if(m_vsmSquare != nullptr)
@@ -334,9 +389,80 @@ gsl::not_null<std::shared_ptr<Material>> MaterialManager::getVSMSquare()
 }
 
 void MaterialManager::setGeometryTextures(
-  std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> geometryTextures)
+  std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> geometryTextures,
+  std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> geometryTexturesFallback,
+  std::shared_ptr<gl::ShaderStorageBuffer<int32_t>> texturePages)
 {
   m_geometryTextures = std::move(geometryTextures);
+  m_geometryTexturesFallback = std::move(geometryTexturesFallback);
+  m_texturePages = std::move(texturePages);
+}
+
+void MaterialManager::bindGeometryTextures(Material& m)
+{
+  m.getUniform("u_diffuseTextures")
+    ->bind([this](const Node& /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
+           { uniform.set(gsl::not_null{m_geometryTextures}); });
+  m.getUniform("u_diffuseTexturesFallback")
+    ->bind([this](const Node& /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform)
+           { uniform.set(gsl::not_null{m_geometryTexturesFallback}); });
+  if(auto buffer = m.tryGetBuffer("b_texturePages"))
+    buffer->bind(
+      [this](const Node& /*node*/, const Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
+      {
+        if(m_texturePages != nullptr)
+          shaderStorageBlock.bind(*m_texturePages);
+      });
+}
+
+void MaterialManager::setTextureAnimation(std::shared_ptr<gl::ShaderStorageBuffer<ShaderAtlasTile>> atlasTiles,
+                                          std::shared_ptr<gl::ShaderStorageBuffer<int32_t>> animatedTiles)
+{
+  m_atlasTiles = std::move(atlasTiles);
+  m_animatedTiles = std::move(animatedTiles);
+}
+
+void MaterialManager::bindTextureAnimation(Material& m)
+{
+  if(auto buffer = m.tryGetBuffer("b_atlasTiles"))
+    buffer->bind(
+      [this](const Node& /*node*/, const Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
+      {
+        if(m_atlasTiles != nullptr)
+          shaderStorageBlock.bind(*m_atlasTiles);
+      });
+  if(auto buffer = m.tryGetBuffer("b_animatedTiles"))
+    buffer->bind(
+      [this](const Node& /*node*/, const Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
+      {
+        if(m_animatedTiles != nullptr)
+          shaderStorageBlock.bind(*m_animatedTiles);
+      });
+}
+
+void MaterialManager::setLightClusters(std::shared_ptr<gl::ShaderStorageBuffer<glm::uvec2>> lightClusters,
+                                       std::shared_ptr<gl::ShaderStorageBuffer<uint32_t>> lightIndices)
+{
+  m_lightClusters = std::move(lightClusters);
+  m_lightIndices = std::move(lightIndices);
+}
+
+void MaterialManager::bindLightClusters(Material& m)
+{
+  if(auto buffer = m.tryGetBuffer("b_lightClusters"))
+    buffer->bind(
+      [this](const Node& /*node*/, const Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
+      {
+        if(m_lightClusters != nullptr)
+          shaderStorageBlock.bind(*m_lightClusters);
+      });
+  if(auto buffer = m.tryGetBuffer("b_lightIndices"))
+    buffer->bind(
+      [this](const Node& /*node*/, const Mesh& /*mesh*/, gl::ShaderStorageBlock& shaderStorageBlock)
+      {
+        if(m_lightIndices != nullptr)
+          shaderStorageBlock.bind(*m_lightIndices);
+      });
 }
 
 void MaterialManager::setFiltering(bool bilinear, float anisotropyLevel)
@@ -344,23 +470,30 @@ void MaterialManager::setFiltering(bool bilinear, float anisotropyLevel)
   if(m_geometryTextures == nullptr)
     return;
 
-  auto sampler = gslu::make_nn_unique<gl::Sampler>("geometry-sampler");
-  if(bilinear)
-  {
-    sampler->set(gl::api::TextureMinFilter::LinearMipmapLinear);
-    sampler->set(gl::api::TextureMagFilter::Linear);
-  }
-  else
+  const auto createSampler = [bilinear, anisotropyLevel]()
   {
-    sampler->set(gl::api::TextureMinFilter::NearestMipmapLinear);
-    sampler->set(gl::api::TextureMagFilter::Nearest);
-  }
+    auto sampler = gslu::make_nn_unique<gl::Sampler>("geometry-sampler");
+    if(bilinear)
+    {
+      sampler->set(gl::api::TextureMinFilter::LinearMipmapLinear);
+      sampler->set(gl::api::TextureMagFilter::Linear);
+    }
+    else
+    {
+      sampler->set(gl::api::TextureMinFilter::NearestMipmapLinear);
+      sampler->set(gl::api::TextureMagFilter::Nearest);
+    }
 
-  if(anisotropyLevel != 0 && gl::hasAnisotropicFilteringExtension())
-    sampler->set(gl::api::SamplerParameterF::TextureMaxAnisotropy, anisotropyLevel);
+    if(anisotropyLevel != 0 && gl::hasAnisotropicFilteringExtension())
+      sampler->set(gl::api::SamplerParameterF::TextureMaxAnisotropy, anisotropyLevel);
+    return sampler;
+  };
 
   m_geometryTextures = std::make_shared<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>>(
-    m_geometryTextures->getTexture(), std::move(sampler));
+    m_geometryTextures->getTexture(), createSampler());
+  if(m_geometryTexturesFallback != nullptr)
+    m_geometryTexturesFallback = std::make_shared<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>>(
+      m_geometryTexturesFallback->getTexture(), createSampler());
 }
 
 gsl::not_null<std::shared_ptr<Material>>
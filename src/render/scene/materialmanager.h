@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <gl/buffer.h>
 #include <gl/pixel.h>
 #include <gl/soglb_fwd.h>
+#include <glm/vec2.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <map>
 #include <memory>
@@ -13,6 +15,11 @@
 // IWYU pragma: no_forward_declare gl::Texture2DArray
 // IWYU pragma: no_forward_declare gl::TextureHandle
 
+namespace render
+{
+struct ShaderAtlasTile;
+}
+
 namespace render::scene
 {
 class CSM;
@@ -27,6 +34,8 @@ public:
                            gsl::not_null<std::shared_ptr<Renderer>> renderer);
 
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getSprite(bool billboard);
+  //! sprites whose quads already face the camera in world space
+  [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getSpriteBatch();
 
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getCSMDepthOnly(bool skeletal);
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getDepthOnly(bool skeletal);
@@ -49,14 +58,23 @@ public:
   [[nodiscard]] const std::shared_ptr<Material>& getBackdrop();
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getFXAA();
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getHBAO();
+  [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getHBAODownsample();
+  [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getHBAOTemporal();
+  [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getHBAOUpsample();
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>> getVSMSquare();
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>>
     getFastGaussBlur(uint8_t extent, uint8_t blurDir, uint8_t blurDim);
   [[nodiscard]] gsl::not_null<std::shared_ptr<Material>>
     getFastBoxBlur(uint8_t extent, uint8_t blurDir, uint8_t blurDim);
 
-  void setGeometryTextures(std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> geometryTextures);
+  void setGeometryTextures(std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> geometryTextures,
+                           std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> geometryTexturesFallback,
+                           std::shared_ptr<gl::ShaderStorageBuffer<int32_t>> texturePages);
   void setFiltering(bool bilinear, float anisotropyLevel);
+  void setTextureAnimation(std::shared_ptr<gl::ShaderStorageBuffer<ShaderAtlasTile>> atlasTiles,
+                           std::shared_ptr<gl::ShaderStorageBuffer<int32_t>> animatedTiles);
+  void setLightClusters(std::shared_ptr<gl::ShaderStorageBuffer<glm::uvec2>> lightClusters,
+                        std::shared_ptr<gl::ShaderStorageBuffer<uint32_t>> lightIndices);
 
   void setCSM(const gsl::not_null<std::shared_ptr<CSM>>& csm)
   {
@@ -68,6 +86,7 @@ private:
   std::shared_ptr<gl::TextureHandle<gl::Texture2D<gl::RGB8>>> m_noiseTexture;
 
   std::map<bool, gsl::not_null<std::shared_ptr<Material>>> m_sprite{};
+  std::shared_ptr<Material> m_spriteBatch{nullptr};
   std::map<bool, gsl::not_null<std::shared_ptr<Material>>> m_csmDepthOnly{};
   std::map<bool, gsl::not_null<std::shared_ptr<Material>>> m_depthOnly{};
   std::map<std::tuple<bool, bool, bool>, gsl::not_null<std::shared_ptr<Material>>> m_geometry{};
@@ -82,11 +101,24 @@ private:
   std::shared_ptr<Material> m_backdrop{nullptr};
   std::shared_ptr<Material> m_fxaa{nullptr};
   std::shared_ptr<Material> m_hbao{nullptr};
+  std::shared_ptr<Material> m_hbaoDownsample{nullptr};
+  std::shared_ptr<Material> m_hbaoTemporal{nullptr};
+  std::shared_ptr<Material> m_hbaoUpsample{nullptr};
   std::shared_ptr<Material> m_linearDepth{nullptr};
   std::shared_ptr<Material> m_vsmSquare{nullptr};
 
   std::shared_ptr<CSM> m_csm;
   const gsl::not_null<std::shared_ptr<Renderer>> m_renderer;
   std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> m_geometryTextures;
+  std::shared_ptr<gl::TextureHandle<gl::Texture2DArray<gl::SRGBA8>>> m_geometryTexturesFallback;
+  std::shared_ptr<gl::ShaderStorageBuffer<int32_t>> m_texturePages;
+  std::shared_ptr<gl::ShaderStorageBuffer<ShaderAtlasTile>> m_atlasTiles;
+  std::shared_ptr<gl::ShaderStorageBuffer<int32_t>> m_animatedTiles;
+  std::shared_ptr<gl::ShaderStorageBuffer<glm::uvec2>> m_lightClusters;
+  std::shared_ptr<gl::ShaderStorageBuffer<uint32_t>> m_lightIndices;
+
+  void bindGeometryTextures(Material& m);
+  void bindTextureAnimation(Material& m);
+  void bindLightClusters(Material& m);
 };
 } // namespace render::scene
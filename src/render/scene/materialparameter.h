@@ -1,13 +1,14 @@
 #pragma once
 
+#include "bindingstamp.h"
+
+#include <atomic>
+#include <cstdint>
 #include <gsl/gsl-lite.hpp>
+#include <string>
 
 namespace render::scene
 {
-class Mesh;
-class Node;
-class ShaderProgram;
-
 class MaterialParameter
 {
 public:
@@ -18,16 +19,53 @@ public:
 
   virtual ~MaterialParameter() = default;
 
-  virtual bool
-    bind(const Node& node, const Mesh& mesh, const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram)
-    = 0;
-
   [[nodiscard]] const std::string& getName() const
   {
     return m_name;
   }
 
+  [[nodiscard]] uint64_t getVersion() const noexcept
+  {
+    return m_version;
+  }
+
+protected:
+  // the value is a constant if it does not depend on the node or mesh being rendered
+  void valueChanged(bool isConstant) noexcept
+  {
+    m_version = nextVersion();
+    m_isConstant = isConstant;
+  }
+
+  [[nodiscard]] bool isApplied(const BindingStamp& stamp) const noexcept
+  {
+    return m_isConstant && stamp.writer == this && stamp.version == m_version;
+  }
+
+  void markApplied(BindingStamp& stamp, bool hasOverride) const noexcept
+  {
+    if(m_isConstant && !hasOverride)
+    {
+      stamp.writer = this;
+      stamp.version = m_version;
+    }
+    else
+    {
+      stamp.writer = nullptr;
+    }
+  }
+
 private:
+  // versions are unique across all parameters, so a stamp of a destroyed parameter can't match a new parameter that
+  // happens to be allocated at the same address
+  [[nodiscard]] static uint64_t nextVersion() noexcept
+  {
+    static std::atomic<uint64_t> version{0};
+    return ++version;
+  }
+
   const std::string m_name;
+  uint64_t m_version = nextVersion();
+  bool m_isConstant = false;
 };
 } // namespace render::scene
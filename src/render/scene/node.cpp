@@ -11,6 +11,11 @@
 
 namespace render::scene
 {
+namespace
+{
+uint64_t currentBoundsEpoch = 1;
+} // namespace
+
 Node::~Node()
 {
   if(auto p = m_parent.lock())
@@ -21,6 +26,7 @@ Node::~Node()
                      [this](const gsl::not_null<std::shared_ptr<Node>>& node) { return node.get().get() == this; });
     if(it != p->m_children.end())
       p->m_children.erase(it);
+    p->invalidateCachedBounds();
   }
 
   m_parent.reset();
@@ -28,14 +34,58 @@ Node::~Node()
   transformChanged();
 }
 
+void Node::invalidateBounds() noexcept
+{
+  ++currentBoundsEpoch;
+}
+
 // NOLINTNEXTLINE(misc-no-recursion)
+void Node::updateBounds() const
+{
+  if(m_boundsEpoch == currentBoundsEpoch)
+    return;
+
+  m_boundsEpoch = currentBoundsEpoch;
+  if(m_renderable == nullptr)
+    m_worldBounds = Bounds{};
+  else if(const auto localBounds = getLocalBounds(); localBounds.has_value())
+    m_worldBounds = localBounds->transformed(getModelMatrix());
+  else
+    m_worldBounds.reset();
+
+  // invisible children are included, as visibility may change between the passes of a frame; children with unknown
+  // bounds don't discard the bounds of their siblings, they are only flagged so the visitor tests them individually
+  m_subtreeBounds = m_worldBounds.value_or(Bounds{});
+  m_unknownSubtreeBounds = !m_worldBounds.has_value();
+  for(const auto& child : m_children)
+  {
+    m_subtreeBounds.merge(child->getSubtreeBounds());
+    m_unknownSubtreeBounds |= child->hasUnknownSubtreeBounds();
+  }
+}
+
+void Node::invalidateCachedBounds() const
+{
+  m_boundsEpoch = 0;
+  for(auto p = m_parent.lock(); p != nullptr; p = p->m_parent.lock())
+    p->m_boundsEpoch = 0;
+}
+
 void Node::transformChanged()
+{
+  markTransformDirty();
+  invalidateCachedBounds();
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void Node::markTransformDirty()
 {
   m_dirty = true;
+  m_boundsEpoch = 0;
 
   for(const auto& child : m_children)
   {
-    child->transformChanged();
+    child->markTransformDirty();
   }
 }
 
@@ -43,14 +93,13 @@ void Node::accept(Visitor& visitor)
 {
   SOGLB_DEBUGGROUP(getName());
 
-  auto state = visitor.getContext().getCurrentState();
-  state.setScissorTest(visitor.withScissors() && m_renderState.getScissorTest().value_or(true));
   const auto [xy, size] = getCombinedScissors();
-  state.setScissorRegion(xy, size);
-  visitor.getContext().pushState(state);
+  visitor.getContext().pushScissors(
+    visitor.withScissors() && m_renderState.getScissorTest().value_or(true), xy, size);
 
   visitor.getContext().setCurrentNode(this);
-  if(m_renderable != nullptr)
+  // leaves have already been tested by the visitor
+  if(m_renderable != nullptr && (m_children.empty() || !visitor.getContext().isCulled(getWorldBounds())))
   {
     [[maybe_unused]] const bool rendered = m_renderable->render(visitor.getContext());
     if constexpr(Visitor::FlushAfterEachRender)
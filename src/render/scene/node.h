@@ -1,10 +1,12 @@
 #pragma once
 
+#include "culling.h"
 #include "materialparameteroverrider.h"
 
 #include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/throw_exception.hpp>
+#include <cstdint>
 #include <gl/buffer.h>
 #include <gl/renderstate.h>
 #include <glm/common.hpp>
@@ -13,6 +15,7 @@
 #include <glm/vec3.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -101,6 +104,7 @@ public:
   void setRenderable(const std::shared_ptr<Renderable>& renderable)
   {
     m_renderable = renderable;
+    invalidateCachedBounds();
   }
 
   [[nodiscard]] const List& getChildren() const
@@ -118,6 +122,7 @@ public:
     for(auto& child : m_children)
       child->m_parent.reset();
     m_children.clear();
+    invalidateCachedBounds();
   }
 
   [[nodiscard]] const glm::mat4& getLocalMatrix() const
@@ -157,11 +162,42 @@ public:
     return m_transformBuffer;
   }
 
-  [[nodiscard]] virtual bool canBeCulled(const glm::mat4& /*viewProjection*/) const
+  //! bounds of the renderable in local space; nodes with unknown bounds are never culled
+  [[nodiscard]] virtual std::optional<Bounds> getLocalBounds() const
   {
-    return false;
+    return m_localBounds;
   }
 
+  void setLocalBounds(const std::optional<Bounds>& bounds)
+  {
+    m_localBounds = bounds;
+    invalidateCachedBounds();
+  }
+
+  //! world space bounds of the renderable; empty without a renderable, and nullopt if unknown
+  [[nodiscard]] const std::optional<Bounds>& getWorldBounds() const
+  {
+    updateBounds();
+    return m_worldBounds;
+  }
+
+  //! world space bounds of the node and all of its descendants, excluding those with unknown bounds
+  [[nodiscard]] const Bounds& getSubtreeBounds() const
+  {
+    updateBounds();
+    return m_subtreeBounds;
+  }
+
+  //! if set, the subtree can't be culled as a whole, and its nodes need to be tested individually
+  [[nodiscard]] bool hasUnknownSubtreeBounds() const
+  {
+    updateBounds();
+    return m_unknownSubtreeBounds;
+  }
+
+  //! bounds are cached until this is called, so all passes of a frame share them
+  static void invalidateBounds() noexcept;
+
   void clear()
   {
     auto tmp = m_children;
@@ -211,6 +247,10 @@ public:
 
 private:
   void transformChanged();
+  void markTransformDirty();
+  //! drops the cached bounds of this node and its ancestors, whose subtree bounds include this node
+  void invalidateCachedBounds() const;
+  void updateBounds() const;
 
   std::string m_name;
   List m_children;
@@ -225,6 +265,12 @@ private:
   mutable Transform m_transform{};
   mutable gl::UniformBuffer<Transform> m_transformBuffer;
 
+  std::optional<Bounds> m_localBounds{};
+  mutable uint64_t m_boundsEpoch = 0;
+  mutable std::optional<Bounds> m_worldBounds{};
+  mutable Bounds m_subtreeBounds{};
+  mutable bool m_unknownSubtreeBounds = false;
+
   std::vector<std::tuple<glm::vec2, glm::vec2>> m_scissors;
 
   friend void setParent(gsl::not_null<std::shared_ptr<Node>> node, const std::shared_ptr<Node>& newParent);
@@ -244,6 +290,7 @@ inline void setParent(gsl::not_null<std::shared_ptr<Node>> node, // NOLINT(perfo
     BOOST_ASSERT(it != currentParent->m_children.end());
     node->m_parent.reset();
     currentParent->m_children.erase(it);
+    currentParent->invalidateCachedBounds();
   }
 
   // then add to hierarchy again
@@ -1,25 +1,33 @@
 #pragma once
 
+#include "culling.h"
 #include "node.h"
 #include "rendermode.h"
 
+#include <boost/container/small_vector.hpp>
+#include <cstddef>
 #include <gl/renderstate.h>
 #include <glm/glm.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <optional>
-#include <stack>
 
 namespace render::scene
 {
+// tracks the effective render state while traversing the scene graph; the state stack lives inside the context, so
+// traversing doesn't allocate unless the scene graph is unusually deep
 class RenderContext final
 {
 public:
+  //! state stack depth which doesn't need any allocations; each node pushes at most two states
+  static constexpr size_t InlineStateDepth = 64;
+
   explicit RenderContext(RenderMode renderMode, const std::optional<glm::mat4>& viewProjection)
       : m_currentNode{&m_dummyNode}
       , m_renderMode{renderMode}
       , m_viewProjection{viewProjection}
+      , m_frustum{viewProjection.has_value() ? std::optional<Frustum>{Frustum{*viewProjection}} : std::nullopt}
   {
-    m_renderStates.push(gl::RenderState::getWantedState());
+    m_renderStates.emplace_back(gl::RenderState::getWantedState());
   }
 
   [[nodiscard]] Node* getCurrentNode() const noexcept
@@ -34,20 +42,32 @@ public:
 
   void pushState(const gl::RenderState& state)
   {
-    auto tmp = m_renderStates.top();
-    tmp.merge(state);
-    m_renderStates.emplace(tmp);
+    // copy first, growing beyond the inline capacity moves the elements
+    auto merged = m_renderStates.back();
+    if(!state.isEmpty())
+      merged.merge(state);
+    m_renderStates.emplace_back(merged);
+  }
+
+  //! pushes the current state with only the scissors replaced
+  void pushScissors(bool enabled, const glm::vec2& xy, const glm::vec2& size)
+  {
+    auto state = m_renderStates.back();
+    state.setScissorTest(enabled);
+    state.setScissorRegion(xy, size);
+    m_renderStates.emplace_back(state);
   }
 
   void bindState()
   {
     Expects(!m_renderStates.empty());
-    gl::RenderState::getWantedState() = m_renderStates.top();
+    gl::RenderState::getWantedState() = m_renderStates.back();
   }
 
   void popState()
   {
-    m_renderStates.pop();
+    Expects(m_renderStates.size() > 1);
+    m_renderStates.pop_back();
   }
 
   [[nodiscard]] RenderMode getRenderMode() const noexcept
@@ -60,17 +80,33 @@ public:
     return m_viewProjection;
   }
 
+  //! checks bounds against the view frustum, if there is one; unknown bounds are never culled
+  [[nodiscard]] bool isCulled(const std::optional<Bounds>& bounds) const
+  {
+    if(!m_frustum.has_value() || !bounds.has_value())
+      return false;
+
+    auto& stats = getCullingStats();
+    ++stats.tested;
+    if(!m_frustum->isOutside(*bounds))
+      return false;
+
+    ++stats.culled;
+    return true;
+  }
+
   [[nodiscard]] const auto& getCurrentState() const
   {
     Expects(!m_renderStates.empty());
-    return m_renderStates.top();
+    return m_renderStates.back();
   }
 
 private:
   Node m_dummyNode{""};
   Node* m_currentNode;
-  std::stack<gl::RenderState> m_renderStates{};
+  boost::container::small_vector<gl::RenderState, InlineStateDepth> m_renderStates{};
   const RenderMode m_renderMode;
   const std::optional<glm::mat4> m_viewProjection;
+  const std::optional<Frustum> m_frustum;
 };
 } // namespace render::scene
@@ -1,5 +1,6 @@
 #include "renderer.h"
 
+#include "camera.h"
 #include "node.h"
 #include "rendercontext.h"
 #include "rendermode.h"
@@ -29,9 +30,11 @@ Renderer::~Renderer() = default;
 
 void Renderer::render()
 {
-  RenderContext context{RenderMode::Full, std::nullopt};
+  RenderContext context{RenderMode::Full, m_camera->getViewProjectionMatrix()};
   Visitor visitor{context};
   m_rootNode->accept(visitor);
+  // this is the last pass of the frame traversing the scene
+  Node::invalidateBounds();
 
   const auto t = std::chrono::high_resolution_clock::now();
   const auto dt = t - m_lastLogTime;
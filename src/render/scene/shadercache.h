@@ -90,6 +90,21 @@ public:
     return get("flat.vert", "hbao.frag");
   }
 
+  auto getHBAODownsample()
+  {
+    return get("flat.vert", "hbao_downsample.frag");
+  }
+
+  auto getHBAOTemporal()
+  {
+    return get("flat.vert", "hbao_temporal.frag");
+  }
+
+  auto getHBAOUpsample()
+  {
+    return get("flat.vert", "hbao_upsample.frag");
+  }
+
   auto getFastGaussBlur(const uint8_t extent, uint8_t blurDim)
   {
     Expects(extent > 0);
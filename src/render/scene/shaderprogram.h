@@ -1,5 +1,7 @@
 #pragma once
 
+#include "bindingstamp.h"
+
 #include <boost/container/flat_map.hpp>
 #include <boost/container/vector.hpp>
 #include <filesystem>
@@ -7,6 +9,7 @@
 #include <gsl/gsl-lite.hpp>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace render::scene
@@ -67,6 +70,11 @@ public:
 
   void bind() const;
 
+  [[nodiscard]] BindingStamp& getStamp(const gl::Uniform& uniform)
+  {
+    return m_uniformStamps[&uniform];
+  }
+
   [[nodiscard]] const gl::Program& getHandle() const
   {
     return m_handle;
@@ -89,6 +97,7 @@ private:
   boost::container::flat_map<std::string, gl::Uniform> m_uniforms;
   boost::container::flat_map<std::string, gl::ShaderStorageBlock> m_shaderStorageBlocks;
   boost::container::flat_map<std::string, gl::UniformBlock> m_uniformBlocks;
+  std::unordered_map<const gl::Uniform*, BindingStamp> m_uniformStamps;
 
   template<typename T>
   static const T* find(const boost::container::flat_map<std::string, T>& map, const std::string& needle)
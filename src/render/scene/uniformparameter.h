@@ -34,6 +34,7 @@ public:
   void set(const T& value)
   {
     m_valueSetter = [value](const Node& /*node*/, const Mesh& /*mesh*/, gl::Uniform& uniform) { uniform.set(value); };
+    valueChanged(true);
   }
 
   template<class ClassType, class ValueType>
@@ -41,6 +42,7 @@ public:
   {
     m_valueSetter = [classInstance, valueMethod](const Node& /*node*/, gl::Uniform& uniform)
     { uniform.set((classInstance->*valueMethod)()); };
+    valueChanged(false);
   }
 
   using UniformValueSetter = void(const Node& node, const Mesh& mesh, gl::Uniform& uniform);
@@ -48,6 +50,7 @@ public:
   void bind(std::function<UniformValueSetter>&& setter)
   {
     m_valueSetter = std::move(setter);
+    valueChanged(false);
   }
 
   template<class ClassType, class ValueType>
@@ -58,15 +61,12 @@ public:
     m_valueSetter =
       [classInstance, valueMethod, countMethod](const Node& /*node*/, const Mesh& /*mesh*/, const gl::Uniform& uniform)
     { uniform.set((classInstance->*valueMethod)(), (classInstance->*countMethod)()); };
+    valueChanged(false);
   }
 
-  bool bind(const Node& node,
-            const Mesh& mesh,
-            const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram) override;
+  BindResult bind(const Node& node, const Mesh& mesh, gl::Uniform& uniform, BindingStamp& stamp);
 
 private:
-  [[nodiscard]] gl::Uniform* findUniform(const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram) const;
-
   std::function<UniformValueSetter> m_valueSetter;
 };
 
@@ -87,6 +87,7 @@ public:
   {
     m_bufferBinder = [value](const Node& /*node*/, const Mesh& /*mesh*/, gl::UniformBlock& uniformBlock)
     { uniformBlock.bind(*value); };
+    valueChanged(true);
   }
 
   template<class ClassType, typename T>
@@ -95,6 +96,7 @@ public:
     m_bufferBinder
       = [classInstance, valueMethod](const Node& /*node*/, const Mesh& /*mesh*/, gl::UniformBlock& uniformBlock)
     { uniformBlock.bind((classInstance->*valueMethod)()); };
+    valueChanged(false);
   }
 
   using BufferBinder = void(const Node& node, const Mesh& mesh, gl::UniformBlock& uniformBlock);
@@ -102,19 +104,15 @@ public:
   void bind(std::function<BufferBinder>&& setter)
   {
     m_bufferBinder = std::move(setter);
+    valueChanged(false);
   }
 
-  bool bind(const Node& node,
-            const Mesh& mesh,
-            const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram) override;
+  BindResult bind(const Node& node, const Mesh& mesh, gl::UniformBlock& uniformBlock, BindingStamp& stamp);
 
   void bindTransformBuffer();
   void bindCameraBuffer(const gsl::not_null<std::shared_ptr<Camera>>& camera);
 
 private:
-  [[nodiscard]] gl::UniformBlock*
-    findUniformBlock(const gsl::not_null<std::shared_ptr<ShaderProgram>>& shaderProgram) const;
-
   std::function<BufferBinder> m_bufferBinder;
 };
 } // namespace render::scene
@@ -13,7 +13,7 @@ void Visitor::visit(Node& node)
 {
   if(!node.isVisible())
     return;
-  if(const auto& vp = m_context.getViewProjection(); vp.has_value() && node.canBeCulled(vp.value()))
+  if(!node.hasUnknownSubtreeBounds() && m_context.isCulled(node.getSubtreeBounds()))
   {
     SOGLB_DEBUGGROUP(node.getName() + " <culled>");
     return;
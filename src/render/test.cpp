@@ -0,0 +1,309 @@
+#define BOOST_TEST_MODULE render
+
+#include "dynamicresolution.h"
+#include "rendersettings.h"
+#include "scene/csm.h"
+#include "scene/culling.h"
+
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <cstdint>
+#include <gl/renderstate.h>
+#include <glm/gtc/epsilon.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+render::DynamicResolution createDynamicResolution()
+{
+  render::RenderSettings settings{};
+  settings.dynamicResolution = true;
+  settings.dynamicResolutionMinScale = 0.5f;
+  settings.dynamicResolutionMaxScale = 1.0f;
+  settings.dynamicResolutionLowerBudget = 0.7f;
+  settings.dynamicResolutionUpperBudget = 0.95f;
+
+  render::DynamicResolution dynamicResolution{};
+  dynamicResolution.configure(settings);
+  return dynamicResolution;
+}
+
+// feeds the same budget usage for the given number of frames and returns the number of scale changes
+uint32_t feed(render::DynamicResolution& dynamicResolution, const float budgetUsage, const uint32_t frames)
+{
+  uint32_t changes = 0;
+  for(uint32_t i = 0; i < frames; ++i)
+  {
+    if(dynamicResolution.update(budgetUsage))
+      ++changes;
+  }
+  return changes;
+}
+
+bool isClose(const glm::vec3& a, const glm::vec3& b)
+{
+  return glm::all(glm::epsilonEqual(a, b, 1e-5f));
+}
+
+// looks along -z from the origin with a field of view of 90 degrees, so the side planes are at |x| = -z and |y| = -z
+render::scene::Frustum createFrustum()
+{
+  const auto projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+  const auto view = glm::lookAt(glm::vec3{0, 0, 0}, glm::vec3{0, 0, -1}, glm::vec3{0, 1, 0});
+  return render::scene::Frustum{projection * view};
+}
+
+// all states set, except for the viewport, like the state GL starts with
+gl::RenderState createCurrentState()
+{
+  auto state = gl::RenderState::getDefaults();
+  state.setProgram(0);
+  return state;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(render_tests)
+
+BOOST_AUTO_TEST_CASE(test_dynamic_resolution_disabled)
+{
+  render::DynamicResolution dynamicResolution{};
+  dynamicResolution.configure(render::RenderSettings{});
+  BOOST_CHECK_EQUAL(feed(dynamicResolution, 2.0f, 1000), 0u);
+  BOOST_CHECK_EQUAL(dynamicResolution.getScale(), 1.0f);
+}
+
+BOOST_AUTO_TEST_CASE(test_dynamic_resolution_sustain)
+{
+  auto dynamicResolution = createDynamicResolution();
+
+  // short spikes don't change the scale
+  for(uint32_t i = 0; i < 100; ++i)
+  {
+    BOOST_CHECK(!dynamicResolution.update(1.5f));
+    BOOST_CHECK(!dynamicResolution.update(0.8f));
+  }
+  BOOST_CHECK_EQUAL(dynamicResolution.getScale(), 1.0f);
+
+  BOOST_CHECK_EQUAL(feed(dynamicResolution, 1.5f, render::DynamicResolution::SustainFrames - 1), 0u);
+  BOOST_CHECK(dynamicResolution.update(1.5f));
+  BOOST_CHECK_EQUAL(dynamicResolution.getScale(), 1.0f - render::DynamicResolution::ScaleStep);
+}
+
+BOOST_AUTO_TEST_CASE(test_dynamic_resolution_limits)
+{
+  auto dynamicResolution = createDynamicResolution();
+
+  BOOST_CHECK_EQUAL(feed(dynamicResolution, 1.5f, 10000), 4u);
+  BOOST_CHECK_EQUAL(dynamicResolution.getScale(), 0.5f);
+  BOOST_CHECK(dynamicResolution.getRenderSize({1920, 1080}) == glm::ivec2(960, 540));
+
+  BOOST_CHECK_EQUAL(feed(dynamicResolution, 0.1f, 10000), 4u);
+  BOOST_CHECK_EQUAL(dynamicResolution.getScale(), 1.0f);
+  BOOST_CHECK(dynamicResolution.getRenderSize({1920, 1080}) == glm::ivec2(1920, 1080));
+}
+
+BOOST_AUTO_TEST_CASE(test_dynamic_resolution_oscillation_backoff)
+{
+  auto dynamicResolution = createDynamicResolution();
+
+  // a load alternating between too high and too low in bursts just long enough to trigger a step
+  constexpr uint32_t Burst = render::DynamicResolution::SustainFrames + render::DynamicResolution::Cooldown;
+  uint32_t changes = 0;
+  for(uint32_t i = 0; i < 20; ++i)
+  {
+    changes += feed(dynamicResolution, 1.5f, Burst);
+    changes += feed(dynamicResolution, 0.1f, Burst);
+  }
+
+  // without the backoff, every burst would cause a step
+  BOOST_CHECK_LT(changes, 20u);
+  BOOST_CHECK_GE(changes, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(test_dynamic_resolution_deterministic)
+{
+  auto a = createDynamicResolution();
+  auto b = createDynamicResolution();
+  for(uint32_t i = 0; i < 5000; ++i)
+  {
+    const auto budgetUsage = static_cast<float>((i * 7919u) % 1000u) / 500.0f;
+    BOOST_CHECK_EQUAL(a.update(budgetUsage), b.update(budgetUsage));
+  }
+  BOOST_CHECK_EQUAL(a.getScale(), b.getScale());
+}
+
+BOOST_AUTO_TEST_CASE(test_bounds_empty)
+{
+  const render::scene::Bounds empty{};
+  BOOST_CHECK(empty.isEmpty());
+  BOOST_CHECK(empty.transformed(glm::translate(glm::mat4{1.0f}, glm::vec3{1, 2, 3})).isEmpty());
+
+  render::scene::Bounds bounds{};
+  bounds.merge(render::scene::Bounds{glm::vec3{-1, -2, -3}, glm::vec3{1, 2, 3}});
+  BOOST_CHECK(!bounds.isEmpty());
+  bounds.merge(empty);
+  BOOST_CHECK(isClose(bounds.min, glm::vec3{-1, -2, -3}));
+  BOOST_CHECK(isClose(bounds.max, glm::vec3{1, 2, 3}));
+
+  bounds.merge(render::scene::Bounds{glm::vec3{5, 0, 0}, glm::vec3{6, 1, 1}});
+  BOOST_CHECK(isClose(bounds.min, glm::vec3{-1, -2, -3}));
+  BOOST_CHECK(isClose(bounds.max, glm::vec3{6, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(test_bounds_transformed)
+{
+  const render::scene::Bounds bounds{glm::vec3{0, 0, 0}, glm::vec3{1, 2, 3}};
+
+  const auto translated = bounds.transformed(glm::translate(glm::mat4{1.0f}, glm::vec3{10, 20, 30}));
+  BOOST_CHECK(isClose(translated.min, glm::vec3{10, 20, 30}));
+  BOOST_CHECK(isClose(translated.max, glm::vec3{11, 22, 33}));
+
+  // a quarter turn around y maps x to -z and z to x
+  const auto rotated = bounds.transformed(glm::rotate(glm::mat4{1.0f}, glm::radians(90.0f), glm::vec3{0, 1, 0}));
+  BOOST_CHECK(isClose(rotated.min, glm::vec3{0, 0, -1}));
+  BOOST_CHECK(isClose(rotated.max, glm::vec3{3, 2, 0}));
+
+  // the box of a rotated box must still contain all corners
+  const auto tilted = bounds.transformed(glm::rotate(glm::mat4{1.0f}, glm::radians(45.0f), glm::vec3{0, 0, 1}));
+  const auto halfDiagonal = std::sqrt(0.5f);
+  BOOST_CHECK(isClose(tilted.min, glm::vec3{-2 * halfDiagonal, 0, 0}));
+  BOOST_CHECK(isClose(tilted.max, glm::vec3{halfDiagonal, 3 * halfDiagonal, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(test_frustum_culling)
+{
+  const auto frustum = createFrustum();
+
+  BOOST_CHECK(!frustum.isOutside(render::scene::Bounds{glm::vec3{-1, -1, -11}, glm::vec3{1, 1, -9}}));
+  BOOST_CHECK(frustum.isOutside(render::scene::Bounds{glm::vec3{20, -1, -11}, glm::vec3{21, 1, -9}}));
+  BOOST_CHECK(frustum.isOutside(render::scene::Bounds{glm::vec3{-21, -1, -11}, glm::vec3{-20, 1, -9}}));
+  BOOST_CHECK(frustum.isOutside(render::scene::Bounds{glm::vec3{-1, 20, -11}, glm::vec3{1, 21, -9}}));
+  BOOST_CHECK(frustum.isOutside(render::scene::Bounds{glm::vec3{-1, -21, -11}, glm::vec3{1, -20, -9}}));
+
+  // boxes intersecting a plane are not culled
+  BOOST_CHECK(!frustum.isOutside(render::scene::Bounds{glm::vec3{9, -1, -11}, glm::vec3{12, 1, -9}}));
+  BOOST_CHECK(!frustum.isOutside(render::scene::Bounds{glm::vec3{-100, -100, -11}, glm::vec3{100, 100, -9}}));
+
+  // the near and far planes are ignored
+  BOOST_CHECK(!frustum.isOutside(render::scene::Bounds{glm::vec3{-1, -1, -500}, glm::vec3{1, 1, -400}}));
+  BOOST_CHECK(!frustum.isOutside(render::scene::Bounds{glm::vec3{-0.01f}, glm::vec3{0.01f}}));
+
+  BOOST_CHECK(frustum.isOutside(render::scene::Bounds{}));
+}
+
+BOOST_AUTO_TEST_CASE(test_frustum_culling_transformed)
+{
+  const auto frustum = createFrustum();
+
+  // a box outside of the frustum moved in front of the camera
+  const render::scene::Bounds bounds{glm::vec3{-1, -1, -1}, glm::vec3{1, 1, 1}};
+  BOOST_CHECK(frustum.isOutside(bounds.transformed(glm::translate(glm::mat4{1.0f}, glm::vec3{30, 0, -10}))));
+  BOOST_CHECK(!frustum.isOutside(bounds.transformed(glm::translate(glm::mat4{1.0f}, glm::vec3{0, 0, -10}))));
+  BOOST_CHECK(!frustum.isOutside(bounds.broadened(glm::vec3{20})
+                                   .transformed(glm::translate(glm::mat4{1.0f}, glm::vec3{30, 0, -10}))));
+}
+
+BOOST_AUTO_TEST_CASE(test_csm_camera_cut)
+{
+  using render::scene::isCameraCut;
+
+  const glm::vec3 position{1000, -500, 2000};
+  const glm::vec3 front{0, 0, -1};
+  // a chase camera following a running character
+  BOOST_CHECK(!isCameraCut(position, front, position + glm::vec3{50, 10, 0}, front));
+  BOOST_CHECK(!isCameraCut(position, front, position, glm::normalize(glm::vec3{0.3f, 0, -1})));
+
+  // switching to a camera in another room
+  BOOST_CHECK(isCameraCut(position, front, position + glm::vec3{3000, 0, 0}, front));
+  // switching to a camera looking at the previous view from the side
+  BOOST_CHECK(isCameraCut(position, front, position, glm::vec3{1, 0, 0}));
+  BOOST_CHECK(isCameraCut(position, front, position, -front));
+}
+
+BOOST_AUTO_TEST_CASE(test_render_state_merge_precedence)
+{
+  gl::RenderState state;
+  state.setDepthTest(true);
+  state.setBlend(false);
+  state.setLineWidth(2);
+
+  gl::RenderState other;
+  other.setDepthTest(false);
+  other.setLineWidth(3);
+  other.setCullFace(true);
+  state.merge(other);
+
+  // the merged states win, the others are kept
+  gl::RenderState expected;
+  expected.setDepthTest(false);
+  expected.setBlend(false);
+  expected.setLineWidth(3);
+  expected.setCullFace(true);
+  BOOST_CHECK_EQUAL(state.getSetMask(), expected.getSetMask());
+  BOOST_CHECK_EQUAL(state.getChanges(expected), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_render_state_merge_not_inherited)
+{
+  gl::RenderState state;
+  gl::RenderState other;
+  other.setViewport({640, 480});
+  other.setProgram(3);
+  other.setCullFace(false);
+  state.merge(other);
+
+  // the viewport and the program are never inherited
+  BOOST_CHECK_EQUAL(state.getSetMask(), gl::RenderState::CullFace);
+}
+
+BOOST_AUTO_TEST_CASE(test_render_state_changes)
+{
+  auto current = createCurrentState();
+  current.setViewport({640, 480});
+
+  auto wanted = current;
+  BOOST_CHECK_EQUAL(wanted.getChanges(current), 0u);
+  BOOST_CHECK_EQUAL(wanted.getChanges(current, true), wanted.getSetMask());
+
+  wanted.setDepthWrite(false);
+  wanted.setDepthFunction(gl::api::DepthFunction::Lequal);
+  BOOST_CHECK_EQUAL(wanted.getChanges(current), gl::RenderState::DepthWrite | gl::RenderState::DepthFunction);
+
+  // states not set in the current state are always applied
+  gl::RenderState empty;
+  gl::RenderState lineWidth;
+  lineWidth.setLineWidth(1);
+  BOOST_CHECK_EQUAL(lineWidth.getChanges(empty), gl::RenderState::LineWidth);
+}
+
+BOOST_AUTO_TEST_CASE(test_render_state_polygon_offset_pairing)
+{
+  auto current = createCurrentState();
+  current.setViewport({640, 480});
+
+  // both polygon offset states are set by the same call, so changing one applies both
+  auto wanted = current;
+  wanted.setPolygonOffsetFill(true);
+  BOOST_CHECK_EQUAL(wanted.getChanges(current), gl::RenderState::PolygonOffsetFill | gl::RenderState::PolygonOffset);
+
+  wanted = current;
+  wanted.setPolygonOffset(1, 2);
+  BOOST_CHECK_EQUAL(wanted.getChanges(current), gl::RenderState::PolygonOffsetFill | gl::RenderState::PolygonOffset);
+}
+
+BOOST_AUTO_TEST_CASE(test_render_state_scissor_needs_viewport)
+{
+  auto current = createCurrentState();
+  auto wanted = current;
+  wanted.setScissorRegion({-0.5f, -0.5f}, {1, 1});
+  wanted.setViewport({640, 480});
+
+  // the scissor region is relative to the viewport, so it waits until the viewport is known
+  BOOST_CHECK_EQUAL(wanted.getChanges(current), gl::RenderState::Viewport);
+  BOOST_CHECK_EQUAL(wanted.getChanges(current, true) & gl::RenderState::ScissorRegion, 0u);
+
+  current.setViewport({640, 480});
+  BOOST_CHECK_EQUAL(wanted.getChanges(current), gl::RenderState::ScissorRegion);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
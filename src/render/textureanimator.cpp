@@ -4,14 +4,21 @@
 #include "loader/file/datatypes.h"
 #include "loader/file/texture.h"
 
+#include <algorithm>
 #include <array>
 #include <gl/api/gl.hpp>
-#include <gl/vertexbuffer.h>
+#include <iterator>
 #include <memory>
 #include <utility>
 
 namespace render
 {
+namespace
+{
+// texture coordinates with z <= FirstAnimatedCoordinate reference an animated tile slot and corner
+constexpr int32_t FirstAnimatedCoordinate = -2;
+} // namespace
+
 TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data)
 {
   const uint16_t* ptr = data.data();
@@ -19,40 +26,87 @@ TextureAnimator::TextureAnimator(const std::vector<uint16_t>& data)
   if(sequenceCount == 0)
     return;
 
+  size_t slot = 0;
   for(size_t i = 0; i < sequenceCount; ++i)
   {
     Sequence sequence;
+    sequence.firstSlot = slot;
     const auto n = *ptr++;
     for(size_t j = 0; j <= n; ++j)
     {
       Expects(ptr <= &data.back());
       const auto tileId = *ptr++;
       sequence.tileIds.emplace_back(tileId);
-      m_sequenceByTileId.emplace(tileId, m_sequences.size());
+      m_slotByTileId.emplace(tileId, slot++);
     }
     m_sequences.emplace_back(std::move(sequence));
   }
 }
 
-void TextureAnimator::Sequence::updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles)
+std::vector<core::TextureTileId> TextureAnimator::getTileIds() const
 {
-  BOOST_ASSERT(!tileIds.empty());
+  std::vector<core::TextureTileId> result;
+  result.reserve(m_slotByTileId.size());
+  for(const auto& [tileId, slot] : m_slotByTileId)
+    result.emplace_back(tileId);
+  return result;
+}
 
-  for(const auto& [buffer, vertices] : affectedVertices)
+void TextureAnimator::setAtlasTiles(const std::vector<engine::world::AtlasTile>& tiles)
+{
+  std::vector<ShaderAtlasTile> shaderTiles;
+  shaderTiles.reserve(tiles.size());
+  for(const auto& tile : tiles)
   {
-    auto uvArray = buffer->map(gl::api::BufferAccess::ReadWrite);
+    ShaderAtlasTile shaderTile;
+    shaderTile.uv01 = glm::vec4{tile.uvCoordinates[0], tile.uvCoordinates[1]};
+    shaderTile.uv23 = glm::vec4{tile.uvCoordinates[2], tile.uvCoordinates[3]};
+    shaderTile.layer = tile.textureKey.tileAndFlag & loader::file::TextureIndexMask;
+    shaderTiles.emplace_back(shaderTile);
+  }
+  m_atlasTilesBuffer->setData(shaderTiles, gl::api::BufferUsage::StaticDraw);
 
-    for(const VertexReference& vref : vertices)
-    {
-      BOOST_ASSERT(buffer->size() > 0 && vref.bufferIndex < static_cast<size_t>(buffer->size()));
-      BOOST_ASSERT(vref.queueOffset < tileIds.size());
-      const engine::world::AtlasTile& tile = tiles[tileIds[vref.queueOffset].get()];
+  uploadAnimatedTiles();
+}
 
-      uvArray[vref.bufferIndex].uv
-        = glm::vec3{tile.uvCoordinates[vref.sourceIndex], tile.textureKey.tileAndFlag & loader::file::TextureIndexMask};
-    }
+TextureAnimator::AnimatedUV TextureAnimator::getUV(const core::TextureTileId& tileId,
+                                                   const engine::world::AtlasTile& tile,
+                                                   const int sourceIndex) const
+{
+  Expects(sourceIndex >= 0 && sourceIndex < 4);
+
+  const auto it = m_slotByTileId.find(tileId);
+  if(it == m_slotByTileId.end())
+    return AnimatedUV{tile.textureKey.tileAndFlag & loader::file::TextureIndexMask, tile.uvCoordinates[sourceIndex]};
 
-    buffer->unmap();
+  return AnimatedUV{FirstAnimatedCoordinate - gsl::narrow<glm::int32>(it->second * 4 + sourceIndex),
+                    tile.uvCoordinates[sourceIndex]};
+}
+
+void TextureAnimator::update()
+{
+  for(Sequence& sequence : m_sequences)
+    sequence.rotate();
+
+  uploadAnimatedTiles();
+}
+
+void TextureAnimator::uploadAnimatedTiles()
+{
+  const size_t slotCount
+    = m_sequences.empty() ? 0 : m_sequences.back().firstSlot + m_sequences.back().tileIds.size();
+  std::vector<int32_t> animatedTiles(slotCount, 0);
+  for(const Sequence& sequence : m_sequences)
+  {
+    std::transform(sequence.tileIds.begin(),
+                   sequence.tileIds.end(),
+                   std::next(animatedTiles.begin(), gsl::narrow<std::ptrdiff_t>(sequence.firstSlot)),
+                   [](const core::TextureTileId& tileId) { return gsl::narrow<int32_t>(tileId.get()); });
   }
+
+  if(animatedTiles.empty())
+    animatedTiles.emplace_back(0);
+
+  m_animatedTilesBuffer->setData(animatedTiles, gl::api::BufferUsage::DynamicDraw);
 }
 } // namespace render
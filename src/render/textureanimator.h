@@ -2,23 +2,21 @@
 
 #include "core/id.h"
 
-#include <algorithm>
 #include <boost/assert.hpp>
 #include <cstddef>
 #include <cstdint>
-#include <gl/soglb_fwd.h>
+#include <gl/buffer.h>
 #include <glm/fwd.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <gsl/gsl-lite.hpp>
+#include <gslu.h>
 #include <iterator>
 #include <map>
 #include <memory>
-#include <set>
 #include <vector>
 
-// IWYU pragma: no_forward_declare gl::VertexBuffer
-
 namespace engine::world
 {
 struct AtlasTile;
@@ -26,6 +24,19 @@ struct AtlasTile;
 
 namespace render
 {
+// mirrors AtlasTile in texture_animation.glsl
+struct ShaderAtlasTile
+{
+  glm::vec4 uv01{0.0f};
+  glm::vec4 uv23{0.0f};
+  int32_t layer = 0;
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays, modernize-avoid-c-arrays)
+  int32_t _pad[3]{0, 0, 0};
+};
+static_assert(sizeof(ShaderAtlasTile) == 48, "Invalid ShaderAtlasTile struct size");
+
+// animated tiles are resolved by the shaders (see texture_animation.glsl); the per-frame work is limited to uploading
+// the current tile of each animated slot
 class TextureAnimator
 {
 public:
@@ -42,57 +53,31 @@ public:
 
   explicit TextureAnimator(const std::vector<uint16_t>& data);
 
-  void registerVertex(const core::TextureTileId& tileId,
-                      const std::shared_ptr<gl::VertexBuffer<AnimatedUV>>& buffer,
-                      const int sourceIndex,
-                      const size_t bufferIndex)
-  {
-    if(m_sequenceByTileId.find(tileId) == m_sequenceByTileId.end())
-      return;
+  void setAtlasTiles(const std::vector<engine::world::AtlasTile>& tiles);
 
-    const size_t sequenceId = m_sequenceByTileId[tileId];
-    m_sequences.at(sequenceId).registerVertex(buffer, Sequence::VertexReference(bufferIndex, sourceIndex), tileId);
+  [[nodiscard]] AnimatedUV
+    getUV(const core::TextureTileId& tileId, const engine::world::AtlasTile& tile, int sourceIndex) const;
+
+  void update();
+
+  [[nodiscard]] std::vector<core::TextureTileId> getTileIds() const;
+
+  [[nodiscard]] const auto& getAtlasTilesBuffer() const
+  {
+    return m_atlasTilesBuffer;
   }
 
-  void updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles)
+  [[nodiscard]] const auto& getAnimatedTilesBuffer() const
   {
-    for(Sequence& sequence : m_sequences)
-    {
-      sequence.rotate();
-      sequence.updateCoordinates(tiles);
-    }
+    return m_animatedTilesBuffer;
   }
 
 private:
   struct Sequence
   {
-    struct VertexReference
-    {
-      //! Vertex buffer index
-      const size_t bufferIndex;
-      const int sourceIndex;
-      size_t queueOffset = 0;
-
-      VertexReference(const size_t bufferIdx, const int sourceIdx)
-          : bufferIndex(bufferIdx)
-          , sourceIndex(sourceIdx)
-      {
-        Expects(sourceIdx >= 0 && sourceIdx < 4);
-      }
-
-      bool operator<(const VertexReference& rhs) const noexcept
-      {
-        return bufferIndex < rhs.bufferIndex;
-      }
-
-      bool operator==(const VertexReference& rhs) const noexcept
-      {
-        return bufferIndex == rhs.bufferIndex;
-      }
-    };
-
+    //! Index of the first slot in the animated tiles table
+    size_t firstSlot = 0;
     std::vector<core::TextureTileId> tileIds;
-    std::map<std::shared_ptr<gl::VertexBuffer<AnimatedUV>>, std::set<VertexReference>> affectedVertices;
 
     void rotate()
     {
@@ -101,21 +86,15 @@ private:
       tileIds.erase(tileIds.begin(), std::next(tileIds.begin()));
       tileIds.emplace_back(first);
     }
-
-    void registerVertex(const std::shared_ptr<gl::VertexBuffer<AnimatedUV>>& buffer,
-                        VertexReference vertex,
-                        const core::TextureTileId& tileId)
-    {
-      const auto it = std::find(tileIds.begin(), tileIds.end(), tileId);
-      Expects(it != tileIds.end());
-      vertex.queueOffset = std::distance(tileIds.begin(), it);
-      affectedVertices[buffer].insert(vertex);
-    }
-
-    void updateCoordinates(const std::vector<engine::world::AtlasTile>& tiles);
   };
 
+  void uploadAnimatedTiles();
+
   std::vector<Sequence> m_sequences;
-  std::map<core::TextureTileId, size_t> m_sequenceByTileId;
+  std::map<core::TextureTileId, size_t> m_slotByTileId;
+  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<ShaderAtlasTile>>> m_atlasTilesBuffer{
+    gslu::make_nn_shared<gl::ShaderStorageBuffer<ShaderAtlasTile>>("atlas-tiles")};
+  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<int32_t>>> m_animatedTilesBuffer{
+    gslu::make_nn_shared<gl::ShaderStorageBuffer<int32_t>>("animated-tiles")};
 };
 } // namespace render
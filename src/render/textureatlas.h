@@ -219,6 +219,11 @@ public:
     return m_pageSize;
   }
 
+  [[nodiscard]] size_t getPageCount() const
+  {
+    return m_atlases.size();
+  }
+
   std::pair<size_t, glm::ivec2> put(const gl::CImgWrapper& img)
   {
     auto extended = img;
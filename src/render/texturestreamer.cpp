@@ -0,0 +1,180 @@
+#include "texturestreamer.h"
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/log/trivial.hpp>
+#include <gl/api/gl.hpp>
+#include <gl/texture2darray.h>
+#include <glm/vec3.hpp>
+#include <utility>
+
+namespace render
+{
+TextureStreamer::TextureStreamer(const int32_t pageSize,
+                                 std::vector<Page>&& pages,
+                                 const std::set<size_t>& pinnedPages,
+                                 const size_t budgetBytes)
+    : m_pageSize{pageSize}
+    , m_pages{std::move(pages)}
+    , m_requests(m_pages.size(), LowestPriority)
+    , m_pageTable(m_pages.size(), -1)
+{
+  Expects(!m_pages.empty());
+  const auto levels = m_pages.front().size();
+  Expects(levels > 0);
+  for(const auto& level : m_pages.front())
+    m_pageBytes += level.size() * sizeof(gl::SRGBA8);
+
+  auto slotCount = std::min(std::max(budgetBytes / m_pageBytes, pinnedPages.size() + 1), m_pages.size());
+  if(slotCount * m_pageBytes > budgetBytes)
+    BOOST_LOG_TRIVIAL(warning) << "Texture budget of " << budgetBytes / 1024 / 1024
+                               << " MB is too small for the pinned texture pages";
+
+  m_textures = std::make_shared<gl::Texture2DArray<gl::SRGBA8>>(
+    glm::ivec3{m_pageSize, m_pageSize, gsl::narrow<int>(slotCount)}, "all-textures", gsl::narrow<int>(levels));
+
+  const auto fallbackLevel = std::min(FallbackLevel, levels - 1);
+  m_fallbackTextures = std::make_shared<gl::Texture2DArray<gl::SRGBA8>>(
+    glm::ivec3{m_pageSize >> fallbackLevel, m_pageSize >> fallbackLevel, gsl::narrow<int>(m_pages.size())},
+    "all-textures-fallback",
+    gsl::narrow<int>(levels - fallbackLevel));
+  for(size_t page = 0; page < m_pages.size(); ++page)
+  {
+    Expects(m_pages[page].size() == levels);
+    for(size_t level = fallbackLevel; level < levels; ++level)
+    {
+      m_fallbackTextures->assign(m_pages[page][level], gsl::narrow<int>(page), gsl::narrow<int>(level - fallbackLevel));
+      m_stats.fallbackBytes += m_pages[page][level].size() * sizeof(gl::SRGBA8);
+    }
+  }
+
+  m_slots.resize(slotCount);
+  size_t slot = 0;
+  for(const auto page : pinnedPages)
+  {
+    Expects(page < m_pages.size());
+    m_slots[slot].pinned = true;
+    upload(page, slot++);
+  }
+
+  if(slotCount == m_pages.size())
+  {
+    // everything fits into the budget, nothing to stream
+    for(size_t page = 0; page < m_pages.size(); ++page)
+    {
+      if(m_pageTable[page] < 0)
+      {
+        m_slots[slot].pinned = true;
+        upload(page, slot++);
+      }
+    }
+  }
+
+  m_stats.pages = m_pages.size();
+  m_stats.slots = slotCount;
+  m_stats.uploads = 0;
+  BOOST_LOG_TRIVIAL(info) << "Texture streaming: " << slotCount << " of " << m_pages.size() << " pages resident, "
+                          << pinnedPages.size() << " pinned, " << m_pageBytes / 1024 / 1024 << " MB per page";
+  update();
+}
+
+TextureStreamer::~TextureStreamer() = default;
+
+void TextureStreamer::request(const size_t page, const uint32_t priority)
+{
+  BOOST_ASSERT(page < m_requests.size());
+  m_requests[page] = std::min(m_requests[page], priority);
+}
+
+void TextureStreamer::update()
+{
+  ++m_frame;
+  for(auto& slot : m_slots)
+  {
+    if(!slot.pinned)
+      slot.priority = LowestPriority;
+  }
+
+  std::vector<std::pair<uint32_t, size_t>> missing;
+  for(size_t page = 0; page < m_pages.size(); ++page)
+  {
+    const auto priority = std::exchange(m_requests[page], LowestPriority);
+    if(priority == LowestPriority)
+      continue;
+
+    if(const auto slot = m_pageTable[page]; slot >= 0)
+    {
+      auto& target = m_slots[static_cast<size_t>(slot)];
+      target.lastUsed = m_frame;
+      target.priority = std::min(target.priority, priority);
+    }
+    else
+    {
+      missing.emplace_back(priority, page);
+    }
+  }
+
+  std::sort(missing.begin(), missing.end());
+  size_t uploads = 0;
+  for(const auto& [priority, page] : missing)
+  {
+    if(uploads >= MaxUploadsPerFrame)
+      break;
+
+    const auto slot = findSlot(priority);
+    if(!slot.has_value())
+      break;
+
+    upload(page, *slot);
+    m_slots[*slot].priority = priority;
+    ++uploads;
+  }
+
+  m_stats.missing = missing.size() - uploads;
+  m_stats.resident
+    = std::count_if(m_slots.begin(), m_slots.end(), [](const Slot& slot) { return slot.page.has_value(); });
+  m_stats.residentBytes = m_stats.resident * m_pageBytes;
+
+  if(std::exchange(m_pageTableDirty, false))
+    m_pageTableBuffer->setData(m_pageTable, gl::api::BufferUsage::DynamicDraw);
+}
+
+std::optional<size_t> TextureStreamer::findSlot(const uint32_t priority) const
+{
+  // prefer free slots, then the least recently used of the least important slots; slots needed at least as much as
+  // the missing page are never replaced
+  std::optional<size_t> best;
+  for(size_t i = 0; i < m_slots.size(); ++i)
+  {
+    const auto& slot = m_slots[i];
+    if(!slot.page.has_value())
+      return i;
+    if(slot.pinned || slot.priority <= priority)
+      continue;
+
+    if(!best.has_value() || slot.priority > m_slots[*best].priority
+       || (slot.priority == m_slots[*best].priority && slot.lastUsed < m_slots[*best].lastUsed))
+      best = i;
+  }
+  return best;
+}
+
+void TextureStreamer::upload(const size_t page, const size_t slot)
+{
+  auto& target = m_slots.at(slot);
+  if(target.page.has_value())
+  {
+    m_pageTable[*target.page] = -1;
+    ++m_stats.evictions;
+  }
+
+  for(size_t level = 0; level < m_pages[page].size(); ++level)
+    m_textures->assign(m_pages[page][level], gsl::narrow<int>(slot), gsl::narrow<int>(level));
+
+  target.page = page;
+  target.lastUsed = m_frame;
+  m_pageTable[page] = gsl::narrow<int32_t>(slot);
+  m_pageTableDirty = true;
+  ++m_stats.uploads;
+}
+} // namespace render
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <gl/buffer.h>
+#include <gl/pixel.h>
+#include <gl/soglb_fwd.h>
+#include <gsl/gsl-lite.hpp>
+#include <gslu.h>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+// IWYU pragma: no_forward_declare gl::Texture2DArray
+
+namespace render
+{
+// keeps all texture atlas pages in system memory and streams them into a fixed number of full resolution texture array
+// slots in request priority order; a low resolution copy of every page stays resident and is sampled while a page is
+// not resident (see texture_streaming.glsl)
+class TextureStreamer final
+{
+public:
+  //! pixels of all mip levels of a page
+  using Page = std::vector<std::vector<gl::SRGBA8>>;
+
+  //! first mip level of the always resident fallback copies
+  static constexpr size_t FallbackLevel = 3;
+  static constexpr size_t MaxUploadsPerFrame = 2;
+  static constexpr uint32_t LowestPriority = std::numeric_limits<uint32_t>::max();
+
+  struct Stats
+  {
+    size_t pages = 0;
+    size_t slots = 0;
+    size_t resident = 0;
+    size_t missing = 0;
+    size_t uploads = 0;
+    size_t evictions = 0;
+    size_t residentBytes = 0;
+    size_t fallbackBytes = 0;
+  };
+
+  explicit TextureStreamer(int32_t pageSize,
+                           std::vector<Page>&& pages,
+                           const std::set<size_t>& pinnedPages,
+                           size_t budgetBytes);
+  ~TextureStreamer();
+
+  //! requests a page for the current frame; lower priorities are streamed in first
+  void request(size_t page, uint32_t priority);
+  //! uploads the most important missing pages and resets the requests
+  void update();
+
+  [[nodiscard]] const auto& getTextures() const
+  {
+    return m_textures;
+  }
+
+  [[nodiscard]] const auto& getFallbackTextures() const
+  {
+    return m_fallbackTextures;
+  }
+
+  [[nodiscard]] const auto& getPageTableBuffer() const
+  {
+    return m_pageTableBuffer;
+  }
+
+  [[nodiscard]] const Stats& getStats() const
+  {
+    return m_stats;
+  }
+
+private:
+  struct Slot
+  {
+    std::optional<size_t> page{};
+    bool pinned = false;
+    uint64_t lastUsed = 0;
+    uint32_t priority = LowestPriority;
+  };
+
+  [[nodiscard]] std::optional<size_t> findSlot(uint32_t priority) const;
+  void upload(size_t page, size_t slot);
+
+  const int32_t m_pageSize;
+  std::vector<Page> m_pages;
+  size_t m_pageBytes = 0;
+  std::vector<uint32_t> m_requests;
+  std::vector<int32_t> m_pageTable;
+  std::vector<Slot> m_slots;
+  uint64_t m_frame = 0;
+  bool m_pageTableDirty = true;
+  Stats m_stats{};
+
+  std::shared_ptr<gl::Texture2DArray<gl::SRGBA8>> m_textures;
+  std::shared_ptr<gl::Texture2DArray<gl::SRGBA8>> m_fallbackTextures;
+  gsl::not_null<std::shared_ptr<gl::ShaderStorageBuffer<int32_t>>> m_pageTableBuffer{
+    gslu::make_nn_shared<gl::ShaderStorageBuffer<int32_t>>("texture-pages")};
+};
+} // namespace render
@@ -6,10 +6,18 @@
 #include <fstream>
 #include <gsl/gsl-lite.hpp>
 #include <ryml.hpp>
+#include <sstream>
+#include <string>
 #include <type_traits>
+#include <utility>
 
 namespace serialization
 {
+//! tag for documents which are read from or written to a string instead of a file
+struct InMemory
+{
+};
+
 template<bool Loading>
 class YAMLDocument
 {
@@ -68,6 +76,15 @@ public:
     }
   }
 
+  explicit YAMLDocument(InMemory /*tag*/, std::string buffer = {})
+      : m_buffer{std::move(buffer)}
+  {
+    if constexpr(Loading)
+      m_tree = ryml::parse(c4::to_csubstr("<memory>"), c4::to_csubstr(m_buffer));
+    else
+      m_tree.rootref() |= ryml::MAP;
+  }
+
   template<typename T, typename TContext, bool DelayLoading = Loading>
   auto load(const std::string& key, TContext& context) -> std::enable_if_t<DelayLoading, T>
   {
@@ -122,6 +139,14 @@ public:
     file << m_tree.rootref();
   }
 
+  template<bool DelayLoading = Loading>
+  [[nodiscard]] auto toString() const -> std::enable_if_t<!DelayLoading, std::string>
+  {
+    std::ostringstream stream;
+    stream << m_tree.rootref();
+    return stream.str();
+  }
+
   template<bool DelayLoading = Loading>
   auto operator[](const std::string& key) -> std::enable_if_t<DelayLoading, ryml::NodeRef>
   {
@@ -19,6 +19,7 @@
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -134,6 +135,7 @@ public:
   {
     Expects(m_binding >= 0);
     GL_ASSERT(api::bindBufferBase(_Target, m_binding, buffer.getHandle()));
+    ++getBindCounts()[m_binding];
   }
 
   [[nodiscard]] auto getBinding() const noexcept
@@ -141,7 +143,19 @@ public:
     return m_binding;
   }
 
+  //! number of buffers bound to the binding point so far, by any block using it
+  [[nodiscard]] uint64_t getBindCount() const
+  {
+    return getBindCounts()[m_binding];
+  }
+
 private:
+  [[nodiscard]] static std::unordered_map<int32_t, uint64_t>& getBindCounts()
+  {
+    static std::unordered_map<int32_t, uint64_t> bindCounts;
+    return bindCounts;
+  }
+
   int32_t m_binding;
 };
 
@@ -8,6 +8,25 @@
 
 namespace gl
 {
+namespace
+{
+size_t countBits(RenderState::Mask mask)
+{
+  size_t count = 0;
+  for(; mask != 0; mask &= mask - 1u)
+    ++count;
+  return count;
+}
+
+void setCapability(const api::EnableCap cap, const bool enabled)
+{
+  if(enabled)
+    GL_ASSERT(api::enable(cap));
+  else
+    GL_ASSERT(api::disable(cap));
+}
+} // namespace
+
 inline RenderState& getCurrentState()
 {
   static RenderState currentState{};
@@ -24,150 +43,141 @@ inline RenderState& getCurrentState()
   return currentState;
 }
 
-void RenderState::apply(const bool force) const
+RenderState::Mask RenderState::getDirtyMask(const RenderState& current) const
 {
-  // Update any state if...
-  //   - it is forced
-  //   - or it is explicitly set and different than the current state
+  Mask differing = ~current.m_set | ((m_flags ^ current.m_flags) & BooleanFields);
   // NOLINTNEXTLINE(bugprone-macro-parentheses)
-#define RS_CHANGED(m) (force || (m.has_value() && m != getCurrentState().m))
-  if(RS_CHANGED(m_viewport))
-  {
-    GL_ASSERT(api::viewport(0, 0, m_viewport->x, m_viewport->y));
-    getCurrentState().m_viewport = m_viewport;
-  }
-  if(RS_CHANGED(m_program))
+#define RS_DIFFERS(field, cond)      \
+  if((m_set & (field)) != 0 && (cond)) \
+  differing |= (field)
+  RS_DIFFERS(Viewport, m_viewport != current.m_viewport);
+  RS_DIFFERS(Program, m_program != current.m_program);
+  RS_DIFFERS(DepthFunction, m_depthFunction != current.m_depthFunction);
+  RS_DIFFERS(BlendFactors, m_blendFactors != current.m_blendFactors);
+  RS_DIFFERS(CullFaceSide, m_cullFaceSide != current.m_cullFaceSide);
+  RS_DIFFERS(FrontFace, m_frontFace != current.m_frontFace);
+  RS_DIFFERS(LineWidth, m_lineWidth != current.m_lineWidth);
+  RS_DIFFERS(ScissorRegion, m_scissorXy != current.m_scissorXy || m_scissorSize != current.m_scissorSize);
+  RS_DIFFERS(PolygonOffset,
+             m_polygonOffsetFactor != current.m_polygonOffsetFactor
+               || m_polygonOffsetUnits != current.m_polygonOffsetUnits);
+#undef RS_DIFFERS
+  return m_set & differing;
+}
+
+RenderState::Mask RenderState::getChanges(const RenderState& current, const bool force) const
+{
+  auto dirty = force ? m_set : getDirtyMask(current);
+  // the scissor region is relative to the viewport, so it can only be applied once the viewport is known
+  if((current.m_set & Viewport) == 0)
+    dirty &= ~static_cast<Mask>(ScissorRegion);
+  // both polygon offset states are set by the same call
+  if(dirty & (PolygonOffsetFill | PolygonOffset))
   {
-    GL_ASSERT(api::useProgram(m_program.value()));
-    getCurrentState().m_program = m_program;
+    Expects((m_set & (PolygonOffsetFill | PolygonOffset)) == (PolygonOffsetFill | PolygonOffset));
+    dirty |= PolygonOffsetFill | PolygonOffset;
   }
-  if(RS_CHANGED(m_blendEnabled))
-  {
-    if(m_blendEnabled.value())
-      GL_ASSERT(api::enable(api::EnableCap::Blend));
-    else
-      GL_ASSERT(api::disable(api::EnableCap::Blend));
-    getCurrentState().m_blendEnabled = m_blendEnabled;
+  return dirty;
+}
+
+void RenderState::assign(const RenderState& other, const Mask mask)
+{
+  m_set |= mask;
+  m_flags = (m_flags & ~(mask & BooleanFields)) | (other.m_flags & mask & BooleanFields);
+  if(mask & Viewport)
+    m_viewport = other.m_viewport;
+  if(mask & Program)
+    m_program = other.m_program;
+  if(mask & DepthFunction)
+    m_depthFunction = other.m_depthFunction;
+  if(mask & BlendFactors)
+    m_blendFactors = other.m_blendFactors;
+  if(mask & CullFaceSide)
+    m_cullFaceSide = other.m_cullFaceSide;
+  if(mask & FrontFace)
+    m_frontFace = other.m_frontFace;
+  if(mask & LineWidth)
+    m_lineWidth = other.m_lineWidth;
+  if(mask & ScissorRegion)
+  {
+    m_scissorXy = other.m_scissorXy;
+    m_scissorSize = other.m_scissorSize;
+  }
+  if(mask & PolygonOffset)
+  {
+    m_polygonOffsetFactor = other.m_polygonOffsetFactor;
+    m_polygonOffsetUnits = other.m_polygonOffsetUnits;
   }
-  if(RS_CHANGED(m_blendFactors))
-  {
-    const auto [srcRgb, srcAlpha, dstRgb, dstAlpha] = m_blendFactors.value();
+}
+
+void RenderState::apply(const bool force) const
+{
+  // Update any state if...
+  //   - it is forced
+  //   - or it is explicitly set and different than the current state
+  auto& current = getCurrentState();
+  const auto dirty = getChanges(current, force);
+
+  auto& stats = getStats();
+  stats.applied += countBits(dirty);
+  stats.skipped += countBits(m_set & ~dirty);
+  if(dirty == 0)
+    return;
+
+  if(dirty & Viewport)
+    GL_ASSERT(api::viewport(0, 0, m_viewport.x, m_viewport.y));
+  if(dirty & Program)
+    GL_ASSERT(api::useProgram(m_program));
+  if(dirty & Blend)
+    setCapability(api::EnableCap::Blend, (m_flags & Blend) != 0);
+  if(dirty & BlendFactors)
+  {
+    const auto [srcRgb, srcAlpha, dstRgb, dstAlpha] = m_blendFactors;
     GL_ASSERT(api::blendFuncSeparate(srcRgb, dstRgb, srcAlpha, dstAlpha));
-    getCurrentState().m_blendFactors = m_blendFactors;
-  }
-  if(RS_CHANGED(m_cullFaceEnabled))
-  {
-    if(m_cullFaceEnabled.value())
-      GL_ASSERT(api::enable(api::EnableCap::CullFace));
-    else
-      GL_ASSERT(api::disable(api::EnableCap::CullFace));
-    getCurrentState().m_cullFaceEnabled = m_cullFaceEnabled;
-  }
-  if(RS_CHANGED(m_cullFaceSide))
-  {
-    GL_ASSERT(api::cullFace(m_cullFaceSide.value()));
-    getCurrentState().m_cullFaceSide = m_cullFaceSide;
-  }
-  if(RS_CHANGED(m_frontFace))
-  {
-    GL_ASSERT(api::frontFace(m_frontFace.value()));
-    getCurrentState().m_frontFace = m_frontFace;
-  }
-  if(RS_CHANGED(m_lineWidth))
-  {
-    GL_ASSERT(api::lineWidth(m_lineWidth.value()));
-    getCurrentState().m_lineWidth = m_lineWidth;
-  }
-  if(RS_CHANGED(m_lineSmooth))
-  {
-    if(m_lineSmooth.value())
-      GL_ASSERT(api::enable(api::EnableCap::LineSmooth));
-    else
-      GL_ASSERT(api::disable(api::EnableCap::LineSmooth));
-    getCurrentState().m_lineSmooth = m_lineSmooth;
-  }
-  if(RS_CHANGED(m_depthTestEnabled))
-  {
-    if(m_depthTestEnabled.value())
-      GL_ASSERT(api::enable(api::EnableCap::DepthTest));
-    else
-      GL_ASSERT(api::disable(api::EnableCap::DepthTest));
-    getCurrentState().m_depthTestEnabled = m_depthTestEnabled;
   }
-  if(RS_CHANGED(m_depthWriteEnabled))
-  {
-    GL_ASSERT(api::depthMask(m_depthWriteEnabled.value()));
-    getCurrentState().m_depthWriteEnabled = m_depthWriteEnabled;
-  }
-  if(RS_CHANGED(m_depthClampEnabled))
-  {
-    if(m_depthClampEnabled.value())
-      GL_ASSERT(api::enable(api::EnableCap::DepthClamp));
-    else
-      GL_ASSERT(api::disable(api::EnableCap::DepthClamp));
-    getCurrentState().m_depthClampEnabled = m_depthClampEnabled;
-  }
-  if(RS_CHANGED(m_depthFunction))
-  {
-    GL_ASSERT(api::depthFunc(m_depthFunction.value()));
-    getCurrentState().m_depthFunction = m_depthFunction;
-  }
-  if(RS_CHANGED(m_scissorTest))
-  {
-    if(m_scissorTest.value())
-      GL_ASSERT(api::enable(api::EnableCap::ScissorTest));
-    else
-      GL_ASSERT(api::disable(api::EnableCap::ScissorTest));
-    getCurrentState().m_scissorTest = m_scissorTest;
-  }
-  if(RS_CHANGED(m_scissorRegion) && getCurrentState().m_viewport.has_value())
-  {
-    const auto vp = glm::vec2{*getCurrentState().m_viewport};
-    const auto& [xy, size] = *m_scissorRegion;
-    const auto screenXy = glm::floor(vp * (xy + glm::vec2{1, 1}) * 0.5f);
-    const auto screenSize = glm::ceil(vp * size * 0.5f);
+  if(dirty & CullFace)
+    setCapability(api::EnableCap::CullFace, (m_flags & CullFace) != 0);
+  if(dirty & CullFaceSide)
+    GL_ASSERT(api::cullFace(m_cullFaceSide));
+  if(dirty & FrontFace)
+    GL_ASSERT(api::frontFace(m_frontFace));
+  if(dirty & LineWidth)
+    GL_ASSERT(api::lineWidth(m_lineWidth));
+  if(dirty & LineSmooth)
+    setCapability(api::EnableCap::LineSmooth, (m_flags & LineSmooth) != 0);
+  if(dirty & DepthTest)
+    setCapability(api::EnableCap::DepthTest, (m_flags & DepthTest) != 0);
+  if(dirty & DepthWrite)
+    GL_ASSERT(api::depthMask((m_flags & DepthWrite) != 0));
+  if(dirty & DepthClamp)
+    setCapability(api::EnableCap::DepthClamp, (m_flags & DepthClamp) != 0);
+  if(dirty & DepthFunction)
+    GL_ASSERT(api::depthFunc(m_depthFunction));
+  if(dirty & ScissorTest)
+    setCapability(api::EnableCap::ScissorTest, (m_flags & ScissorTest) != 0);
+  if(dirty & ScissorRegion)
+  {
+    const auto vp = glm::vec2{current.m_viewport};
+    const auto screenXy = glm::floor(vp * (m_scissorXy + glm::vec2{1, 1}) * 0.5f);
+    const auto screenSize = glm::ceil(vp * m_scissorSize * 0.5f);
     GL_ASSERT(api::scissor(gsl::narrow_cast<int32_t>(screenXy.x),
                            gsl::narrow_cast<int32_t>(screenXy.y),
                            gsl::narrow_cast<api::core::SizeType>(screenSize.x),
                            gsl::narrow_cast<api::core::SizeType>(screenSize.y)));
-    getCurrentState().m_scissorRegion = m_scissorRegion;
   }
-  if(RS_CHANGED(m_polygonOffsetFillEnabled) || RS_CHANGED(m_polygonOffset))
+  if(dirty & PolygonOffset)
   {
-    Expects(m_polygonOffset.has_value());
-    if(m_polygonOffsetFillEnabled.value())
-      GL_ASSERT(api::enable(api::EnableCap::PolygonOffsetFill));
-    else
-      GL_ASSERT(api::disable(api::EnableCap::PolygonOffsetFill));
-    auto [factor, units] = *m_polygonOffset;
-    GL_ASSERT(api::polygonOffset(factor, units));
-    getCurrentState().m_polygonOffsetFillEnabled = m_polygonOffsetFillEnabled;
-    getCurrentState().m_polygonOffset = m_polygonOffset;
+    setCapability(api::EnableCap::PolygonOffsetFill, (m_flags & PolygonOffsetFill) != 0);
+    GL_ASSERT(api::polygonOffset(m_polygonOffsetFactor, m_polygonOffsetUnits));
   }
-#undef RS_CHANGED
+
+  current.assign(*this, dirty);
 }
 
 void RenderState::merge(const RenderState& other)
 {
-#define MERGE_OPT(n)                                               \
-  if(other.n.has_value()) /* NOLINT(bugprone-macro-parentheses) */ \
-  n = other.n             /* NOLINT(bugprone-macro-parentheses) */
-  MERGE_OPT(m_cullFaceEnabled);
-  MERGE_OPT(m_depthTestEnabled);
-  MERGE_OPT(m_depthWriteEnabled);
-  MERGE_OPT(m_depthClampEnabled);
-  MERGE_OPT(m_depthFunction);
-  MERGE_OPT(m_blendEnabled);
-  MERGE_OPT(m_blendFactors);
-  MERGE_OPT(m_cullFaceSide);
-  MERGE_OPT(m_frontFace);
-  MERGE_OPT(m_lineWidth);
-  MERGE_OPT(m_lineSmooth);
-  MERGE_OPT(m_scissorTest);
-  MERGE_OPT(m_scissorRegion);
-  MERGE_OPT(m_polygonOffsetFillEnabled);
-  MERGE_OPT(m_polygonOffset);
-#undef MERGE_OPT
+  // the viewport and the program are never inherited
+  assign(other, other.m_set & ~static_cast<Mask>(Viewport | Program));
 }
 
 RenderState& RenderState::getWantedState()
@@ -181,6 +191,12 @@ void RenderState::applyWantedState()
   getWantedState().apply();
 }
 
+RenderState::Stats& RenderState::getStats()
+{
+  static Stats stats;
+  return stats;
+}
+
 RenderState RenderState::getDefaults()
 {
   static bool initialized = false;
@@ -2,16 +2,53 @@
 
 #include "api/gl.hpp"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <glm/vec2.hpp>
 #include <optional>
-#include <tuple>
 
 namespace gl
 {
+// the states are stored as plain values, with a bit mask telling which of them are set, so merging and comparing
+// states only touches the set states
 class RenderState final
 {
 public:
+  //! counts the state changes sent to GL, and the ones skipped because GL already had the wanted state
+  struct Stats
+  {
+    size_t applied = 0;
+    size_t skipped = 0;
+  };
+
+  using Mask = uint32_t;
+
+  //! one bit per state, used for the set mask and the dirty mask; boolean states also use it for their value
+  enum Field : Mask
+  {
+    Viewport = 1u << 0u,
+    Program = 1u << 1u,
+    CullFace = 1u << 2u,
+    DepthTest = 1u << 3u,
+    DepthWrite = 1u << 4u,
+    DepthClamp = 1u << 5u,
+    DepthFunction = 1u << 6u,
+    Blend = 1u << 7u,
+    BlendFactors = 1u << 8u,
+    CullFaceSide = 1u << 9u,
+    FrontFace = 1u << 10u,
+    LineWidth = 1u << 11u,
+    LineSmooth = 1u << 12u,
+    ScissorTest = 1u << 13u,
+    ScissorRegion = 1u << 14u,
+    PolygonOffsetFill = 1u << 15u,
+    PolygonOffset = 1u << 16u,
+  };
+
+  static constexpr Mask BooleanFields
+    = CullFace | DepthTest | DepthWrite | DepthClamp | Blend | LineSmooth | ScissorTest | PolygonOffsetFill;
+
   RenderState(const RenderState&) noexcept = default;
   RenderState(RenderState&&) noexcept = default;
   RenderState& operator=(const RenderState&) = default;
@@ -22,7 +59,7 @@ public:
 
   void setBlend(const bool enabled)
   {
-    m_blendEnabled = enabled;
+    setFlag(Blend, enabled);
   }
 
   void setBlendFactors(const api::BlendingFactor src, const api::BlendingFactor dst)
@@ -36,78 +73,102 @@ public:
                        const api::BlendingFactor dstAlpha)
   {
     m_blendFactors = {srcRgb, srcAlpha, dstRgb, dstAlpha};
+    m_set |= BlendFactors;
   }
 
   void setCullFace(const bool enabled)
   {
-    m_cullFaceEnabled = enabled;
+    setFlag(CullFace, enabled);
   }
 
   void setCullFaceSide(const api::CullFaceMode side)
   {
     m_cullFaceSide = side;
+    m_set |= CullFaceSide;
   }
 
   void setFrontFace(const api::FrontFaceDirection winding)
   {
     m_frontFace = winding;
+    m_set |= FrontFace;
   }
 
   void setDepthTest(const bool enabled)
   {
-    m_depthTestEnabled = enabled;
+    setFlag(DepthTest, enabled);
   }
 
   void setDepthWrite(const bool enabled)
   {
-    m_depthWriteEnabled = enabled;
+    setFlag(DepthWrite, enabled);
   }
 
   void setDepthClamp(const bool enabled)
   {
-    m_depthClampEnabled = enabled;
+    setFlag(DepthClamp, enabled);
   }
 
   void setDepthFunction(const api::DepthFunction func)
   {
     m_depthFunction = func;
+    m_set |= DepthFunction;
   }
 
   void setLineWidth(const float width)
   {
     m_lineWidth = width;
+    m_set |= LineWidth;
   }
 
   void setLineSmooth(const bool enabled)
   {
-    m_lineSmooth = enabled;
+    setFlag(LineSmooth, enabled);
   }
 
   void setViewport(const glm::ivec2& viewport)
   {
     m_viewport = viewport;
+    m_set |= Viewport;
   }
 
   void setScissorTest(bool enabled)
   {
-    m_scissorTest = enabled;
+    setFlag(ScissorTest, enabled);
   }
 
-  [[nodiscard]] const auto& getScissorTest() const
+  [[nodiscard]] std::optional<bool> getScissorTest() const
   {
-    return m_scissorTest;
+    if((m_set & ScissorTest) == 0)
+      return std::nullopt;
+    return (m_flags & ScissorTest) != 0;
   }
 
   void setScissorRegion(const glm::vec2& xy, const glm::vec2& size)
   {
-    m_scissorRegion = {xy, size};
+    m_scissorXy = xy;
+    m_scissorSize = size;
+    m_set |= ScissorRegion;
   }
 
   void setProgram(const uint32_t program)
   {
     m_program = program;
+    m_set |= Program;
+  }
+
+  [[nodiscard]] bool isEmpty() const noexcept
+  {
+    return m_set == 0;
+  }
+
+  [[nodiscard]] Mask getSetMask() const noexcept
+  {
+    return m_set;
   }
 
+  //! the states which need to be sent to GL to get from the current state to this one
+  [[nodiscard]] Mask getChanges(const RenderState& current, bool force = false) const;
+
   static RenderState getDefaults();
 
   static RenderState& getWantedState();
@@ -117,39 +178,51 @@ public:
     getWantedState() = getDefaults();
   }
 
+  static Stats& getStats();
+
   void merge(const RenderState& other);
 
   void setPolygonOffsetFill(bool enabled)
   {
-    m_polygonOffsetFillEnabled = enabled;
+    setFlag(PolygonOffsetFill, enabled);
   }
 
   void setPolygonOffset(float factor, float units)
   {
-    m_polygonOffset = {factor, units};
+    m_polygonOffsetFactor = factor;
+    m_polygonOffsetUnits = units;
+    m_set |= PolygonOffset;
   }
 
 private:
+  void setFlag(const Field field, const bool enabled)
+  {
+    if(enabled)
+      m_flags |= field;
+    else
+      m_flags &= ~static_cast<Mask>(field);
+    m_set |= field;
+  }
+
+  //! set states which differ from the given state, or which are not set there
+  [[nodiscard]] Mask getDirtyMask(const RenderState& current) const;
+  //! copies the masked states, setting them
+  void assign(const RenderState& other, Mask mask);
+
   void apply(bool force = false) const;
 
-  // States
-  std::optional<glm::ivec2> m_viewport{};
-  std::optional<uint32_t> m_program{};
-  std::optional<bool> m_cullFaceEnabled{};
-  std::optional<bool> m_depthTestEnabled{};
-  std::optional<bool> m_depthWriteEnabled{};
-  std::optional<bool> m_depthClampEnabled{};
-  std::optional<api::DepthFunction> m_depthFunction{};
-  std::optional<bool> m_blendEnabled{};
-  std::optional<std::tuple<api::BlendingFactor, api::BlendingFactor, api::BlendingFactor, api::BlendingFactor>>
-    m_blendFactors{};
-  std::optional<api::CullFaceMode> m_cullFaceSide{};
-  std::optional<api::FrontFaceDirection> m_frontFace{};
-  std::optional<float> m_lineWidth{};
-  std::optional<bool> m_lineSmooth{};
-  std::optional<bool> m_scissorTest{};
-  std::optional<std::tuple<glm::vec2, glm::vec2>> m_scissorRegion{};
-  std::optional<bool> m_polygonOffsetFillEnabled{};
-  std::optional<std::tuple<float, float>> m_polygonOffset{};
+  Mask m_set = 0;
+  Mask m_flags = 0;
+  uint32_t m_program = 0;
+  glm::ivec2 m_viewport{0, 0};
+  api::DepthFunction m_depthFunction{};
+  std::array<api::BlendingFactor, 4> m_blendFactors{};
+  api::CullFaceMode m_cullFaceSide{};
+  api::FrontFaceDirection m_frontFace{};
+  float m_lineWidth = 0;
+  glm::vec2 m_scissorXy{0, 0};
+  glm::vec2 m_scissorSize{0, 0};
+  float m_polygonOffsetFactor = 0;
+  float m_polygonOffsetUnits = 0;
 };
 } // namespace gl
@@ -106,6 +106,17 @@ void Window::updateWindowSize()
   RenderState::getWantedState().setViewport(m_viewport);
 }
 
+int Window::getRefreshRate() const
+{
+  // fullscreen mode is a borderless window on the primary monitor
+  const auto monitor = glfwGetPrimaryMonitor();
+  if(monitor == nullptr)
+    return 0;
+
+  const auto mode = glfwGetVideoMode(monitor);
+  return mode == nullptr ? 0 : mode->refreshRate;
+}
+
 void Window::swapBuffers() const
 {
   glfwSwapBuffers(m_window);
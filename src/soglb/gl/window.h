@@ -20,10 +20,12 @@ public:
 
   void updateWindowSize();
 
+  //! refresh rate of the primary monitor in Hz, or 0 if unknown
+  [[nodiscard]] int getRefreshRate() const;
+
+  //! events are not polled here, so a close request is only seen after the next glfwPollEvents()
   [[nodiscard]] bool windowShouldClose() const
   {
-    glfwPollEvents();
-
     return glfwWindowShouldClose(m_window) == GLFW_TRUE;
   }
 
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <gsl/gsl-lite.hpp>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace util
+{
+// raw native-endian serialization of trivially copyable values and arrays, used for engine-private cache files
+
+template<typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void writeBlock(std::ostream& stream, const std::vector<T>& data)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  writeValue(stream, gsl::narrow<uint32_t>(data.size()));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  stream.write(reinterpret_cast<const char*>(data.data()), gsl::narrow<std::streamsize>(data.size() * sizeof(T)));
+}
+
+template<typename T>
+bool readValue(std::istream& stream, T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return stream.gcount() == sizeof(T);
+}
+
+// returns a negative value if the stream can't seek
+inline std::streamoff getRemainingSize(std::istream& stream)
+{
+  const auto position = stream.tellg();
+  if(position < 0)
+    return -1;
+
+  stream.seekg(0, std::ios::end);
+  const auto end = stream.tellg();
+  stream.seekg(position, std::ios::beg);
+  return end < 0 ? -1 : end - position;
+}
+
+template<typename T>
+bool readBlock(std::istream& stream, std::vector<T>& data)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  uint32_t size = 0;
+  if(!readValue(stream, size))
+    return false;
+
+  // a corrupt size must not cause a huge allocation
+  const auto remaining = getRemainingSize(stream);
+  if(remaining < 0 || uint64_t{size} * sizeof(T) > static_cast<uint64_t>(remaining))
+    return false;
+
+  data.resize(size);
+  const auto bytes = gsl::narrow<std::streamsize>(data.size() * sizeof(T));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  stream.read(reinterpret_cast<char*>(data.data()), bytes);
+  return stream.gcount() == bytes;
+}
+
+inline void writeString(std::ostream& stream, const std::string& value)
+{
+  writeValue(stream, gsl::narrow<uint32_t>(value.size()));
+  stream.write(value.data(), gsl::narrow<std::streamsize>(value.size()));
+}
+
+inline bool readString(std::istream& stream, std::string& value)
+{
+  uint32_t size = 0;
+  if(!readValue(stream, size))
+    return false;
+
+  const auto remaining = getRemainingSize(stream);
+  if(remaining < 0 || size > static_cast<uint64_t>(remaining))
+    return false;
+
+  value.resize(size);
+  stream.read(value.data(), gsl::narrow<std::streamsize>(size));
+  return stream.gcount() == gsl::narrow<std::streamsize>(size);
+}
+} // namespace util
@@ -4,7 +4,6 @@
 
 #include <boost/log/trivial.hpp>
 #include <boost/throw_exception.hpp>
-#include <cstdlib>
 #include <glm/gtc/type_ptr.hpp>
 #include <gsl/gsl-lite.hpp>
 #include <sstream>
@@ -105,9 +104,26 @@ int16_t rand15s()
   return static_cast<int16_t>(rand15() - Rand15Max / 2);
 }
 
+namespace
+{
+// the generator of the original game; unlike std::rand, its state can be captured and restored for replays. it is
+// per thread, so helper threads can't disturb the deterministic sequence of the simulation
+thread_local uint32_t randomState = 1;
+} // namespace
+
 int16_t rand15()
 {
-  // NOLINTNEXTLINE(cert-msc50-cpp)
-  return gsl::narrow_cast<int16_t>(std::rand() % Rand15Max);
+  randomState = randomState * 0x41c64e6du + 0x3039u;
+  return gsl::narrow_cast<int16_t>((randomState >> 10u) % Rand15Max);
+}
+
+uint32_t getRandomState()
+{
+  return randomState;
+}
+
+void setRandomState(const uint32_t state)
+{
+  randomState = state;
 }
 } // namespace util
@@ -37,6 +37,9 @@ inline auto rand15(qs::quantity<T, U> max)
 
 extern int16_t rand15s();
 
+extern uint32_t getRandomState();
+extern void setRandomState(uint32_t state);
+
 template<typename T, typename U>
 inline auto rand15s(qs::quantity<T, U> max)
 {
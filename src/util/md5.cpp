@@ -36,6 +36,7 @@ documentation and/or software.
 #include <array>
 #include <cstdio>
 #include <gsl/gsl-lite.hpp>
+#include <map>
 
 constexpr size_t Blocksize = 64;
 
@@ -364,3 +365,175 @@ std::string util::md5(const uint8_t* data, const size_t length)
   state.finalize();
   return state.hexdigest();
 }
+
+namespace
+{
+// the lane loops below are written so that compilers map them to one 128 bit vector register per state word
+// (SSE2/NEON)
+constexpr size_t Lanes = util::Md5Lanes;
+using LaneWords = std::array<uint32_t, Lanes>;
+
+// per step message word index, rotation and additive constant of the 64 MD5 steps, the same as the unrolled
+// State::transform
+constexpr std::array<uint8_t, 64> MessageIndex{
+  0, 1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 1, 6,  11, 0,  5,  10, 15, 4,  9,  14, 3,  8,
+  13, 2, 7,  12, 5,  8,  11, 14, 1,  4,  7,  10, 13, 0,  3,  6,  9, 12, 15, 2,  0,  7,  14, 5,  12, 3,  10, 1,
+  8,  15, 6, 13, 4,  11, 2,  9};
+constexpr std::array<uint8_t, 16> Rotations{
+  S11, S12, S13, S14, S21, S22, S23, S24, S31, S32, S33, S34, S41, S42, S43, S44};
+constexpr std::array<uint32_t, 64> StepConstants{
+  0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+  0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+  0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+  0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+  0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+  0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+  0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+  0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+template<size_t Round>
+void laneRound(std::array<LaneWords, 4>& abcd, const std::array<LaneWords, 16>& x)
+{
+  auto& [a, b, c, d] = abcd;
+  for(size_t step = Round * 16; step < Round * 16 + 16; ++step)
+  {
+    const auto& m = x[MessageIndex[step]];
+    const auto s = Rotations[Round * 4 + step % 4];
+    LaneWords rotated{};
+    for(size_t lane = 0; lane < Lanes; ++lane)
+    {
+      uint32_t f;
+      if constexpr(Round == 0)
+        f = F(b[lane], c[lane], d[lane]);
+      else if constexpr(Round == 1)
+        f = G(b[lane], c[lane], d[lane]);
+      else if constexpr(Round == 2)
+        f = H(b[lane], c[lane], d[lane]);
+      else
+        f = I(b[lane], c[lane], d[lane]);
+      rotated[lane] = b[lane] + rotate_left(a[lane] + f + m[lane] + StepConstants[step], s);
+    }
+    a = d;
+    d = c;
+    c = b;
+    b = rotated;
+  }
+}
+
+struct LaneState
+{
+  std::array<LaneWords, 4> state{LaneWords{0x67452301u, 0x67452301u, 0x67452301u, 0x67452301u},
+                                 LaneWords{0xefcdab89u, 0xefcdab89u, 0xefcdab89u, 0xefcdab89u},
+                                 LaneWords{0x98badcfeu, 0x98badcfeu, 0x98badcfeu, 0x98badcfeu},
+                                 LaneWords{0x10325476u, 0x10325476u, 0x10325476u, 0x10325476u}};
+
+  void transform(const std::array<const uint8_t*, Lanes>& blocks)
+  {
+    std::array<LaneWords, 16> x{};
+    for(size_t lane = 0; lane < Lanes; ++lane)
+    {
+      std::array<uint32_t, 16> words{};
+      decode(words.data(), blocks[lane], Blocksize);
+      for(size_t i = 0; i < 16; ++i)
+        x[i][lane] = words[i];
+    }
+
+    auto abcd = state;
+    laneRound<0>(abcd, x);
+    laneRound<1>(abcd, x);
+    laneRound<2>(abcd, x);
+    laneRound<3>(abcd, x);
+
+    for(size_t i = 0; i < 4; ++i)
+    {
+      for(size_t lane = 0; lane < Lanes; ++lane)
+        state[i][lane] += abcd[i][lane];
+    }
+  }
+
+  [[nodiscard]] std::string hexdigest(const size_t lane) const
+  {
+    static constexpr std::array<char, 16> Hex{
+      '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+    std::string result;
+    result.reserve(32);
+    for(const auto& word : state)
+    {
+      for(uint32_t shift = 0; shift < 32; shift += 8)
+      {
+        const auto byte = (word[lane] >> shift) & 0xffu;
+        result += Hex[byte >> 4u];
+        result += Hex[byte & 0x0fu];
+      }
+    }
+    return result;
+  }
+};
+
+// hashes up to Lanes buffers of the same length; unused lanes hash the last buffer again
+void md5Lanes(const std::vector<gsl::span<const uint8_t>>& buffers,
+              const std::vector<size_t>& indices,
+              std::vector<std::string>& results)
+{
+  Expects(!indices.empty() && indices.size() <= Lanes);
+  std::array<const uint8_t*, Lanes> data{};
+  for(size_t lane = 0; lane < Lanes; ++lane)
+    data[lane] = buffers[indices[std::min(lane, indices.size() - 1)]].data();
+  const size_t length = buffers[indices.front()].size();
+
+  LaneState state;
+  std::array<const uint8_t*, Lanes> blocks{};
+  size_t offset = 0;
+  for(; offset + Blocksize <= length; offset += Blocksize)
+  {
+    for(size_t lane = 0; lane < Lanes; ++lane)
+      blocks[lane] = data[lane] + offset;
+    state.transform(blocks);
+  }
+
+  // the remaining bytes, the padding and the bit count need one or two more blocks
+  const size_t rest = length - offset;
+  const size_t tailSize = rest < 56 ? Blocksize : 2 * Blocksize;
+  std::array<std::array<uint8_t, 2 * Blocksize>, Lanes> tails{};
+  const std::array<uint32_t, 2> bitCount{gsl::narrow_cast<uint32_t>(length << 3u),
+                                         gsl::narrow_cast<uint32_t>(length >> 29u)};
+  for(size_t lane = 0; lane < Lanes; ++lane)
+  {
+    auto& tail = tails[lane];
+    std::copy(data[lane] + offset, data[lane] + length, tail.data());
+    tail[rest] = 0x80;
+    encode(&tail[tailSize - 8], bitCount.data(), 8);
+  }
+  for(size_t tailOffset = 0; tailOffset < tailSize; tailOffset += Blocksize)
+  {
+    for(size_t lane = 0; lane < Lanes; ++lane)
+      blocks[lane] = &tails[lane][tailOffset];
+    state.transform(blocks);
+  }
+
+  for(size_t lane = 0; lane < indices.size(); ++lane)
+    results[indices[lane]] = state.hexdigest(lane);
+}
+} // namespace
+
+std::vector<std::string> util::md5(const std::vector<gsl::span<const uint8_t>>& buffers)
+{
+  std::map<size_t, std::vector<size_t>> byLength;
+  for(size_t i = 0; i < buffers.size(); ++i)
+    byLength[buffers[i].size()].emplace_back(i);
+
+  std::vector<std::string> results(buffers.size());
+  for(const auto& [length, indices] : byLength)
+  {
+    size_t i = 0;
+    for(; i + 1 < indices.size(); i += Lanes)
+    {
+      const auto end = std::min(i + Lanes, indices.size());
+      md5Lanes(buffers, std::vector<size_t>{indices.begin() + i, indices.begin() + end}, results);
+    }
+    if(i < indices.size())
+      results[indices[i]] = md5(buffers[indices[i]].data(), length);
+  }
+  return results;
+}
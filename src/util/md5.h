@@ -34,10 +34,15 @@ documentation and/or software.
 
 #include <cstddef>
 #include <cstdint>
+#include <gsl/gsl-lite.hpp>
 #include <string>
+#include <vector>
 
 namespace util
 {
+//! number of buffers of equal length hashed side by side
+constexpr size_t Md5Lanes = 4;
+
 extern std::string md5(const uint8_t* data, size_t length);
 
 inline std::string md5(const char* data, const size_t length)
@@ -45,4 +50,7 @@ inline std::string md5(const char* data, const size_t length)
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
   return md5(reinterpret_cast<const uint8_t*>(data), length);
 }
+
+//! hashes several buffers; buffers of equal length are hashed side by side in the lanes of a multi-buffer transform
+extern std::vector<std::string> md5(const std::vector<gsl::span<const uint8_t>>& buffers);
 } // namespace util
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace util
+{
+// calls f(i) for all i in [0, count), split into contiguous ranges over the available cores; exceptions thrown by f
+// are re-thrown on the calling thread after all ranges have finished
+template<typename F>
+void parallelFor(const size_t count, const F& f)
+{
+  const size_t workers = std::min(count, static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())));
+  if(workers <= 1)
+  {
+    for(size_t i = 0; i < count; ++i)
+      f(i);
+    return;
+  }
+
+  const auto processRange = [&f](const size_t begin, const size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+      f(i);
+  };
+
+  // the calling thread processes the first range itself
+  const size_t rangeSize = (count + workers - 1) / workers;
+  std::vector<std::future<void>> futures;
+  futures.reserve(workers - 1);
+  for(size_t begin = rangeSize; begin < count; begin += rangeSize)
+    futures.emplace_back(std::async(std::launch::async, processRange, begin, std::min(begin + rangeSize, count)));
+
+  processRange(0, std::min(rangeSize, count));
+  for(auto& future : futures)
+    future.wait();
+  for(auto& future : futures)
+    future.get();
+}
+} // namespace util
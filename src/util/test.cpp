@@ -0,0 +1,261 @@
+#define BOOST_TEST_MODULE util
+
+#include "binaryio.h"
+#include "helpers.h"
+#include "loader/trx/trx.h"
+#include "md5.h"
+
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gsl/gsl-lite.hpp>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+std::vector<uint8_t> createData(const size_t size, const uint8_t seed)
+{
+  std::vector<uint8_t> data(size);
+  for(size_t i = 0; i < size; ++i)
+    data[i] = static_cast<uint8_t>(i * 31u + seed);
+  return data;
+}
+
+void writeText(const std::filesystem::path& path, const std::string& text)
+{
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream stream{path, std::ios::out | std::ios::trunc};
+  stream << text;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(util_tests)
+
+BOOST_AUTO_TEST_CASE(test_md5_known_digests)
+{
+  const std::string empty;
+  BOOST_CHECK_EQUAL(util::md5(empty.data(), empty.size()), "D41D8CD98F00B204E9800998ECF8427E");
+  const std::string abc = "abc";
+  BOOST_CHECK_EQUAL(util::md5(abc.data(), abc.size()), "900150983CD24FB0D6963F7D28E17F72");
+  const std::string fox = "The quick brown fox jumps over the lazy dog";
+  BOOST_CHECK_EQUAL(util::md5(fox.data(), fox.size()), "9E107D9D372BB6826BD81D3542A419D6");
+}
+
+BOOST_AUTO_TEST_CASE(test_md5_lanes_match_scalar)
+{
+  // lengths around the padding boundaries, where the length doesn't fit into the last block anymore; every length is
+  // used several times, so full and partially filled lane groups are hashed
+  const std::vector<size_t> lengths{0, 1, 55, 56, 57, 63, 64, 65, 119, 120, 128, 1000};
+  std::vector<std::vector<uint8_t>> buffers;
+  for(size_t repeat = 0; repeat < 6; ++repeat)
+  {
+    for(const auto length : lengths)
+      buffers.emplace_back(createData(length, static_cast<uint8_t>(buffers.size())));
+  }
+  // a few uneven lengths which are only used once
+  buffers.emplace_back(createData(3, 1));
+  buffers.emplace_back(createData(77, 2));
+  buffers.emplace_back(createData(4095, 3));
+
+  std::vector<gsl::span<const uint8_t>> spans;
+  for(const auto& buffer : buffers)
+    spans.emplace_back(buffer.data(), buffer.size());
+
+  const auto hashes = util::md5(spans);
+  BOOST_REQUIRE_EQUAL(hashes.size(), buffers.size());
+  for(size_t i = 0; i < buffers.size(); ++i)
+    BOOST_CHECK_EQUAL(hashes[i], util::md5(buffers[i].data(), buffers[i].size()));
+}
+
+BOOST_AUTO_TEST_CASE(test_md5_lanes_benchmark, *boost::unit_test::label("benchmark"))
+{
+  // the size of a level's texture pages
+  std::vector<std::vector<uint8_t>> buffers;
+  for(size_t i = 0; i < 64; ++i)
+    buffers.emplace_back(createData(256u * 256u * 2u, static_cast<uint8_t>(i)));
+  std::vector<gsl::span<const uint8_t>> spans;
+  for(const auto& buffer : buffers)
+    spans.emplace_back(buffer.data(), buffer.size());
+
+  const auto scalarStart = std::chrono::steady_clock::now();
+  std::vector<std::string> scalarHashes;
+  for(const auto& buffer : buffers)
+    scalarHashes.emplace_back(util::md5(buffer.data(), buffer.size()));
+  const auto scalarTime = std::chrono::steady_clock::now() - scalarStart;
+
+  const auto lanesStart = std::chrono::steady_clock::now();
+  const auto lanesHashes = util::md5(spans);
+  const auto lanesTime = std::chrono::steady_clock::now() - lanesStart;
+
+  BOOST_CHECK(lanesHashes == scalarHashes);
+  BOOST_TEST_MESSAGE("md5 of " << buffers.size() << " texture pages: "
+                               << std::chrono::duration_cast<std::chrono::microseconds>(scalarTime).count()
+                               << "us scalar, "
+                               << std::chrono::duration_cast<std::chrono::microseconds>(lanesTime).count()
+                               << "us in lanes");
+}
+
+BOOST_AUTO_TEST_CASE(test_md5_lanes_empty)
+{
+  BOOST_CHECK(util::md5(std::vector<gsl::span<const uint8_t>>{}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_binaryio_round_trip)
+{
+  std::stringstream stream;
+  util::writeValue(stream, uint32_t{0x12345678u});
+  util::writeBlock(stream, std::vector<int16_t>{1, -2, 3});
+  util::writeBlock(stream, std::vector<float>{});
+
+  uint32_t value = 0;
+  std::vector<int16_t> block;
+  std::vector<float> emptyBlock{1.0f};
+  BOOST_CHECK(util::readValue(stream, value));
+  BOOST_CHECK_EQUAL(value, 0x12345678u);
+  BOOST_CHECK(util::readBlock(stream, block));
+  BOOST_CHECK(block == (std::vector<int16_t>{1, -2, 3}));
+  BOOST_CHECK(util::readBlock(stream, emptyBlock));
+  BOOST_CHECK(emptyBlock.empty());
+  BOOST_CHECK(!util::readValue(stream, value));
+}
+
+BOOST_AUTO_TEST_CASE(test_binaryio_corrupt_size)
+{
+  std::stringstream stream;
+  util::writeValue(stream, std::numeric_limits<uint32_t>::max());
+  util::writeValue(stream, uint64_t{0});
+
+  std::vector<uint64_t> block;
+  BOOST_CHECK(!util::readBlock(stream, block));
+  BOOST_CHECK(block.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_binaryio_string)
+{
+  std::stringstream stream;
+  util::writeString(stream, "level");
+  util::writeString(stream, std::string{});
+  util::writeValue(stream, uint32_t{100});
+
+  std::string value;
+  BOOST_CHECK(util::readString(stream, value));
+  BOOST_CHECK_EQUAL(value, "level");
+  BOOST_CHECK(util::readString(stream, value));
+  BOOST_CHECK(value.empty());
+  // the size exceeds the remaining data
+  BOOST_CHECK(!util::readString(stream, value));
+}
+
+BOOST_AUTO_TEST_CASE(test_glidos_manifest)
+{
+  const auto root = std::filesystem::temp_directory_path() / "edisonengine-util-test-glidos";
+  std::filesystem::remove_all(root);
+  auto cleanup = gsl::finally(
+    [&root]()
+    {
+      std::error_code ec;
+      std::filesystem::remove_all(root, ec);
+    });
+
+  const std::string textureId = "0123456789ABCDEF0123456789ABCDEF";
+  const std::string equivTextureId = "FEDCBA9876543210FEDCBA9876543210";
+  const auto pack = root / "pack";
+  const auto manifest = root / "manifest.glidos";
+  writeText(pack / "equiv.txt",
+            "GLIDOS TEXTURE EQUIV\nBeginEquiv\n" + textureId + "/(0--31)(0--63)\n" + equivTextureId
+              + "/(0--31)(0--63)\nEndEquiv\n");
+  writeText(pack / "map.txt", "GLIDOS TEXTURE MAPPING\nROOT: tex\n" + textureId + " " + textureId + "\n");
+  writeText(pack / "tex" / textureId / "(0--31)(0--63).png", "png");
+
+  size_t scans = 0;
+  const auto load = [&pack, &manifest, &scans](const std::string& id)
+  {
+    scans = 0;
+    return loader::trx::Glidos{pack, manifest, [&scans](const std::string&) { ++scans; }}.getMappingsForTexture(id);
+  };
+
+  const auto scanned = load(textureId);
+  BOOST_CHECK_GT(scans, 0u);
+  BOOST_REQUIRE(std::filesystem::is_regular_file(manifest));
+  BOOST_REQUIRE_EQUAL(scanned.tiles.size(), 1u);
+  BOOST_CHECK_EQUAL(scanned.tiles.begin()->first.getX1(), 31u);
+  BOOST_CHECK_EQUAL(scanned.tiles.begin()->first.getY1(), 63u);
+  BOOST_CHECK(scanned.tiles.begin()->second.filename() == "(0--31)(0--63).png");
+
+  // nothing changed, so the manifest is used, including the stored source timestamps
+  const auto cached = load(textureId);
+  BOOST_CHECK_EQUAL(scans, 0u);
+  BOOST_REQUIRE_EQUAL(cached.tiles.size(), 1u);
+  BOOST_CHECK_EQUAL(cached.tiles.begin()->first.getY1(), 63u);
+  BOOST_CHECK(cached.tiles.begin()->second == scanned.tiles.begin()->second);
+  BOOST_CHECK(cached.newestSource == scanned.newestSource);
+  const auto equivalent = load(equivTextureId);
+  BOOST_CHECK_EQUAL(scans, 0u);
+  BOOST_REQUIRE_EQUAL(equivalent.tiles.size(), 1u);
+  BOOST_CHECK(equivalent.tiles.begin()->second == scanned.tiles.begin()->second);
+
+  // a newer equiv.txt makes the manifest stale
+  std::filesystem::last_write_time(pack / "equiv.txt", scanned.newestSource + std::chrono::hours{1});
+  load(textureId);
+  BOOST_CHECK_GT(scans, 0u);
+  load(textureId);
+  BOOST_CHECK_EQUAL(scans, 0u);
+
+  // ...as does a newer top-level directory
+  std::filesystem::last_write_time(pack / "tex", scanned.newestSource + std::chrono::hours{2});
+  load(textureId);
+  BOOST_CHECK_GT(scans, 0u);
+  load(textureId);
+  BOOST_CHECK_EQUAL(scans, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_random_sequence)
+{
+  // the sequence of the original game's generator, starting with its initial state
+  util::setRandomState(1);
+  for(const int16_t expected : std::array<int16_t, 5>{29087, 8108, 24697, 6886, 21239})
+    BOOST_CHECK_EQUAL(util::rand15(), expected);
+  BOOST_CHECK_EQUAL(util::getRandomState(), 0xf94bdf32u);
+
+  util::setRandomState(0xdeadbeefu);
+  BOOST_CHECK_EQUAL(util::rand15(), 83);
+  BOOST_CHECK_EQUAL(util::rand15(), 20043);
+  BOOST_CHECK_EQUAL(util::rand15(), 12714);
+}
+
+BOOST_AUTO_TEST_CASE(test_random_state_restore)
+{
+  util::setRandomState(12345);
+  std::vector<int16_t> first;
+  for(int i = 0; i < 100; ++i)
+    first.emplace_back(util::rand15());
+
+  util::setRandomState(12345);
+  std::vector<int16_t> second;
+  for(int i = 0; i < 100; ++i)
+    second.emplace_back(util::rand15());
+
+  BOOST_CHECK(first == second);
+}
+
+BOOST_AUTO_TEST_CASE(test_random_state_per_thread)
+{
+  util::setRandomState(12345);
+
+  int16_t threadValue = 0;
+  std::thread thread{[&threadValue]() { threadValue = util::rand15(); }};
+  thread.join();
+
+  // the other thread starts with the initial state and leaves the state of this thread alone
+  BOOST_CHECK_EQUAL(threadValue, 29087);
+  BOOST_CHECK_EQUAL(util::getRandomState(), 12345u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
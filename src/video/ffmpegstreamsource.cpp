@@ -188,65 +188,4 @@ int64_t FfmpegMemoryStreamSource::ffmpegSeek(void* opaque, int64_t offset, int w
   }
   return gsl::narrow_cast<int64_t>(h->dataPosition);
 }
-
-FfmpegSubStreamStreamSource::FfmpegSubStreamStreamSource(std::unique_ptr<std::istream>&& istream,
-                                                         size_t start,
-                                                         size_t end)
-    : detail::FfmpegMemoryStreamSourceSubFileData{std::move(istream), start, end}
-    , BasicFfmpegStreamSource{[this]()
-                              {
-                                auto ctx = avformat_alloc_context();
-                                ctx->pb = avio_alloc_context(dataBuffer,
-                                                             0,
-                                                             0,
-                                                             this,
-                                                             &FfmpegSubStreamStreamSource::ffmpegRead,
-                                                             nullptr,
-                                                             &FfmpegSubStreamStreamSource::ffmpegSeek);
-                                return ctx;
-                              }(),
-                              nullptr}
-{
-}
-
-FfmpegSubStreamStreamSource::~FfmpegSubStreamStreamSource()
-{
-  av_free(getFmtContext()->pb->buffer);
-  avio_context_free(&getFmtContext()->pb);
-}
-
-int FfmpegSubStreamStreamSource::ffmpegRead(void* opaque, uint8_t* buf, int bufSize)
-{
-  auto* h = static_cast<FfmpegSubStreamStreamSource*>(opaque);
-  const auto n = std::min(h->dataEnd - h->dataStart - h->dataPosition, gsl::narrow<size_t>(bufSize));
-  h->istream->seekg(h->dataStart + h->dataPosition);
-  h->istream->read(reinterpret_cast<char*>(buf), n);
-  h->dataPosition += n;
-  return n;
-}
-
-int64_t FfmpegSubStreamStreamSource::ffmpegSeek(void* opaque, int64_t offset, int whence)
-{
-  auto* h = static_cast<FfmpegSubStreamStreamSource*>(opaque);
-  const auto size = h->dataEnd - h->dataStart;
-  if((whence & AVSEEK_SIZE) != 0)
-    return size;
-
-  switch(whence)
-  {
-  case SEEK_SET:
-    h->dataPosition = gsl::narrow_cast<size_t>(std::clamp(offset, int64_t{0}, gsl::narrow<int64_t>(size)));
-    break;
-  case SEEK_CUR:
-    h->dataPosition = gsl::narrow_cast<size_t>(gsl::narrow_cast<size_t>(
-      std::clamp(gsl::narrow<int64_t>(h->dataPosition + offset), int64_t{0}, gsl::narrow<int64_t>(size))));
-    break;
-  case SEEK_END:
-    h->dataPosition = gsl::narrow_cast<size_t>(
-      std::clamp(gsl::narrow<int64_t>(size - offset), int64_t{0}, gsl::narrow<int64_t>(size)));
-    break;
-  default: BOOST_THROW_EXCEPTION(std::domain_error("invalid whence value"));
-  }
-  return gsl::narrow_cast<int64_t>(h->dataPosition);
-}
 } // namespace video
@@ -80,24 +80,6 @@ struct FfmpegMemoryStreamSourceFileData
 
   virtual ~FfmpegMemoryStreamSourceFileData() = default;
 };
-
-struct FfmpegMemoryStreamSourceSubFileData
-{
-  std::unique_ptr<std::istream> istream;
-  size_t dataStart = 0;
-  size_t dataEnd = 0;
-  size_t dataPosition = 0;
-
-  explicit FfmpegMemoryStreamSourceSubFileData(std::unique_ptr<std::istream>&& istream, size_t start, size_t end)
-      : istream{std::move(istream)}
-      , dataStart{start}
-      , dataEnd{end}
-  {
-    Expects(start <= end);
-  }
-
-  virtual ~FfmpegMemoryStreamSourceSubFileData() = default;
-};
 } // namespace detail
 
 class FfmpegMemoryStreamSource final
@@ -109,20 +91,6 @@ public:
   explicit FfmpegMemoryStreamSource(const gsl::span<const uint8_t>& data);
   ~FfmpegMemoryStreamSource() override;
 
-private:
-  static int ffmpegRead(void* opaque, uint8_t* buf, int bufSize);
-  static int64_t ffmpegSeek(void* opaque, int64_t offset, int whence);
-};
-
-class FfmpegSubStreamStreamSource
-    : private detail::FfmpegMemoryStreamSourceScratchData
-    , private detail::FfmpegMemoryStreamSourceSubFileData
-    , public BasicFfmpegStreamSource
-{
-public:
-  explicit FfmpegSubStreamStreamSource(std::unique_ptr<std::istream>&& istream, size_t start, size_t end);
-  ~FfmpegSubStreamStreamSource() override;
-
 private:
   static int ffmpegRead(void* opaque, uint8_t* buf, int bufSize);
   static int64_t ffmpegSeek(void* opaque, int64_t offset, int whence);